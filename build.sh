@@ -22,6 +22,15 @@ readonly DATA_DIRS=(
     "$PROJECT_ROOT/lua"
 )
 
+# Data dirs run through the cook tool (src/cook.cpp) before packaging, cooked
+# files are stored uncompressed so loading them is a plain read
+readonly COOK_DIRS=(
+    "$PROJECT_ROOT/assets"
+)
+readonly COOKED_DIR="$CACHE_DIR/cooked"
+readonly COOK_OPTIONS=(--font-sizes 16,32 --sdf-size 32 --max-sound-seconds 10 --atlas-dirs sprites)
+readonly COOKED_EXTENSIONS=".rtex:.rwav:.rfnt:.ratl"
+
 readonly DEFAULT_PLATFORM="linux_x86_64"
 readonly DEFAULT_BUILD_TYPE="debug"
 readonly DEFAULT_PACKAGE_TYPE="nozip"
@@ -139,6 +148,28 @@ init() {
     log_success "Build environment initialized"
 }
 
+# Cooks COOK_DIRS into COOKED_DIR with the host cook tool (always a linux build,
+# the output is platform independent)
+cook() {
+    local build_type=$1
+    local build_dir="$(get_build_dir "linux_x86_64" "$build_type")"
+    [ ! -d "$build_dir" ] && log_info "build environment not initialized, running ./build.sh init" && init
+
+    cmake --build "$build_dir" --target cook -j "$(get_cores)" || {
+        log_error "Building the cook tool failed"
+        exit 1
+    }
+
+    for cook_dir in "${COOK_DIRS[@]}"; do
+        log_info "Cooking $cook_dir"
+        LD_LIBRARY_PATH="$LIB_DIR/linux_x86_64" "$build_dir/tools/cook" \
+            "$cook_dir" "$COOKED_DIR/$(basename "$cook_dir")" "${COOK_OPTIONS[@]}" || {
+            log_error "Cooking $cook_dir failed"
+            exit 1
+        }
+    done
+}
+
 package() {
     local project_dir="$1"
     local output_dir="$project_dir/$PACK_FOLDER"
@@ -146,15 +177,16 @@ package() {
     mkdir -p "$output_dir"
     mkdir -p "$CACHE_DIR"    
     
-    # Pack data files
+    # Pack data files, cooked dirs are packed from their cooked copy
     local filenames=()
     for data_dir in "${DATA_DIRS[@]}"; do
         local parent_dir="$(dirname "$data_dir")"
         local data_folder="$(basename "$data_dir")"
         local pak_file_name="${data_folder}${PACK_EXTENSION}"
+        [ -d "$COOKED_DIR/$data_folder" ] && [[ " ${COOK_DIRS[*]} " == *" $data_dir "* ]] && parent_dir="$COOKED_DIR"
         (
             cd "$parent_dir"
-            zip -FSr "$CACHE_DIR/$pak_file_name" "$data_folder"
+            zip -FSr -n "$COOKED_EXTENSIONS" "$CACHE_DIR/$pak_file_name" "$data_folder"
         )
         cp -upv "$CACHE_DIR/$pak_file_name" "$output_dir"
         filenames+=("$PACK_FOLDER/$pak_file_name")
@@ -170,6 +202,27 @@ package() {
     } > "$manifest_file"
 }
 
+# Mounts the data directories directly, changes are picked up by lua/hotreload.lua
+package_dev() {
+    local project_dir="$1"
+    local manifest_file="$project_dir/$PACK_MANIFOLD_FILE"
+    {
+        echo "# auto-generated by build.sh (dev)"
+        for data_dir in "${DATA_DIRS[@]}"; do
+            echo "$data_dir"
+        done
+    } > "$manifest_file"
+}
+
+# Lists every rl.<name> the scripts reference in lua/bindings.txt, raylib.lua
+# then only declares those functions at startup (the rest stay lazy)
+bindings() {
+    local output="$PROJECT_ROOT/lua/bindings.txt"
+    grep -rhoE "\brl\.[A-Za-z_][A-Za-z0-9_]*" "$PROJECT_ROOT/lua" --include="*.lua" --exclude="defs.lua" \
+        | sed 's/^rl\.//' | sort -u > "$output"
+    log_success "Wrote $(wc -l < "$output") names to $output"
+}
+
 dist() {
     local build_dir=$1
     local project_name=$2
@@ -193,7 +246,7 @@ build() {
     local package_type=$3
 
     [ "$build_type" != "debug" ] && [ "$build_type" != "release" ] && log_error "Invalid build type: $build_type" && exit 1
-    [ "$package_type" != "zip" ] && [ "$package_type" != "nozip" ] && log_error "Invalid package type: $package_type" && exit 1
+    [ "$package_type" != "zip" ] && [ "$package_type" != "nozip" ] && [ "$package_type" != "dev" ] && log_error "Invalid package type: $package_type" && exit 1
     
     local build_dir="$(get_build_dir "$platform" "$build_type")"
     [ ! -d "$build_dir" ] && log_info "build environment not initialized, running ./build.sh init" && init
@@ -218,8 +271,13 @@ build() {
     # Run post-build hooks
     type -t "postbuild_hook_$platform" &>/dev/null && "postbuild_hook_$platform" "$build_dir" "$project_name" "$platform" "$build_type"
 
-    # Package data files
-    package "$build_dir/$project_name"
+    # Package data files, dev mounts the source dirs so nothing is cooked
+    if [ "$package_type" == "dev" ]; then
+        package_dev "$build_dir/$project_name"
+    else
+        cook "$build_type"
+        package "$build_dir/$project_name"
+    fi
     
     # Run post-package hooks
     type -t "postpackage_hook_$platform" &>/dev/null && "postpackage_hook_$platform" "$build_dir" "$project_name" "$platform" "$build_type"
@@ -267,10 +325,12 @@ show_help() {
     echo "Usage: $0 <command> [options]"
     echo "Commands:"
     echo "  init             Initialize the build environment"
-    echo "  linux_x86_64     Build for Linux x86_64 [debug|release] [zip]"
-    echo "  windows_x86_64   Build for Windows x86_64 [debug|release] [zip]"
+    echo "  linux_x86_64     Build for Linux x86_64 [debug|release] [zip|dev]"
+    echo "  windows_x86_64   Build for Windows x86_64 [debug|release] [zip|dev]"
     echo "  all              Build for all platforms and types [zip]"
-    echo "  run              Build and runs default target [debug|release] [zip]"
+    echo "  run              Build and runs default target [debug|release] [zip|dev]"
+    echo "  cook             Cook assets into runtime-ready files (run by every non-dev build) [debug|release]"
+    echo "  bindings         Write lua/bindings.txt to only declare the raylib functions the scripts use"
     echo "  clean            Clean build environment"
     echo "  help             Show this help message"
 }
@@ -299,6 +359,12 @@ case $1 in
     run)
         run "${DEFAULT_PLATFORM}" "${2:-$DEFAULT_BUILD_TYPE}" "${3:-$DEFAULT_PACKAGE_TYPE}"
         ;;
+    cook)
+        cook "${2:-$DEFAULT_BUILD_TYPE}"
+        ;;
+    bindings)
+        bindings
+        ;;
     clean)
         clean
         ;;
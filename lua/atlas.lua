@@ -0,0 +1,135 @@
+-- texture atlases packed by the cook tool: every sprite of a directory on a few shared textures
+--
+-- local ui = atlas.load("assets/sprites")        -- assets/sprites.ratl once cooked (see --atlas-dirs)
+-- local button = ui:get("ui/button")             -- AtlasSprite for assets/sprites/ui/button.png, or nil
+-- rl.DrawTextureRec(button.texture, button.source, position, rl.WHITE)
+-- list[i]:set(button.texture, button.source, dest, origin, rotation, tint, layer)  -- sprites batch
+-- ui:draw("ui/button", x, y, tint)
+--
+-- button.uv is the source rectangle in 0..1 texture coordinates, for custom meshes and shaders.
+-- Without a cooked atlas (dev builds) every sprite loads as its own texture on first use,
+-- so the same names work in both. Sprites too large for a page stay loose in cooked builds too.
+
+local ffi = require("ffi")
+
+ffi.cdef[[
+typedef struct AtlasSprite {
+    Texture2D texture;
+    Rectangle source;
+    Rectangle uv;
+    int page;
+} AtlasSprite;
+
+typedef struct TextureAtlas TextureAtlas;
+
+TextureAtlas *LoadTextureAtlas(const char *fileName);
+void UnloadTextureAtlas(TextureAtlas *atlas);
+
+int TextureAtlasSpriteCount(const TextureAtlas *atlas);
+int TextureAtlasPageCount(const TextureAtlas *atlas);
+Texture2D TextureAtlasGetPage(const TextureAtlas *atlas, int page);
+int TextureAtlasFind(const TextureAtlas *atlas, const char *name);
+bool TextureAtlasGetSprite(const TextureAtlas *atlas, int index, AtlasSprite *sprite);
+const char *TextureAtlasGetName(const TextureAtlas *atlas, int index);
+]]
+
+local C = ffi.C
+
+local atlas = {}
+
+-- loose images tried in dev builds, in this order
+local LOOSE_EXTENSIONS = { ".png", ".qoi", ".tga", ".bmp", ".jpg" }
+
+local atlas_methods = {}
+atlas_methods.__index = atlas_methods
+
+---AtlasSprite called `name` (path below the atlas directory, no extension), nil if
+---there is none. Sprites are cached, keep the returned value rather than looking up every frame
+function atlas_methods:get(name)
+    local sprite = self.sprites[name]
+    if sprite ~= nil then
+        return sprite or nil
+    end
+
+    if self.handle ~= nil then
+        local index = C.TextureAtlasFind(self.handle, name)
+        if index >= 0 then
+            sprite = ffi.new("AtlasSprite")
+            C.TextureAtlasGetSprite(self.handle, index, sprite)
+        end
+    end
+
+    -- dev builds, and sprites the cook tool could not pack (too large, compressed)
+    if sprite == nil then
+        for _, extension in ipairs(LOOSE_EXTENSIONS) do
+            local path = self.dir .. "/" .. name .. extension
+            if C.VFSFileExists(path) then
+                local texture = rl.LoadTexture(path)
+                sprite = ffi.new("AtlasSprite", { texture = texture, source = { 0, 0, texture.width, texture.height },
+                    uv = { 0, 0, 1, 1 } })
+                self.textures[#self.textures + 1] = texture
+                break
+            end
+        end
+    end
+
+    self.sprites[name] = sprite or false
+    return sprite
+end
+
+local draw_position = ffi.new("Vector2")
+
+---Draw sprite `name` with its top left corner at x, y
+function atlas_methods:draw(name, x, y, tint)
+    local sprite = self:get(name)
+    if sprite then
+        draw_position.x, draw_position.y = x, y
+        rl.DrawTextureRec(sprite.texture, sprite.source, draw_position, tint or rl.WHITE)
+    end
+end
+
+---Names of the packed sprites, empty for loose images
+function atlas_methods:names()
+    local names = {}
+    if self.handle ~= nil then
+        for i = 0, C.TextureAtlasSpriteCount(self.handle) - 1 do
+            names[#names + 1] = ffi.string(C.TextureAtlasGetName(self.handle, i))
+        end
+    end
+    return names
+end
+
+---Textures in use: atlas pages and the loose images loaded so far
+function atlas_methods:textureCount()
+    local pages = self.handle ~= nil and C.TextureAtlasPageCount(self.handle) or 0
+    return pages + #self.textures
+end
+
+function atlas_methods:unload()
+    if self.handle ~= nil then
+        C.UnloadTextureAtlas(ffi.gc(self.handle, nil))
+        self.handle = nil
+    end
+    for _, texture in ipairs(self.textures) do
+        rl.UnloadTexture(texture)
+    end
+    self.textures, self.sprites = {}, {}
+end
+
+---Atlas for the images below directory `dir`: the cooked `dir`.ratl when it exists,
+---otherwise the loose images, each loaded on first use
+function atlas.load(dir)
+    dir = dir:gsub("/+$", "")
+    local self = setmetatable({ dir = dir, sprites = {}, textures = {} }, atlas_methods)
+    local cooked = dir .. ".ratl"
+    if C.VFSFileExists(cooked) then
+        local handle = C.LoadTextureAtlas(cooked)
+        if handle == nil then
+            return nil
+        end
+        self.handle = ffi.gc(handle, C.UnloadTextureAtlas)
+    end
+    return self
+end
+
+return atlas
@@ -0,0 +1,143 @@
+-- array-in/array-out raymath with SIMD kernels picked at startup (AVX2, SSE2 or scalar)
+--
+-- local points = ffi.new("Vector3[?]", n)
+-- batchmath.Vector3Transform(points, points, n, mat)  -- in place is fine
+-- batchmath.MatrixMultiply(inverseBind, pose, palette, boneCount)
+-- batchmath.benchmark()                               -- compare against per-element raymath calls
+
+local ffi = require("ffi")
+
+ffi.cdef[[
+void Vector3TransformBatch(const Vector3 *points, Vector3 *out, int count, Matrix mat);
+void MatrixMultiplyBatch(const Matrix *left, const Matrix *right, Matrix *out, int count);
+void QuaternionNlerpBatch(const Quaternion *q1, const Quaternion *q2, Quaternion *out, int count, float amount);
+void QuaternionSlerpBatch(const Quaternion *q1, const Quaternion *q2, Quaternion *out, int count, float amount);
+void BoundingBoxTransformBatch(const BoundingBox *boxes, BoundingBox *out, int count, Matrix mat);
+
+int BatchMathGetLevel();
+int BatchMathSetLevel(int level);
+]]
+
+local C = ffi.C
+
+local batchmath = {
+    SCALAR = 0,
+    SSE2 = 1,
+    AVX2 = 2,
+
+    Vector3Transform = C.Vector3TransformBatch,
+    MatrixMultiply = C.MatrixMultiplyBatch,
+    QuaternionNlerp = C.QuaternionNlerpBatch,
+    QuaternionSlerp = C.QuaternionSlerpBatch,
+    BoundingBoxTransform = C.BoundingBoxTransformBatch,
+}
+
+local LEVEL_NAMES = { [0] = "scalar", "SSE2", "AVX2" }
+
+function batchmath.level()
+    local level = C.BatchMathGetLevel()
+    return level, LEVEL_NAMES[level]
+end
+
+---Force a lower kernel level, returns the level actually in use
+function batchmath.setLevel(level)
+    return C.BatchMathSetLevel(level)
+end
+
+local function time_per_element(fn, count, iterations)
+    fn()
+    local start = os.clock()
+    for _ = 1, iterations do
+        fn()
+    end
+    return (os.clock() - start) / (iterations * count) * 1e9
+end
+
+---Time every batch function at each supported level against a loop of
+---per-element raymath calls. Logs the results and returns them as
+---{ name = { raymath = ns, scalar = ns, SSE2 = ns, AVX2 = ns } } (ns per element)
+function batchmath.benchmark(count, iterations)
+    count = count or 4096
+    iterations = iterations or 200
+
+    local vectors = ffi.new("Vector3[?]", count)
+    local matrices_a = ffi.new("Matrix[?]", count)
+    local matrices_b = ffi.new("Matrix[?]", count)
+    local quats_a = ffi.new("Quaternion[?]", count)
+    local quats_b = ffi.new("Quaternion[?]", count)
+    local boxes = ffi.new("BoundingBox[?]", count)
+    local out_vectors = ffi.new("Vector3[?]", count)
+    local out_matrices = ffi.new("Matrix[?]", count)
+    local out_quats = ffi.new("Quaternion[?]", count)
+    local out_boxes = ffi.new("BoundingBox[?]", count)
+
+    local random = math.random
+    local mat = rl.MatrixMultiply(rl.MatrixRotateXYZ(rl.new("Vector3", 0.3, 0.7, 1.1)), rl.MatrixTranslate(1, 2, 3))
+    for i = 0, count - 1 do
+        vectors[i] = rl.new("Vector3", random(), random(), random())
+        matrices_a[i] = rl.MatrixRotateXYZ(vectors[i])
+        matrices_b[i] = rl.MatrixTranslate(random(), random(), random())
+        quats_a[i] = rl.QuaternionFromAxisAngle(vectors[i], random() * 3)
+        quats_b[i] = rl.QuaternionFromAxisAngle(rl.new("Vector3", random(), random(), random()), random() * 3)
+        boxes[i].min = vectors[i]
+        boxes[i].max = rl.new("Vector3", vectors[i].x + 1, vectors[i].y + 2, vectors[i].z + 3)
+    end
+
+    local cases = {
+        { "Vector3Transform",
+          function() for i = 0, count - 1 do out_vectors[i] = rl.Vector3Transform(vectors[i], mat) end end,
+          function() C.Vector3TransformBatch(vectors, out_vectors, count, mat) end },
+        { "MatrixMultiply",
+          function() for i = 0, count - 1 do out_matrices[i] = rl.MatrixMultiply(matrices_a[i], matrices_b[i]) end end,
+          function() C.MatrixMultiplyBatch(matrices_a, matrices_b, out_matrices, count) end },
+        { "QuaternionNlerp",
+          function() for i = 0, count - 1 do out_quats[i] = rl.QuaternionNlerp(quats_a[i], quats_b[i], 0.3) end end,
+          function() C.QuaternionNlerpBatch(quats_a, quats_b, out_quats, count, 0.3) end },
+        { "QuaternionSlerp",
+          function() for i = 0, count - 1 do out_quats[i] = rl.QuaternionSlerp(quats_a[i], quats_b[i], 0.3) end end,
+          function() C.QuaternionSlerpBatch(quats_a, quats_b, out_quats, count, 0.3) end },
+        -- raymath has no box transform, the reference is the 8-corner loop
+        { "BoundingBoxTransform",
+          function()
+              for i = 0, count - 1 do
+                  local box, lo, hi = boxes[i], out_boxes[i].min, out_boxes[i].max
+                  lo.x, lo.y, lo.z = math.huge, math.huge, math.huge
+                  hi.x, hi.y, hi.z = -math.huge, -math.huge, -math.huge
+                  for corner = 0, 7 do
+                      local p = rl.Vector3Transform(rl.new("Vector3",
+                          corner % 2 == 0 and box.min.x or box.max.x,
+                          corner % 4 < 2 and box.min.y or box.max.y,
+                          corner < 4 and box.min.z or box.max.z), mat)
+                      lo.x, lo.y, lo.z = math.min(lo.x, p.x), math.min(lo.y, p.y), math.min(lo.z, p.z)
+                      hi.x, hi.y, hi.z = math.max(hi.x, p.x), math.max(hi.y, p.y), math.max(hi.z, p.z)
+                  end
+              end
+          end,
+          function() C.BoundingBoxTransformBatch(boxes, out_boxes, count, mat) end },
+    }
+
+    local supported = C.BatchMathGetLevel()
+    local results = {}
+    rl.TraceLog(rl.LOG_INFO, "MATH: Benchmark, %d elements x %d iterations (ns per element)",
+        ffi.new("int", count), ffi.new("int", iterations))
+
+    for _, case in ipairs(cases) do
+        local name, reference, batch = case[1], case[2], case[3]
+        local result = { raymath = time_per_element(reference, count, math.max(1, iterations / 10)) }
+        local line = string.format("%-22s raymath %7.2f", name, result.raymath)
+
+        for level = 0, supported do
+            C.BatchMathSetLevel(level)
+            result[LEVEL_NAMES[level]] = time_per_element(batch, count, iterations)
+            line = line .. string.format("  %s %6.2f", LEVEL_NAMES[level], result[LEVEL_NAMES[level]])
+        end
+
+        results[name] = result
+        rl.TraceLog(rl.LOG_INFO, "MATH: %s", line)
+    end
+
+    C.BatchMathSetLevel(supported)
+    return results
+end
+
+return batchmath
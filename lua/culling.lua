@@ -0,0 +1,122 @@
+-- CPU visibility culling over soa bounds buffers, returns index lists of what is on screen
+--
+-- local centers, extents = soa.new(n, 2), soa.new(n, 2)     -- half sizes, extents may be nil
+-- local visible = culling.indices(n)
+--
+-- local view = culling.view2d(camera, rl.GetScreenWidth(), rl.GetScreenHeight())
+-- local count = culling.rects(centers, extents, view, visible)    -- linear SIMD scan
+--
+-- local grid = culling.grid(128)                            -- 2D, cell size in world units
+-- grid:build(centers, extents)                              -- O(n), after objects moved
+-- count = grid:query(view, visible)
+--
+-- local bvh = culling.bvh()                                 -- 3D, 3-component buffers
+-- bvh:build(centers, extents); bvh:refit(centers, extents)  -- refit when objects only moved
+-- count = bvh:query(culling.frustum(camera, aspect), visible)
+--
+-- for i = 0, count - 1 do local index = visible[i] ... end
+
+local ffi = require("ffi")
+require("soa")
+
+ffi.cdef[[
+typedef struct Frustum {
+    Vector4 planes[6];
+} Frustum;
+
+Frustum FrustumFromCamera(Camera3D camera, float aspect, float nearPlane, float farPlane);
+Frustum FrustumFromMatrix(Matrix viewProjection);
+Rectangle ViewRectFromCamera2D(Camera2D camera, float width, float height);
+
+int CullRects(const VectorBuffer *centers, const VectorBuffer *extents, Rectangle view, int *indices, int maxIndices);
+int CullBoxes(const VectorBuffer *centers, const VectorBuffer *extents, const Frustum *frustum, int *indices, int maxIndices);
+
+typedef struct CullGrid CullGrid;
+CullGrid *CullGridCreate(float cellSize);
+void CullGridDestroy(CullGrid *grid);
+bool CullGridBuild(CullGrid *grid, const VectorBuffer *centers, const VectorBuffer *extents);
+int CullGridQuery(const CullGrid *grid, Rectangle view, int *indices, int maxIndices);
+
+typedef struct CullBvh CullBvh;
+CullBvh *CullBvhCreate();
+void CullBvhDestroy(CullBvh *bvh);
+bool CullBvhBuild(CullBvh *bvh, const VectorBuffer *centers, const VectorBuffer *extents);
+bool CullBvhRefit(CullBvh *bvh, const VectorBuffer *centers, const VectorBuffer *extents);
+int CullBvhQuery(const CullBvh *bvh, const Frustum *frustum, int *indices, int maxIndices);
+]]
+
+local C = ffi.C
+
+local culling = {}
+
+local INT_SIZE = ffi.sizeof("int")
+
+-- queries write at most maxIndices, by default as many as an int[?] array holds
+local function capacity(indices, maxIndices)
+    return maxIndices or ffi.sizeof(indices) / INT_SIZE
+end
+
+---int[?] for query results
+function culling.indices(size)
+    return ffi.new("int[?]", size)
+end
+
+---Frustum of a Camera3D as BeginMode3D sets it up; near/far default to rlgl's cull distances
+function culling.frustum(camera, aspect, near, far)
+    return C.FrustumFromCamera(camera, aspect, near or 0, far or 0)
+end
+
+culling.frustumFromMatrix = C.FrustumFromMatrix
+culling.view2d = C.ViewRectFromCamera2D
+
+---Linear scan of 2D bounds against a view rectangle, returns how many indices were written
+function culling.rects(centers, extents, view, indices, maxIndices)
+    return C.CullRects(centers, extents, view, indices, capacity(indices, maxIndices))
+end
+
+---Linear scan of 3D bounds against a Frustum
+function culling.boxes(centers, extents, frustum, indices, maxIndices)
+    return C.CullBoxes(centers, extents, frustum, indices, capacity(indices, maxIndices))
+end
+
+local grid_methods = {}
+
+grid_methods.build = C.CullGridBuild
+
+function grid_methods:query(view, indices, maxIndices)
+    return C.CullGridQuery(self, view, indices, capacity(indices, maxIndices))
+end
+
+function grid_methods:destroy()
+    C.CullGridDestroy(ffi.gc(self, nil))
+end
+
+ffi.metatype("CullGrid", { __index = grid_methods })
+
+---Loose uniform grid for 2D culling, cellSize in world units (default 64)
+function culling.grid(cellSize)
+    return ffi.gc(C.CullGridCreate(cellSize or 0), C.CullGridDestroy)
+end
+
+local bvh_methods = {}
+
+bvh_methods.build = C.CullBvhBuild
+---Update the bounds after objects moved, false when the count changed (build again then)
+bvh_methods.refit = C.CullBvhRefit
+
+function bvh_methods:query(frustum, indices, maxIndices)
+    return C.CullBvhQuery(self, frustum, indices, capacity(indices, maxIndices))
+end
+
+function bvh_methods:destroy()
+    C.CullBvhDestroy(ffi.gc(self, nil))
+end
+
+ffi.metatype("CullBvh", { __index = bvh_methods })
+
+---Bounding volume hierarchy for 3D frustum culling
+function culling.bvh()
+    return ffi.gc(C.CullBvhCreate(), C.CullBvhDestroy)
+end
+
+return culling
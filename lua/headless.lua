@@ -0,0 +1,243 @@
+-- headless runs: game --headless [--frames 600] [--frame-times frames.csv]
+--
+-- There is no window and no GL context. The host calls headless.start() before
+-- lua/main.lua, which swaps the window, drawing and GPU upload functions of rl for
+-- stubs, so the game's own main loop runs unchanged:
+--   rl.InitWindow / CloseWindow            remember the screen size, nothing opens
+--   rl.WindowShouldClose()                 true once --frames frames have run
+--   rl.GetTime / GetFrameTime / GetFPS     a fixed 60 Hz clock, the same every run
+--   rl.BeginDrawing / EndDrawing           time the frame
+--   rl.Draw*, Begin*/End* modes, rl.rl*    do nothing
+--   rl.LoadTexture, LoadRenderTexture,     decode through the VFS as usual, then hand out
+--   LoadShader, fonts, atlas pages         placeholders with fake GPU ids and real sizes
+-- At exit the host logs the frame time summary (mean, median, p95, p99, max) and
+-- writes every frame to the --frame-times CSV.
+--
+-- rl.IsWindowReady() stays false, as the native modules see it: sprite batches,
+-- tile maps, instancing and culling build their data and skip the GPU. Text in
+-- raylib's default font draws nothing (that font comes with the window), and meshes
+-- and models need GL, loading one raises an error.
+
+local ffi = require("ffi")
+
+ffi.cdef[[
+typedef struct HeadlessStats {
+    int frames;
+    int maxFrames;
+    float frameTime;
+    double totalMs;
+    float meanMs;
+    float medianMs;
+    float p95Ms;
+    float p99Ms;
+    float minMs;
+    float maxMs;
+    float drawMeanMs;
+} HeadlessStats;
+
+bool HeadlessIsEnabled();
+double HeadlessGetTime();
+float HeadlessGetFrameTime();
+bool HeadlessShouldClose();
+
+void HeadlessBeginFrame();
+void HeadlessEndFrame();
+void HeadlessGetStats(HeadlessStats *stats);
+unsigned int HeadlessFakeTextureId();
+]]
+
+local C = ffi.C
+
+local headless = {}
+
+local MAX_SHADER_LOCATIONS = 32
+
+local screen_width, screen_height = 0, 0
+local shader_locs = {}   -- keeps the placeholder shaders' location arrays alive
+
+-- Non-zero, so sprite batches and tile maps keep what uses them; the native side hands
+-- out the ids, atlas pages loaded in C++ take theirs from the same counter
+local function fake_id()
+    return C.HeadlessFakeTextureId()
+end
+
+local function fake_texture(width, height, mipmaps, format)
+    return ffi.new("Texture2D", fake_id(), width, height, mipmaps or 1, format or rl.PIXELFORMAT_UNCOMPRESSED_R8G8B8A8)
+end
+
+local function fake_shader()
+    local locs = ffi.new("int[?]", MAX_SHADER_LOCATIONS)
+    for i = 0, MAX_SHADER_LOCATIONS - 1 do
+        locs[i] = -1
+    end
+    local shader = ffi.new("Shader", fake_id(), locs)
+    shader_locs[shader.id] = locs
+    return shader
+end
+
+local function noop() end
+
+local function needs_gl(name)
+    return function()
+        error("rl." .. name .. " needs a GL context, it is not available in headless runs", 2)
+    end
+end
+
+-- Textures sized like the real upload; fonts get one as big as their glyph rectangles
+local function with_font_texture(load)
+    return function(...)
+        local font = load(...)
+        if font and font.glyphs ~= nil and font.texture.id == 0 then
+            local width, height = 1, 1
+            for i = 0, font.glyphCount - 1 do
+                local rec = font.recs[i]
+                width = math.max(width, rec.x + rec.width + font.glyphPadding)
+                height = math.max(height, rec.y + rec.height + font.glyphPadding)
+            end
+            font.texture = fake_texture(width, height)
+        end
+        return font
+    end
+end
+
+local function stubs()
+    local unload_font = rl.UnloadFont
+    local parse_payload = rl.ParseTexturePayload
+
+    return {
+        InitWindow = function(width, height)
+            screen_width, screen_height = width, height
+        end,
+        CloseWindow = noop,
+        WindowShouldClose = C.HeadlessShouldClose,
+        GetScreenWidth = function() return screen_width end,
+        GetScreenHeight = function() return screen_height end,
+        GetRenderWidth = function() return screen_width end,
+        GetRenderHeight = function() return screen_height end,
+
+        GetTime = C.HeadlessGetTime,
+        GetFrameTime = C.HeadlessGetFrameTime,
+        GetFPS = function() return math.floor(1 / C.HeadlessGetFrameTime() + 0.5) end,
+        BeginDrawing = C.HeadlessBeginFrame,
+        EndDrawing = C.HeadlessEndFrame,
+
+        LoadTexture = function(fileName)
+            local image = rl.LoadImage(fileName)
+            if not image or image.data == nil then
+                return ffi.new("Texture2D")
+            end
+            local texture = fake_texture(image.width, image.height, image.mipmaps, image.format)
+            rl.UnloadImage(image)
+            return texture
+        end,
+        LoadTextureFromImage = function(image)
+            return fake_texture(image.width, image.height, image.mipmaps, image.format)
+        end,
+        LoadTextureCubemap = function(image)
+            return fake_texture(image.width, image.height, image.mipmaps, image.format)
+        end,
+        LoadTextureFromPayload = function(data, size)
+            local payload = parse_payload(data, size)
+            if payload == nil then
+                return ffi.new("Texture2D")
+            end
+            return fake_texture(payload.width, payload.height, payload.mipmaps, payload.format)
+        end,
+        LoadRenderTexture = function(width, height)
+            return ffi.new("RenderTexture2D", fake_id(), fake_texture(width, height), fake_texture(width, height))
+        end,
+        LoadShader = fake_shader,
+        LoadShaderFromMemory = fake_shader,
+        GetShaderLocation = function() return -1 end,
+        GetShaderLocationAttrib = function() return -1 end,
+
+        LoadFont = with_font_texture(rl.LoadFont),
+        LoadFontEx = with_font_texture(rl.LoadFontEx),
+        LoadFontFromMemory = with_font_texture(rl.LoadFontFromMemory),
+        LoadFontSdf = with_font_texture(rl.LoadFontSdf),
+        UnloadFont = function(font)
+            font = ffi.new("Font", font)
+            font.texture.id = 0
+            unload_font(font)
+        end,
+    }
+end
+
+-- Everything else by name: drawing and GL state do nothing, uploads that cannot be faked fail loudly
+local NOOP_PATTERNS = {
+    "^Draw", "^Begin", "^End", "^ClearBackground$", "^rl%u", "^SetShaderValue", "^SetTexture",
+    "^GenTextureMipmaps$", "^UpdateTexture", "^UpdateMeshBuffer$", "^Unload[%a]*Texture$", "^UnloadShader$",
+    "^SetWindow", "^Toggle", "^MaximizeWindow$", "^MinimizeWindow$", "^RestoreWindow$", "^SwapScreenBuffer$",
+    "^TakeScreenshot$", "^SetTargetFPS$", "^EnableCursor$", "^DisableCursor$", "^ShowCursor$", "^HideCursor$",
+    "^SetMouseCursor$", "^SetClipboardText$",
+}
+local GL_PATTERNS = {
+    "^LoadModel", "^UploadMesh$", "^GenMesh", "^LoadMaterial", "^LoadImageFromScreen$", "^LoadImageFromTexture$",
+}
+
+local function stub_for(name)
+    for _, pattern in ipairs(NOOP_PATTERNS) do
+        if name:find(pattern) then
+            return noop
+        end
+    end
+    for _, pattern in ipairs(GL_PATTERNS) do
+        if name:find(pattern) then
+            return needs_gl(name)
+        end
+    end
+    return nil
+end
+
+---Swap rl's window, drawing and upload functions for the headless stubs; the host
+---calls it with --headless, before lua/main.lua
+function headless.start()
+    local replaced = stubs()
+    for name in pairs(rl) do
+        if not replaced[name] then
+            replaced[name] = stub_for(name)
+        end
+    end
+    for name, stub in pairs(replaced) do
+        rl[name] = stub
+    end
+
+    -- functions bound later (lazy groups) go through the same filter
+    local meta = getmetatable(rl)
+    local index = meta.__index
+    meta.__index = function(t, name)
+        local stub = stub_for(name)
+        if stub then
+            rawset(t, name, stub)
+            return stub
+        end
+        return index(t, name)
+    end
+
+    local stats = headless.stats()
+    if stats.maxFrames > 0 then
+        rl.TraceLog(rl.LOG_INFO, "HEADLESS: No window, %d frames at a fixed %.1f Hz step",
+            ffi.new("int", stats.maxFrames), 1 / stats.frameTime)
+    else
+        rl.TraceLog(rl.LOG_INFO, "HEADLESS: No window, frames at a fixed %.1f Hz step until the script ends", 1 / stats.frameTime)
+    end
+end
+
+---True in a --headless run
+function headless.enabled()
+    return C.HeadlessIsEnabled()
+end
+
+---Frame time summary so far (ms), pass a table to reuse it
+function headless.stats(out)
+    local stats = ffi.new("HeadlessStats")
+    C.HeadlessGetStats(stats)
+    out = out or {}
+    out.frames, out.maxFrames, out.frameTime = stats.frames, stats.maxFrames, stats.frameTime
+    out.totalMs, out.meanMs, out.medianMs = stats.totalMs, stats.meanMs, stats.medianMs
+    out.p95Ms, out.p99Ms, out.minMs, out.maxMs = stats.p95Ms, stats.p99Ms, stats.minMs, stats.maxMs
+    out.drawMeanMs = stats.drawMeanMs
+    return out
+end
+
+return headless
@@ -0,0 +1,143 @@
+-- hot-reloading of Lua modules loaded through require
+--
+-- hotreload.start()
+-- while not rl.WindowShouldClose() do
+--     hotreload.poll()
+--     ...
+-- end
+--
+-- Changed modules are re-executed and their new fields are copied into the
+-- table that is already in package.loaded, so `local m = require("m")`
+-- references see the new code. Keep mutable state in tables rather than
+-- scalar fields so both copies share it. Modules can carry state across a reload:
+--   function M.__save() return state end
+--   function M.__restore(state) ... end
+-- main.lua itself runs the frame loop and is not reloadable, keep game code in modules.
+-- Use `./build.sh run debug dev` to mount lua/ and assets/ as loose directories.
+
+local ffi = require("ffi")
+
+ffi.cdef[[
+bool WatcherStart();
+void WatcherStop();
+int WatcherPoll();
+const char *WatcherNextChange();
+]]
+
+local C = ffi.C
+
+local hotreload = {}
+
+local reload_hooks = {}
+local change_hooks = {}
+
+local function module_name(path)
+    local name = path:match("^lua/(.+)%.lua$")
+    return name and (name:gsub("/", "."))
+end
+
+local function run_hooks(hooks, ...)
+    for i = 1, #hooks do
+        local ok, err = pcall(hooks[i], ...)
+        if not ok then
+            rl.TraceLog(rl.LOG_WARNING, "HOTRELOAD: Hook failed: %s", tostring(err))
+        end
+    end
+end
+
+function hotreload.start()
+    return C.WatcherStart()
+end
+
+function hotreload.stop()
+    C.WatcherStop()
+end
+
+---Call `fn(modname, module)` after a module was reloaded
+function hotreload.on_reload(fn)
+    reload_hooks[#reload_hooks + 1] = fn
+end
+
+---Call `fn(path)` when any other watched file changes (assets, data files)
+function hotreload.on_change(fn)
+    change_hooks[#change_hooks + 1] = fn
+end
+
+---Re-execute a loaded module, on failure the old version stays in place
+function hotreload.reload(modname)
+    local path = "lua/" .. modname:gsub("%.", "/") .. ".lua"
+    local old = package.loaded[modname]
+
+    local content = rl.LoadFileText(path)
+    if content == nil then
+        rl.TraceLog(rl.LOG_WARNING, "HOTRELOAD: Could not read %s", path)
+        return false
+    end
+
+    local chunk, err = loadstring(ffi.string(content), "@" .. path)
+    rl.UnloadFileText(content)
+    if not chunk then
+        rl.TraceLog(rl.LOG_ERROR, "HOTRELOAD: %s", err)
+        return false
+    end
+
+    local state
+    if type(old) == "table" and type(old.__save) == "function" then
+        state = old.__save()
+    end
+
+    local ok, new = pcall(chunk, modname)
+    if not ok then
+        rl.TraceLog(rl.LOG_ERROR, "HOTRELOAD: Error reloading %s: %s", modname, tostring(new))
+        return false
+    end
+
+    if new == nil then
+        new = true
+    end
+
+    if type(new) == "table" and type(new.__restore) == "function" then
+        new.__restore(state)
+    end
+
+    -- patch in place so existing references pick up the new code
+    if type(old) == "table" and type(new) == "table" then
+        for key in pairs(old) do
+            if new[key] == nil then old[key] = nil end
+        end
+        for key, value in pairs(new) do
+            old[key] = value
+        end
+        new = old
+    end
+
+    package.loaded[modname] = new
+
+    run_hooks(reload_hooks, modname, new)
+    rl.TraceLog(rl.LOG_INFO, "HOTRELOAD: Reloaded %s", modname)
+    return true
+end
+
+---Reload whatever changed since the last call, cheap when nothing did
+function hotreload.poll()
+    if C.WatcherPoll() == 0 then
+        return
+    end
+
+    while true do
+        local change = C.WatcherNextChange()
+        if change == nil then
+            break
+        end
+
+        local path = ffi.string(change)
+        local modname = module_name(path)
+        if modname and package.loaded[modname] ~= nil then
+            hotreload.reload(modname)
+        else
+            run_hooks(change_hooks, path)
+        end
+    end
+end
+
+return hotreload
@@ -0,0 +1,166 @@
+-- instanced mesh drawing from packed SoA transforms: one draw call per mesh for a whole batch
+--
+-- local shader = instancing.shader()                   -- or any shader with a mat4 instanceTransform attribute
+-- material.shader = shader
+-- local trees = instancing.new(5000)
+-- trees:resize(5000)
+-- trees:set(i, position, rotation, scale)              -- Vector3, Quaternion, Vector3 or number; marks i dirty
+-- trees.positions:axpy(dt, velocities)                  -- positions/scales are soa buffers,
+-- trees:dirty()                                         -- then mark what changed (default: everything)
+-- trees:draw(mesh, material)                            -- inside BeginMode3D; uploads only dirty matrices
+-- trees:drawModel(model)                                -- every mesh of a model, with its materials
+--
+-- Dirty instances merge into one span: keep moving ones together, or in their own batch.
+
+local ffi = require("ffi")
+require("soa")
+
+ffi.cdef[[
+typedef struct InstanceBatch {
+    VectorBuffer *positions;
+    VectorBuffer *scales;
+    float *rotationX;
+    float *rotationY;
+    float *rotationZ;
+    float *rotationW;
+    int count;
+    int capacity;
+} InstanceBatch;
+
+typedef struct InstanceBatchStats {
+    int instances;
+    int rebuilt;
+    int uploaded;
+    float buildMs;
+} InstanceBatchStats;
+
+InstanceBatch *InstanceBatchCreate(int capacity);
+void InstanceBatchDestroy(InstanceBatch *batch);
+bool InstanceBatchResize(InstanceBatch *batch, int count);
+void InstanceBatchMarkDirty(InstanceBatch *batch, int first, int count);
+
+void InstanceBatchUpdate(InstanceBatch *batch);
+const float *InstanceBatchGetMatrices(const InstanceBatch *batch);
+
+void InstanceBatchDraw(InstanceBatch *batch, Mesh mesh, Material material);
+void InstanceBatchGetStats(const InstanceBatch *batch, InstanceBatchStats *stats);
+
+Shader LoadInstancingShader();
+]]
+
+local C = ffi.C
+
+local instancing = {}
+
+local batch_methods = {}
+
+batch_methods.resize = C.InstanceBatchResize
+batch_methods.update = C.InstanceBatchUpdate
+batch_methods.draw = C.InstanceBatchDraw
+
+---Mark `count` instances from `first` as changed; no arguments marks every instance
+function batch_methods:dirty(first, count)
+    first = first or 0
+    C.InstanceBatchMarkDirty(self, first, count or self.count - first)
+end
+
+---Set instance i (0-based) and mark it dirty. rotation (a Quaternion) and scale
+---(a Vector3 or a number) are left as they are when nil
+function batch_methods:set(i, position, rotation, scale)
+    local positions = self.positions
+    positions.x[i], positions.y[i], positions.z[i] = position.x, position.y, position.z
+    if rotation then
+        self.rotationX[i], self.rotationY[i], self.rotationZ[i], self.rotationW[i] = rotation.x, rotation.y, rotation.z, rotation.w
+    end
+    if scale then
+        local scales = self.scales
+        if type(scale) == "number" then
+            scales.x[i], scales.y[i], scales.z[i] = scale, scale, scale
+        else
+            scales.x[i], scales.y[i], scales.z[i] = scale.x, scale.y, scale.z
+        end
+    end
+    C.InstanceBatchMarkDirty(self, i, 1)
+end
+
+---Draw every mesh of `model` with its material (model.transform is not applied)
+function batch_methods:drawModel(model)
+    for m = 0, model.meshCount - 1 do
+        C.InstanceBatchDraw(self, model.meshes[m], model.materials[model.meshMaterial[m]])
+    end
+end
+
+---Column-major float[16] per instance, valid after update() or draw()
+batch_methods.matrices = C.InstanceBatchGetMatrices
+
+---Counters of the last update/draw, pass a table to reuse it
+function batch_methods:stats(out)
+    local stats = ffi.new("InstanceBatchStats")
+    C.InstanceBatchGetStats(self, stats)
+    out = out or {}
+    out.instances, out.rebuilt, out.uploaded, out.buildMs = stats.instances, stats.rebuilt, stats.uploaded, stats.buildMs
+    return out
+end
+
+function batch_methods:destroy()
+    C.InstanceBatchDestroy(ffi.gc(self, nil))
+end
+
+ffi.metatype("InstanceBatch", {
+    __index = batch_methods,
+    __len = function(self) return self.count end,
+})
+
+---Create a batch with room for `capacity` instances; resize() sets how many are drawn
+function instancing.new(capacity)
+    local batch = C.InstanceBatchCreate(capacity or 1024)
+    if batch == nil then
+        return nil
+    end
+    return ffi.gc(batch, C.InstanceBatchDestroy)
+end
+
+---Unlit instancing shader (texture0 * colDiffuse), needs a window
+instancing.shader = C.LoadInstancingShader
+
+---Time building `count` transforms per frame: the Matrix array rl.DrawMeshInstanced
+---needs, built from Lua with raymath, against the batch's native update. Needs no
+---window. Returns ms per frame for both.
+function instancing.benchmark(count, iterations)
+    count = count or 10000
+    iterations = iterations or 50
+
+    local batch = instancing.new(count)
+    batch:resize(count)
+    local random = math.random
+    for i = 0, count - 1 do
+        local rotation = rl.QuaternionFromAxisAngle(rl.new("Vector3", 0, 1, 0), random() * 6.28)
+        batch:set(i, rl.new("Vector3", random() * 100, 0, random() * 100), rotation, 0.5 + random())
+    end
+
+    local matrices = ffi.new("Matrix[?]", count)
+    local start = os.clock()
+    for _ = 1, iterations do
+        for i = 0, count - 1 do
+            local p, s = batch.positions, batch.scales
+            local rotation = rl.new("Quaternion", batch.rotationX[i], batch.rotationY[i], batch.rotationZ[i], batch.rotationW[i])
+            matrices[i] = rl.MatrixMultiply(rl.MatrixMultiply(rl.MatrixScale(s.x[i], s.y[i], s.z[i]), rl.QuaternionToMatrix(rotation)),
+                rl.MatrixTranslate(p.x[i], p.y[i], p.z[i]))
+        end
+    end
+    local lua = (os.clock() - start) / iterations * 1000
+
+    start = os.clock()
+    for _ = 1, iterations do
+        batch:dirty()
+        batch:update()
+    end
+    local native = (os.clock() - start) / iterations * 1000
+
+    rl.TraceLog(rl.LOG_INFO, "INSTANCING: %d transforms: %.2f ms from Lua, %.3f ms native per frame",
+        ffi.new("int", count), lua, native)
+    batch:destroy()
+    return { lua = lua, native = native }
+end
+
+return instancing
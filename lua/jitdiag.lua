@@ -0,0 +1,140 @@
+-- LuaJIT trace diagnostics, enabled with the --jit-diag command line flag
+--
+-- Collects trace starts, completions and aborts per source line, logs
+-- every abort through TraceLog (LOG_DEBUG) and writes a ranked report
+-- when the game exits (or on jitdiag.report()).
+
+local ffi = require("ffi")
+local jit_util = require("jit.util")
+
+-- jit/vmdef.lua is optional, it turns abort codes into readable reasons
+local has_vmdef, vmdef = pcall(require, "jit.vmdef")
+
+local jitdiag = {}
+
+local REPORT_LIMIT = 40
+
+local lines = {}        -- "file:line" -> { starts, stops, aborts, reasons = { reason -> count } }
+local trace_origin = {} -- trace number -> "file:line" where recording started
+local total = { starts = 0, stops = 0, aborts = 0, flushes = 0 }
+local attached = false
+local output = nil
+
+local function location(func, pc)
+    local info = jit_util.funcinfo(func, pc)
+    if info.source then
+        return info.source:gsub("^@", "") .. ":" .. (info.currentline or 0)
+    end
+    return info.loc or "?"
+end
+
+local function line_stats(loc)
+    local stats = lines[loc]
+    if not stats then
+        stats = { starts = 0, stops = 0, aborts = 0, reasons = {} }
+        lines[loc] = stats
+    end
+    return stats
+end
+
+local function abort_reason(code, info)
+    if has_vmdef and vmdef.traceerr[code] then
+        local text = vmdef.traceerr[code]
+        if type(info) == "function" then
+            info = jit_util.funcinfo(info).loc or "?"
+        elseif type(info) == "number" and vmdef.ffnames and text:find("%%s") then
+            info = vmdef.ffnames[info] or info
+        end
+        return (text:format(info))
+    end
+    return "trace error " .. tostring(code) .. (info ~= nil and (" (" .. tostring(info) .. ")") or "")
+end
+
+local function on_trace(what, tr, func, pc, otr, oex)
+    if what == "start" then
+        local loc = location(func, pc)
+        trace_origin[tr] = loc
+        line_stats(loc).starts = line_stats(loc).starts + 1
+        total.starts = total.starts + 1
+    elseif what == "stop" then
+        local loc = trace_origin[tr] or "?"
+        line_stats(loc).stops = line_stats(loc).stops + 1
+        total.stops = total.stops + 1
+    elseif what == "abort" then
+        local loc = location(func, pc)
+        local reason = abort_reason(otr, oex)
+        local stats = line_stats(loc)
+        stats.aborts = stats.aborts + 1
+        stats.reasons[reason] = (stats.reasons[reason] or 0) + 1
+        total.aborts = total.aborts + 1
+        rl.TraceLog(rl.LOG_DEBUG, "JIT: Trace %d aborted at %s: %s", ffi.new("int", tr), loc, reason)
+    elseif what == "flush" then
+        total.flushes = total.flushes + 1
+        rl.TraceLog(rl.LOG_DEBUG, "JIT: Trace cache flushed")
+    end
+end
+
+---Start collecting trace events, report is written to `fileName` (default jitdiag.txt)
+function jitdiag.start(fileName)
+    if attached then
+        return
+    end
+    output = fileName or "jitdiag.txt"
+    jit.attach(on_trace, "trace")
+    attached = true
+    rl.AddShutdownHook(jitdiag.report)
+    rl.TraceLog(rl.LOG_INFO, "JIT: Trace diagnostics enabled (%s)", jit.status() and "JIT on" or "JIT off")
+end
+
+function jitdiag.stop()
+    if attached then
+        jit.attach(on_trace)
+        attached = false
+    end
+end
+
+---Write the report ranked by aborts per source line
+function jitdiag.report()
+    local ranked = {}
+    for loc, stats in pairs(lines) do
+        if stats.aborts > 0 then
+            ranked[#ranked + 1] = { loc = loc, stats = stats }
+        end
+    end
+    table.sort(ranked, function(a, b) return a.stats.aborts > b.stats.aborts end)
+
+    local out = {}
+    out[#out + 1] = string.format("traces: %d started, %d completed, %d aborted, %d flushes",
+        total.starts, total.stops, total.aborts, total.flushes)
+    if not has_vmdef then
+        out[#out + 1] = "note: jit/vmdef.lua not found in lua/, abort reasons are shown as codes"
+    end
+
+    for i = 1, math.min(#ranked, REPORT_LIMIT) do
+        local entry = ranked[i]
+        out[#out + 1] = string.format("%5d aborts  %5d starts  %s", entry.stats.aborts, entry.stats.starts, entry.loc)
+
+        local reasons = {}
+        for reason, count in pairs(entry.stats.reasons) do
+            reasons[#reasons + 1] = { reason = reason, count = count }
+        end
+        table.sort(reasons, function(a, b) return a.count > b.count end)
+        for _, r in ipairs(reasons) do
+            out[#out + 1] = string.format("      %5d x %s", r.count, r.reason)
+        end
+    end
+
+    local report = table.concat(out, "\n")
+    for _, line in ipairs(out) do
+        rl.TraceLog(rl.LOG_INFO, "JIT: %s", line)
+    end
+
+    local file = io.open(output or "jitdiag.txt", "w")
+    if file then
+        file:write(report, "\n")
+        file:close()
+    end
+    return report
+end
+
+return jitdiag
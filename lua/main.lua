@@ -1,3 +1,5 @@
+local text = require("text")
+
 rl.SetConfigFlags(rl.FLAG_VSYNC_HINT)
 
 rl.InitWindow(800, 450, "basic window")
@@ -6,7 +8,8 @@ while not rl.WindowShouldClose() do
 	rl.BeginDrawing()
 
 	rl.ClearBackground(rl.RAYWHITE)
-	rl.DrawText("Congrats! You created your first window!", 190, 200, 20, rl.LIGHTGRAY)
+	text.draw("Congrats! You created your first window!", 190, 200, 20, rl.LIGHTGRAY)
+	text.flush()
 
 	rl.EndDrawing()
 end
@@ -0,0 +1,187 @@
+-- sampling profiler for Lua code with native zones for raylib calls
+--
+-- profiler.start()               -- or profiler.toggle() from a debug key
+-- ...
+-- profiler.stop()                -- writes profile.folded and profile.trace.json
+--
+-- profile.folded is in collapsed-stack format (flamegraph.pl, speedscope),
+-- profile.trace.json opens in chrome://tracing or Perfetto
+
+local ffi = require("ffi")
+local jit_profile = require("jit.profile")
+
+ffi.cdef[[
+void ProfilerSetEnabled(bool enabled);
+bool ProfilerIsEnabled();
+void ProfilerReset();
+
+int ProfilerZoneId(const char *name);
+void ProfilerBeginZone(int zoneId);
+void ProfilerEndZone();
+const char *ProfilerCurrentZone();
+
+bool ProfilerSaveChromeTrace(const char *fileName);
+]]
+
+local C = ffi.C
+
+local profiler = {}
+
+local running = false
+local options = nil
+local stacks = {}
+local sample_count = 0
+
+local VMSTATE_FRAMES = { G = "[GC]", J = "[JIT compiler]" }
+
+local function on_sample(thread, samples, vmstate)
+    local stack = jit_profile.dumpstack(thread, options.format, -options.depth)
+    stack = stack:gsub("profiler%.lua:[^;]*;", ""):gsub(";$", "")
+
+    if vmstate == "C" then
+        local zone = C.ProfilerCurrentZone()
+        stack = stack .. ";[C] " .. (zone ~= nil and ffi.string(zone) or "native")
+    elseif VMSTATE_FRAMES[vmstate] then
+        stack = stack .. ";" .. VMSTATE_FRAMES[vmstate]
+    end
+
+    stacks[stack] = (stacks[stack] or 0) + samples
+    sample_count = sample_count + samples
+end
+
+-- raylib calls are timed by swapping the functions bound into `rl` for
+-- wrapping ones, and the __index fallback for a wrapping one
+local rl_meta = getmetatable(rl)
+local plain_index = rl_meta.__index
+local wrapped = {}
+local unwrapped = {}
+
+local function is_function(value)
+    return type(value) == "cdata" and tostring(ffi.typeof(value)):find("%(") ~= nil
+end
+
+local function wrap(name, fn)
+    local zone = C.ProfilerZoneId(name)
+    return function(...)
+        C.ProfilerBeginZone(zone)
+        local result = fn(...)
+        C.ProfilerEndZone()
+        return result
+    end
+end
+
+-- functions declared lazily while profiling are bound into `rl` by the
+-- plain __index, swap them for their wrapper right away
+local function wrapping_index(_, key)
+    local ok, value = pcall(plain_index, rl, key)
+    if not ok then
+        return nil
+    end
+    if is_function(value) then
+        wrapped[key] = wrapped[key] or wrap(key, value)
+        unwrapped[key] = value
+        rl[key] = wrapped[key]
+        return wrapped[key]
+    end
+    return value
+end
+
+local function wrap_bindings()
+    for key, value in pairs(rl) do
+        if is_function(value) then
+            wrapped[key] = wrapped[key] or wrap(key, value)
+            unwrapped[key] = value
+            rl[key] = wrapped[key]
+        end
+    end
+    rl_meta.__index = wrapping_index
+end
+
+local function unwrap_bindings()
+    for key, value in pairs(unwrapped) do
+        -- leave anything the game replaced while profiling alone
+        if rl[key] == wrapped[key] then
+            rl[key] = value
+        end
+    end
+    unwrapped = {}
+    rl_meta.__index = plain_index
+end
+
+---Begin a named native zone from Lua, close it with `profiler.pop()`
+function profiler.push(name)
+    C.ProfilerBeginZone(C.ProfilerZoneId(name))
+end
+
+function profiler.pop()
+    C.ProfilerEndZone()
+end
+
+---Start sampling. opts: interval (ms, default 1), depth (default 64),
+---native (time raylib calls, default true), output (file prefix, default "profile")
+function profiler.start(opts)
+    if running then
+        return
+    end
+
+    opts = opts or {}
+    options = {
+        interval = opts.interval or 1,
+        depth = opts.depth or 64,
+        native = opts.native ~= false,
+        output = opts.output or "profile",
+        format = "F;",
+    }
+
+    stacks, sample_count = {}, 0
+    C.ProfilerReset()
+    C.ProfilerSetEnabled(true)
+    if options.native then
+        wrap_bindings()
+    end
+
+    jit_profile.start("i" .. options.interval, on_sample)
+    running = true
+    rl.TraceLog(rl.LOG_INFO, "PROF: Started sampling every %d ms", ffi.new("int", options.interval))
+end
+
+---Stop sampling and write the collapsed stacks and the native zone trace
+function profiler.stop()
+    if not running then
+        return
+    end
+
+    jit_profile.stop()
+    C.ProfilerSetEnabled(false)
+    unwrap_bindings()
+    running = false
+
+    local folded_name = options.output .. ".folded"
+    local file, err = io.open(folded_name, "w")
+    if file then
+        for stack, count in pairs(stacks) do
+            file:write(stack, " ", count, "\n")
+        end
+        file:close()
+        rl.TraceLog(rl.LOG_INFO, "PROF: Saved %d samples to %s", ffi.new("int", sample_count), folded_name)
+    else
+        rl.TraceLog(rl.LOG_ERROR, "PROF: Could not write %s: %s", folded_name, tostring(err))
+    end
+
+    C.ProfilerSaveChromeTrace(options.output .. ".trace.json")
+end
+
+function profiler.toggle(opts)
+    if running then
+        profiler.stop()
+    else
+        profiler.start(opts)
+    end
+    return running
+end
+
+function profiler.running()
+    return running
+end
+
+return profiler
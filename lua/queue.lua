@@ -0,0 +1,64 @@
+-- lock-free message queues shared with native code and other threads
+--
+-- local q = queue.create("assets", "AssetEvent", 256)
+-- q:push(event)                  -- copies the record, no allocation
+-- while q:pop(event) do ... end  -- reuses a single out record
+
+local ffi = require("ffi")
+
+ffi.cdef[[
+typedef struct Queue Queue;
+
+Queue *QueueCreate(const char *name, int recordSize, int capacity, bool multiProducer);
+Queue *QueueFind(const char *name);
+void QueueDestroy(Queue *queue);
+
+bool QueuePush(Queue *queue, const void *record);
+bool QueuePop(Queue *queue, void *record);
+int QueuePushN(Queue *queue, const void *records, int count);
+int QueuePopN(Queue *queue, void *records, int count);
+
+int QueueCount(const Queue *queue);
+int QueueCapacity(const Queue *queue);
+int QueueRecordSize(const Queue *queue);
+]]
+
+local C = ffi.C
+
+local queue = {}
+
+ffi.metatype("Queue", {
+    __index = {
+        push = C.QueuePush,
+        pop = C.QueuePop,
+        pushn = C.QueuePushN,
+        popn = C.QueuePopN,
+        count = C.QueueCount,
+        capacity = C.QueueCapacity,
+        recordSize = C.QueueRecordSize,
+        destroy = C.QueueDestroy,
+    },
+})
+
+---Create a queue of `ctype` records, `multiProducer` selects MPSC over SPSC
+function queue.create(name, ctype, capacity, multiProducer)
+    local q = C.QueueCreate(name, ffi.sizeof(ctype), capacity, multiProducer or false)
+    if q == nil then
+        error("failed to create queue '" .. tostring(name) .. "'")
+    end
+    return q
+end
+
+---Look up a queue created by another script or by native code
+function queue.find(name, ctype)
+    local q = C.QueueFind(name)
+    if q == nil then
+        return nil
+    end
+    if ctype and C.QueueRecordSize(q) ~= ffi.sizeof(ctype) then
+        error("queue '" .. name .. "' record size does not match " .. tostring(ctype))
+    end
+    return q
+end
+
+return queue
@@ -1,6 +1,59 @@
 local ffi = require("ffi")
 
-ffi.cdef[[
+-- declared names are copied into `rl` once the library is loaded (functions
+-- as soon as they are declared), so `rl.DrawText` is a plain table hit
+-- instead of an __index miss followed by a clib namespace lookup per call
+local declared_symbols = {}
+
+local function declare(decls)
+    ffi.cdef(decls)
+
+    for body in decls:gmatch("enum[%s%w_]*(%b{})") do
+        for name in body:gsub("//[^\n]*", ""):gmatch("[{,]%s*([%a_][%w_]*)") do
+            declared_symbols[#declared_symbols + 1] = name
+        end
+    end
+end
+
+-- function declarations are kept as text and only parsed by ffi.cdef when
+-- needed: at startup for the eager groups, or only for the names listed in
+-- lua/bindings.txt (see `./build.sh bindings`), everything else on first
+-- access through the rl __index fallback. Lazy groups are not even scanned
+-- until a name is missing.
+local LAZY_GROUPS = { rmodels = true, raudio = true }
+
+local pending_functions = {} -- name -> declaration
+local group_functions = {}   -- group -> names
+local lazy_blocks = {}
+
+-- one declaration per line, typedefs in between are declared right away
+local function scan_functions(decls)
+    local names, other = {}, {}
+    for line in decls:gmatch("[^\n]+") do
+        local name = line:match("^%s*[%a_][^(/]-%f[%w_]([%a_][%w_]*)%(")
+        if name then
+            pending_functions[name] = line
+            names[#names + 1] = name
+        elseif line:find("^%s*[^%s/]") then
+            other[#other + 1] = line
+        end
+    end
+
+    if #other > 0 then
+        ffi.cdef(table.concat(other, "\n"))
+    end
+    return names
+end
+
+local function declare_functions(group, decls)
+    if LAZY_GROUPS[group] then
+        lazy_blocks[#lazy_blocks + 1] = decls
+    else
+        group_functions[group] = scan_functions(decls)
+    end
+end
+
+declare[[
 // Vector2, 2 components
 typedef struct Vector2 {
     float x;                // Vector x component
@@ -325,7 +378,7 @@ typedef struct AutomationEventList {
 
 -- raylib enum definitions
 
-ffi.cdef[[
+declare[[
 typedef enum {
     FLAG_VSYNC_HINT         = 0x00000040,   // Set to try enabling V-Sync on GPU
     FLAG_FULLSCREEN_MODE    = 0x00000002,   // Set to run program in fullscreen
@@ -479,7 +532,7 @@ typedef enum {
 } KeyboardKey;
 ]]
 
-ffi.cdef[[
+declare[[
 // Mouse buttons
 typedef enum {
     MOUSE_BUTTON_LEFT    = 0,       // Mouse button left
@@ -554,7 +607,7 @@ typedef enum {
 } MaterialMapIndex;
 ]]
 
-ffi.cdef[[
+declare[[
 // Shader location index
 typedef enum {
     SHADER_LOC_VERTEX_POSITION = 0, // Shader location: vertex attribute: position
@@ -589,7 +642,7 @@ typedef enum {
 } ShaderLocationIndex;
 ]]
 
-ffi.cdef[[
+declare[[
 // Shader uniform data type
 typedef enum {
     SHADER_UNIFORM_FLOAT = 0,       // Shader uniform type: float
@@ -737,7 +790,7 @@ typedef bool (*SaveFileTextCallback)(const char *fileName, char *text); // FileI
 
 -- raylib rcore definitions
 
-ffi.cdef[[
+declare_functions("rcore", [[
     // Window-related functions
     void InitWindow(int width, int height, const char *title);  // Initialize window and OpenGL context
     void CloseWindow(void);                                     // Close window and unload OpenGL context
@@ -1005,9 +1058,9 @@ ffi.cdef[[
     //------------------------------------------------------------------------------------
     void UpdateCamera(Camera *camera, int mode);      // Update camera position for selected mode
     void UpdateCameraPro(Camera *camera, Vector3 movement, Vector3 rotation, float zoom); // Update camera movement/rotation
-]]
+]])
 
-ffi.cdef[[
+declare_functions("rshapes", [[
 // Set texture and rectangle to be used on shapes drawing
     // NOTE: It can be useful when using basic shapes and one single font,
     // defining a font char white rectangle would allow drawing everything in a single draw call
@@ -1085,11 +1138,11 @@ ffi.cdef[[
     bool CheckCollisionPointPoly(Vector2 point, const Vector2 *points, int pointCount);                // Check if point is within a polygon described by array of vertices
     bool CheckCollisionLines(Vector2 startPos1, Vector2 endPos1, Vector2 startPos2, Vector2 endPos2, Vector2 *collisionPoint); // Check the collision between two lines defined by two points each, returns collision point by reference
     Rectangle GetCollisionRec(Rectangle rec1, Rectangle rec2);                                         // Get collision rectangle for two rectangles collision
-]]
+]])
 
 -- raylib rtextures definitions
 
-ffi.cdef[[
+declare_functions("rtextures", [[
     // Image loading functions
     // NOTE: These functions do not require GPU access
     Image LoadImage(const char *fileName);                                                             // Load image from file into CPU memory (RAM)
@@ -1223,11 +1276,11 @@ ffi.cdef[[
     Color GetPixelColor(void *srcPtr, int format);                        // Get Color from a source pixel pointer of certain format
     void SetPixelColor(void *dstPtr, Color color, int format);            // Set color formatted into destination pixel pointer
     int GetPixelDataSize(int width, int height, int format);              // Get pixel data size in bytes for certain format
-]]
+]])
 
 -- raylib rtext definitions
 
-ffi.cdef[[
+declare_functions("rtext", [[
     // Font loading/unloading functions
     Font GetFontDefault(void);                                                            // Get the default Font
     Font LoadFont(const char *fileName);                                                  // Load font from file into GPU memory (VRAM)
@@ -1289,11 +1342,11 @@ ffi.cdef[[
 
     int TextToInteger(const char *text);                            // Get integer value from text (negative values not supported)
     float TextToFloat(const char *text);                            // Get float value from text (negative values not supported)
-]]
+]])
 
 -- raylib rmodels definitions
 
-ffi.cdef[[
+declare_functions("rmodels", [[
     // Basic geometric 3D shapes drawing functions
     void DrawLine3D(Vector3 startPos, Vector3 endPos, Color color);                                    // Draw a line in 3D world space
     void DrawPoint3D(Vector3 position, Color color);                                                   // Draw a point in 3D space, actually a small line
@@ -1389,11 +1442,11 @@ ffi.cdef[[
     RayCollision GetRayCollisionMesh(Ray ray, Mesh mesh, Matrix transform);                       // Get collision info between ray and mesh
     RayCollision GetRayCollisionTriangle(Ray ray, Vector3 p1, Vector3 p2, Vector3 p3);            // Get collision info between ray and triangle
     RayCollision GetRayCollisionQuad(Ray ray, Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4);    // Get collision info between ray and quad
-]]
+]])
 
 -- raylib raudio definitions
 
-ffi.cdef[[
+declare_functions("raudio", [[
     // Audio device management functions
     void InitAudioDevice(void);                                     // Initialize audio device and context
     void CloseAudioDevice(void);                                    // Close the audio device and context
@@ -1473,11 +1526,11 @@ ffi.cdef[[
 
     void AttachAudioMixedProcessor(AudioCallback processor); // Attach audio stream processor to the entire audio pipeline, receives the samples as 'float'
     void DetachAudioMixedProcessor(AudioCallback processor); // Detach audio stream processor from the entire audio pipeline
-]]
+]])
 
 -- raymath definitions
 
-ffi.cdef[[
+declare_functions("raymath", [[
     typedef struct float3 { float v[3]; } float3;
     typedef struct float16 { float v[16]; } float16;
 
@@ -1601,7 +1654,7 @@ ffi.cdef[[
     Vector3 QuaternionToEuler(Quaternion q);                                    // Get the Euler angles equivalent to quaternion (roll, pitch, yaw) NOTE: Angles are returned in a Vector3 struct in radians
     Quaternion QuaternionTransform(Quaternion q, Matrix mat);                   // Transform a quaternion given a transformation matrix
     int QuaternionEquals(Quaternion p, Quaternion q);                           // Check whether two given quaternions are almost equal
-]]
+]])
 
 -- initialize library 
 
@@ -1609,7 +1662,93 @@ raylib = ffi.load("raylib")
 
 rl = {}
 
-setmetatable(rl, { __index = raylib })
+local function lookup(lib, name)
+    return lib[name]
+end
+
+-- declarations that are not exported by the library keep failing on use,
+-- through the __index fallback, exactly as before
+local function bind_symbols(names)
+    for i = 1, #names do
+        local name = names[i]
+        if rawget(rl, name) == nil then
+            local ok, value = pcall(lookup, raylib, name)
+            if ok then
+                rl[name] = value
+            end
+        end
+    end
+end
+
+bind_symbols(declared_symbols)
+
+local function declare_pending(names)
+    local decls = {}
+    for i = 1, #names do
+        local decl = pending_functions[names[i]]
+        if decl then
+            decls[#decls + 1] = decl
+            pending_functions[names[i]] = nil
+        end
+    end
+
+    if #decls > 0 then
+        ffi.cdef(table.concat(decls, "\n"))
+        bind_symbols(names)
+    end
+end
+
+local function scan_lazy_blocks()
+    for i = 1, #lazy_blocks do
+        scan_functions(lazy_blocks[i])
+    end
+    lazy_blocks = {}
+end
+
+setmetatable(rl, {
+    __index = function(_, name)
+        if pending_functions[name] == nil and #lazy_blocks > 0 then
+            scan_lazy_blocks()
+        end
+
+        if pending_functions[name] then
+            declare_pending({ name })
+            return rawget(rl, name)
+        end
+
+        -- report unknown names at the caller, like a direct clib access would
+        local ok, value = pcall(lookup, raylib, name)
+        if not ok then
+            error(tostring(value):gsub("^[^:]*:%d+: ", ""), 2)
+        end
+        return value
+    end
+})
+
+ffi.cdef[[
+bool VFSFileExists(const char *filePath);
+bool VFSGetDiskPath(const char *filePath, char *diskPath, int diskPathSize);
+]]
+
+-- trimmed mode: only declare what the game's scripts reference
+if ffi.C.VFSFileExists("lua/bindings.txt") then
+    declare_pending({ "LoadFileText", "UnloadFileText" })
+
+    local text = rl.LoadFileText("lua/bindings.txt")
+    local names = {}
+    for name in ffi.string(text):gmatch("[%a_][%w_]*") do
+        names[#names + 1] = name
+    end
+    rl.UnloadFileText(text)
+
+    declare_pending(names)
+else
+    for group, names in pairs(group_functions) do
+        if not LAZY_GROUPS[group] then
+            declare_pending(names)
+        end
+    end
+end
 
 -- utility functions
 
@@ -1619,6 +1758,23 @@ end
 
 rl.new = ffi.new
 
+local _shutdown_hooks = {}
+
+rl.AddShutdownHook = function(fn)
+    _shutdown_hooks[#_shutdown_hooks + 1] = fn
+end
+
+-- called by the host right before the Lua state is closed, last added runs first
+rl.RunShutdownHooks = function()
+    for i = #_shutdown_hooks, 1, -1 do
+        local ok, err = pcall(_shutdown_hooks[i])
+        if not ok then
+            print("WARNING: Shutdown hook failed: " .. tostring(err))
+        end
+    end
+    _shutdown_hooks = {}
+end
+
 local function new_color(r, g, b, a)
     return ffi.new("Color", r, g, b, a)
 end
@@ -1652,25 +1808,233 @@ rl.RAYWHITE = new_color(245, 245, 245, 255)
 
 -- math metamethods
 local pi, pow, sqrt, sin, cos = math.pi, math.pow, math.sqrt, math.sin, math.cos
-local new = ffi.new
+local new, istype = ffi.new, ffi.istype
+
+local Vector2 = ffi.typeof("Vector2")
+local Vector3 = ffi.typeof("Vector3")
+
+-- allocation-free vector math: results are written into `out` (which may
+-- alias an input) and `out` is returned, use these in hot loops where the
+-- JIT fails to sink the temporaries created by the operators
+
+function rl.Vector2Set(out, x, y)
+    out.x, out.y = x, y
+    return out
+end
+
+function rl.Vector2CopyInto(out, v)
+    out.x, out.y = v.x, v.y
+    return out
+end
+
+function rl.Vector2AddInto(out, v1, v2)
+    out.x, out.y = v1.x + v2.x, v1.y + v2.y
+    return out
+end
+
+function rl.Vector2AddScaledInto(out, v1, v2, scale)
+    out.x, out.y = v1.x + v2.x * scale, v1.y + v2.y * scale
+    return out
+end
+
+function rl.Vector2SubtractInto(out, v1, v2)
+    out.x, out.y = v1.x - v2.x, v1.y - v2.y
+    return out
+end
+
+function rl.Vector2ScaleInto(out, v, scale)
+    out.x, out.y = v.x * scale, v.y * scale
+    return out
+end
+
+function rl.Vector2MultiplyInto(out, v1, v2)
+    out.x, out.y = v1.x * v2.x, v1.y * v2.y
+    return out
+end
+
+function rl.Vector2DivideInto(out, v1, v2)
+    out.x, out.y = v1.x / v2.x, v1.y / v2.y
+    return out
+end
+
+function rl.Vector2NegateInto(out, v)
+    out.x, out.y = -v.x, -v.y
+    return out
+end
+
+function rl.Vector2NormalizeInto(out, v)
+    local length = sqrt(v.x * v.x + v.y * v.y)
+    if length > 0 then
+        local inv = 1.0 / length
+        out.x, out.y = v.x * inv, v.y * inv
+    else
+        out.x, out.y = v.x, v.y
+    end
+    return out
+end
+
+function rl.Vector2LerpInto(out, v1, v2, amount)
+    out.x, out.y = v1.x + amount * (v2.x - v1.x), v1.y + amount * (v2.y - v1.y)
+    return out
+end
+
+function rl.Vector2RotateInto(out, v, angle)
+    local c, s = cos(angle), sin(angle)
+    out.x, out.y = v.x * c - v.y * s, v.x * s + v.y * c
+    return out
+end
+
+function rl.Vector3Set(out, x, y, z)
+    out.x, out.y, out.z = x, y, z
+    return out
+end
+
+function rl.Vector3CopyInto(out, v)
+    out.x, out.y, out.z = v.x, v.y, v.z
+    return out
+end
+
+function rl.Vector3AddInto(out, v1, v2)
+    out.x, out.y, out.z = v1.x + v2.x, v1.y + v2.y, v1.z + v2.z
+    return out
+end
+
+function rl.Vector3AddScaledInto(out, v1, v2, scale)
+    out.x, out.y, out.z = v1.x + v2.x * scale, v1.y + v2.y * scale, v1.z + v2.z * scale
+    return out
+end
+
+function rl.Vector3SubtractInto(out, v1, v2)
+    out.x, out.y, out.z = v1.x - v2.x, v1.y - v2.y, v1.z - v2.z
+    return out
+end
+
+function rl.Vector3ScaleInto(out, v, scale)
+    out.x, out.y, out.z = v.x * scale, v.y * scale, v.z * scale
+    return out
+end
+
+function rl.Vector3MultiplyInto(out, v1, v2)
+    out.x, out.y, out.z = v1.x * v2.x, v1.y * v2.y, v1.z * v2.z
+    return out
+end
+
+function rl.Vector3DivideInto(out, v1, v2)
+    out.x, out.y, out.z = v1.x / v2.x, v1.y / v2.y, v1.z / v2.z
+    return out
+end
+
+function rl.Vector3NegateInto(out, v)
+    out.x, out.y, out.z = -v.x, -v.y, -v.z
+    return out
+end
 
-ffi.metatype("Vector2", {
+function rl.Vector3CrossProductInto(out, v1, v2)
+    out.x, out.y, out.z = v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z, v1.x * v2.y - v1.y * v2.x
+    return out
+end
+
+function rl.Vector3NormalizeInto(out, v)
+    local length = sqrt(v.x * v.x + v.y * v.y + v.z * v.z)
+    if length > 0 then
+        local inv = 1.0 / length
+        out.x, out.y, out.z = v.x * inv, v.y * inv, v.z * inv
+    else
+        out.x, out.y, out.z = v.x, v.y, v.z
+    end
+    return out
+end
+
+function rl.Vector3LerpInto(out, v1, v2, amount)
+    out.x = v1.x + amount * (v2.x - v1.x)
+    out.y = v1.y + amount * (v2.y - v1.y)
+    out.z = v1.z + amount * (v2.z - v1.z)
+    return out
+end
+
+local Vector2AddInto, Vector2AddScaledInto, Vector2SubtractInto = rl.Vector2AddInto, rl.Vector2AddScaledInto, rl.Vector2SubtractInto
+local Vector2ScaleInto, Vector2MultiplyInto, Vector2DivideInto = rl.Vector2ScaleInto, rl.Vector2MultiplyInto, rl.Vector2DivideInto
+local Vector2NegateInto, Vector2NormalizeInto = rl.Vector2NegateInto, rl.Vector2NormalizeInto
+local Vector2LerpInto, Vector2RotateInto = rl.Vector2LerpInto, rl.Vector2RotateInto
+
+local Vector3AddInto, Vector3AddScaledInto, Vector3SubtractInto = rl.Vector3AddInto, rl.Vector3AddScaledInto, rl.Vector3SubtractInto
+local Vector3ScaleInto, Vector3MultiplyInto, Vector3DivideInto = rl.Vector3ScaleInto, rl.Vector3MultiplyInto, rl.Vector3DivideInto
+local Vector3NegateInto, Vector3CrossProductInto = rl.Vector3NegateInto, rl.Vector3CrossProductInto
+local Vector3NormalizeInto, Vector3LerpInto = rl.Vector3NormalizeInto, rl.Vector3LerpInto
+
+-- methods, the trailing underscore marks in-place variants: v:add_(b) is v = v + b
+local vector2_methods = {
+    set = rl.Vector2Set,
+    copy = rl.Vector2CopyInto,
+    clone = function (a) return Vector2(a.x, a.y) end,
+    add_ = function (a, b) return Vector2AddInto(a, a, b) end,
+    addScaled_ = function (a, b, s) return Vector2AddScaledInto(a, a, b, s) end,
+    sub_ = function (a, b) return Vector2SubtractInto(a, a, b) end,
+    scale_ = function (a, s) return Vector2ScaleInto(a, a, s) end,
+    mul_ = function (a, b) return Vector2MultiplyInto(a, a, b) end,
+    div_ = function (a, b) return Vector2DivideInto(a, a, b) end,
+    neg_ = function (a) return Vector2NegateInto(a, a) end,
+    normalize_ = function (a) return Vector2NormalizeInto(a, a) end,
+    lerp_ = function (a, b, t) return Vector2LerpInto(a, a, b, t) end,
+    rotate_ = function (a, angle) return Vector2RotateInto(a, a, angle) end,
+    length = function (a) return sqrt(a.x * a.x + a.y * a.y) end,
+    lengthSqr = function (a) return a.x * a.x + a.y * a.y end,
+    dot = function (a, b) return a.x * b.x + a.y * b.y end,
+    distance = function (a, b)
+        local dx, dy = a.x - b.x, a.y - b.y
+        return sqrt(dx * dx + dy * dy)
+    end,
+    distanceSqr = function (a, b)
+        local dx, dy = a.x - b.x, a.y - b.y
+        return dx * dx + dy * dy
+    end,
+}
+
+local vector3_methods = {
+    set = rl.Vector3Set,
+    copy = rl.Vector3CopyInto,
+    clone = function (a) return Vector3(a.x, a.y, a.z) end,
+    add_ = function (a, b) return Vector3AddInto(a, a, b) end,
+    addScaled_ = function (a, b, s) return Vector3AddScaledInto(a, a, b, s) end,
+    sub_ = function (a, b) return Vector3SubtractInto(a, a, b) end,
+    scale_ = function (a, s) return Vector3ScaleInto(a, a, s) end,
+    mul_ = function (a, b) return Vector3MultiplyInto(a, a, b) end,
+    div_ = function (a, b) return Vector3DivideInto(a, a, b) end,
+    neg_ = function (a) return Vector3NegateInto(a, a) end,
+    cross_ = function (a, b) return Vector3CrossProductInto(a, a, b) end,
+    normalize_ = function (a) return Vector3NormalizeInto(a, a) end,
+    lerp_ = function (a, b, t) return Vector3LerpInto(a, a, b, t) end,
+    length = function (a) return sqrt(a.x * a.x + a.y * a.y + a.z * a.z) end,
+    lengthSqr = function (a) return a.x * a.x + a.y * a.y + a.z * a.z end,
+    dot = function (a, b) return a.x * b.x + a.y * b.y + a.z * b.z end,
+    distance = function (a, b)
+        local dx, dy, dz = a.x - b.x, a.y - b.y, a.z - b.z
+        return sqrt(dx * dx + dy * dy + dz * dz)
+    end,
+    distanceSqr = function (a, b)
+        local dx, dy, dz = a.x - b.x, a.y - b.y, a.z - b.z
+        return dx * dx + dy * dy + dz * dz
+    end,
+}
+
+ffi.metatype(Vector2, {
+  __index = vector2_methods,
   __add = function (a, b)
-    if ffi.istype("Vector2", b) then
-      return new("Vector2", a.x + b.x, a.y + b.y)
+    if istype(Vector2, b) then
+      return Vector2(a.x + b.x, a.y + b.y)
     else
       error "Invalid operation."
     end
   end,
   __sub = function (a, b)
-    if ffi.istype("Vector2", b) then
-      return new("Vector2", a.x - b.x, a.y - b.y)
+    if istype(Vector2, b) then
+      return Vector2(a.x - b.x, a.y - b.y)
     else
       error "Invalid operation."
     end
   end,
   __unm = function (a)
-    return new("Vector2", -a.x, -a.y)
+    return Vector2(-a.x, -a.y)
   end,
   __len = function (a)
     return sqrt(a.x * a.x + a.y * a.y)
@@ -1681,17 +2045,17 @@ ffi.metatype("Vector2", {
       a, b = b, a
     end
 
-    if ffi.istype("Vector2", b) then -- dot product
+    if istype(Vector2, b) then -- dot product
       return a.x * b.x + a.y * b.y
     elseif type(b) == "number" then
-      return new("Vector2", a.x * b, a.y * b)
+      return Vector2(a.x * b, a.y * b)
     else
       error "Invalid operation."
     end
   end,
   __div = function (a, b)
     if type(b) == "number" then
-      return new("Vector2", a.x / b, a.y / b)
+      return Vector2(a.x / b, a.y / b)
     else
       error "Invalid operation"
     end
@@ -1701,23 +2065,24 @@ ffi.metatype("Vector2", {
   end
 })
 
-ffi.metatype("Vector3", {
+ffi.metatype(Vector3, {
+  __index = vector3_methods,
   __add = function (a, b)
-    if ffi.istype("Vector3", b) then
-      return new("Vector3", a.x + b.x, a.y + b.y, a.z + b.z)
+    if istype(Vector3, b) then
+      return Vector3(a.x + b.x, a.y + b.y, a.z + b.z)
     else
       error "Invalid operation."
     end
   end,
   __sub = function (a, b)
-    if ffi.istype("Vector3", b) then
-      return new("Vector3", a.x - b.x, a.y - b.y, a.z - b.z)
+    if istype(Vector3, b) then
+      return Vector3(a.x - b.x, a.y - b.y, a.z - b.z)
     else
       error "Invalid operation."
     end
   end,
   __unm = function (a)
-    return new("Vector3", -a.x, -a.y, -a.z)
+    return Vector3(-a.x, -a.y, -a.z)
   end,
   __len = function (a)
     return sqrt(a.x * a.x + a.y * a.y + a.z * a.z)
@@ -1728,17 +2093,17 @@ ffi.metatype("Vector3", {
       a, b = b, a
     end
 
-    if ffi.istype("Vector3", b) then -- dot product
+    if istype(Vector3, b) then -- dot product
       return a.x * b.x + a.y * b.y + a.z * b.z
     elseif type(b) == "number" then
-      return new("Vector3", a.x * b, a.y * b, a.z * b)
+      return Vector3(a.x * b, a.y * b, a.z * b)
     else
       error "Invalid operation."
     end
   end,
   __div = function (a, b)
     if type(b) == "number" then
-      return new("Vector3", a.x / b, a.y / b, a.z / b)
+      return Vector3(a.x / b, a.y / b, a.z / b)
     else
       error "Invalid operation"
     end
@@ -1748,7 +2113,431 @@ ffi.metatype("Vector3", {
   end
 })
 
--- TODO: Matrix and Quaternion
+-- scratch pools hand out preallocated vectors round-robin, call reset()
+-- once per frame and never keep a pooled vector across frames. More get()
+-- calls than `size` between resets wrap around and hand out vectors that may
+-- still be in use; that is logged once per pool, make the pool bigger then
+local ScratchPool = {}
+ScratchPool.__index = ScratchPool
+
+local function new_scratch_pool(ctype, size)
+    local items = {}
+    for i = 1, size do
+        items[i] = ctype()
+    end
+    return setmetatable({ items = items, size = size, index = 0, wrapped = false }, ScratchPool)
+end
+
+function ScratchPool:get()
+    local index = self.index + 1
+    if index > self.size then
+        index = 1
+        if not self.wrapped then
+            self.wrapped = true
+            rl.TraceLog(rl.LOG_WARNING, "MATH: Scratch pool of %d wrapped before reset(), earlier vectors are reused",
+                ffi.new("int", self.size))
+        end
+    end
+    self.index = index
+    return self.items[index]
+end
+
+function ScratchPool:reset()
+    self.index = 0
+end
+
+rl.Vector2Pool = function(size)
+    return new_scratch_pool(Vector2, size or 256)
+end
+
+rl.Vector3Pool = function(size)
+    return new_scratch_pool(Vector3, size or 256)
+end
+
+-- Vector4, Quaternion and Matrix math, kernels follow raymath so results
+-- match the FFI versions but stay inside traces instead of copying
+-- 64-byte structs across the C boundary on every call
+
+local Vector4 = ffi.typeof("Vector4")
+local Matrix = ffi.typeof("Matrix")
+local acos, abs = math.acos, math.abs
+
+function rl.Vector4Set(out, x, y, z, w)
+    out.x, out.y, out.z, out.w = x, y, z, w
+    return out
+end
+
+function rl.Vector4CopyInto(out, v)
+    out.x, out.y, out.z, out.w = v.x, v.y, v.z, v.w
+    return out
+end
+
+function rl.Vector4AddInto(out, v1, v2)
+    out.x, out.y, out.z, out.w = v1.x + v2.x, v1.y + v2.y, v1.z + v2.z, v1.w + v2.w
+    return out
+end
+
+function rl.Vector4SubtractInto(out, v1, v2)
+    out.x, out.y, out.z, out.w = v1.x - v2.x, v1.y - v2.y, v1.z - v2.z, v1.w - v2.w
+    return out
+end
+
+function rl.Vector4ScaleInto(out, v, scale)
+    out.x, out.y, out.z, out.w = v.x * scale, v.y * scale, v.z * scale, v.w * scale
+    return out
+end
+
+function rl.Vector4NegateInto(out, v)
+    out.x, out.y, out.z, out.w = -v.x, -v.y, -v.z, -v.w
+    return out
+end
+
+function rl.Vector4LerpInto(out, v1, v2, amount)
+    out.x = v1.x + amount * (v2.x - v1.x)
+    out.y = v1.y + amount * (v2.y - v1.y)
+    out.z = v1.z + amount * (v2.z - v1.z)
+    out.w = v1.w + amount * (v2.w - v1.w)
+    return out
+end
+
+function rl.QuaternionNormalizeInto(out, q)
+    local length = sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w)
+    if length == 0 then length = 1 end
+    local inv = 1.0 / length
+    out.x, out.y, out.z, out.w = q.x * inv, q.y * inv, q.z * inv, q.w * inv
+    return out
+end
+
+function rl.QuaternionInvertInto(out, q)
+    local lengthSq = q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w
+    if lengthSq ~= 0 then
+        local inv = 1.0 / lengthSq
+        out.x, out.y, out.z, out.w = -q.x * inv, -q.y * inv, -q.z * inv, q.w * inv
+    else
+        out.x, out.y, out.z, out.w = q.x, q.y, q.z, q.w
+    end
+    return out
+end
+
+function rl.QuaternionMultiplyInto(out, q1, q2)
+    local qax, qay, qaz, qaw = q1.x, q1.y, q1.z, q1.w
+    local qbx, qby, qbz, qbw = q2.x, q2.y, q2.z, q2.w
+    out.x = qax * qbw + qaw * qbx + qay * qbz - qaz * qby
+    out.y = qay * qbw + qaw * qby + qaz * qbx - qax * qbz
+    out.z = qaz * qbw + qaw * qbz + qax * qby - qay * qbx
+    out.w = qaw * qbw - qax * qbx - qay * qby - qaz * qbz
+    return out
+end
+
+function rl.QuaternionNlerpInto(out, q1, q2, amount)
+    local x = q1.x + amount * (q2.x - q1.x)
+    local y = q1.y + amount * (q2.y - q1.y)
+    local z = q1.z + amount * (q2.z - q1.z)
+    local w = q1.w + amount * (q2.w - q1.w)
+    local length = sqrt(x * x + y * y + z * z + w * w)
+    if length == 0 then length = 1 end
+    local inv = 1.0 / length
+    out.x, out.y, out.z, out.w = x * inv, y * inv, z * inv, w * inv
+    return out
+end
+
+function rl.QuaternionSlerpInto(out, q1, q2, amount)
+    local ax, ay, az, aw = q1.x, q1.y, q1.z, q1.w
+    local bx, by, bz, bw = q2.x, q2.y, q2.z, q2.w
+    local cosHalfTheta = ax * bx + ay * by + az * bz + aw * bw
+
+    if cosHalfTheta < 0 then
+        bx, by, bz, bw = -bx, -by, -bz, -bw
+        cosHalfTheta = -cosHalfTheta
+    end
+
+    if cosHalfTheta >= 1.0 then
+        out.x, out.y, out.z, out.w = ax, ay, az, aw
+    elseif cosHalfTheta > 0.95 then
+        local x = ax + amount * (bx - ax)
+        local y = ay + amount * (by - ay)
+        local z = az + amount * (bz - az)
+        local w = aw + amount * (bw - aw)
+        local inv = 1.0 / sqrt(x * x + y * y + z * z + w * w)
+        out.x, out.y, out.z, out.w = x * inv, y * inv, z * inv, w * inv
+    else
+        local halfTheta = acos(cosHalfTheta)
+        local sinHalfTheta = sqrt(1.0 - cosHalfTheta * cosHalfTheta)
+
+        if abs(sinHalfTheta) < 0.000001 then
+            out.x, out.y, out.z, out.w = ax * 0.5 + bx * 0.5, ay * 0.5 + by * 0.5, az * 0.5 + bz * 0.5, aw * 0.5 + bw * 0.5
+        else
+            local ratioA = sin((1 - amount) * halfTheta) / sinHalfTheta
+            local ratioB = sin(amount * halfTheta) / sinHalfTheta
+            out.x = ax * ratioA + bx * ratioB
+            out.y = ay * ratioA + by * ratioB
+            out.z = az * ratioA + bz * ratioB
+            out.w = aw * ratioA + bw * ratioB
+        end
+    end
+    return out
+end
+
+function rl.QuaternionFromAxisAngleInto(out, axis, angle)
+    local length = sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z)
+    if length == 0 then
+        out.x, out.y, out.z, out.w = 0, 0, 0, 1
+        return out
+    end
+
+    local s = sin(angle * 0.5) / length
+    out.x, out.y, out.z, out.w = axis.x * s, axis.y * s, axis.z * s, cos(angle * 0.5)
+    return rl.QuaternionNormalizeInto(out, out)
+end
+
+function rl.Vector3RotateByQuaternionInto(out, v, q)
+    local x, y, z = v.x, v.y, v.z
+    local qx, qy, qz, qw = q.x, q.y, q.z, q.w
+    out.x = x * (qx * qx + qw * qw - qy * qy - qz * qz) + y * (2 * qx * qy - 2 * qw * qz) + z * (2 * qx * qz + 2 * qw * qy)
+    out.y = x * (2 * qw * qz + 2 * qx * qy) + y * (qw * qw - qx * qx + qy * qy - qz * qz) + z * (-2 * qw * qx + 2 * qy * qz)
+    out.z = x * (-2 * qw * qy + 2 * qx * qz) + y * (2 * qw * qx + 2 * qy * qz) + z * (qw * qw - qx * qx - qy * qy + qz * qz)
+    return out
+end
+
+function rl.Vector3TransformInto(out, v, mat)
+    local x, y, z = v.x, v.y, v.z
+    out.x = mat.m0 * x + mat.m4 * y + mat.m8 * z + mat.m12
+    out.y = mat.m1 * x + mat.m5 * y + mat.m9 * z + mat.m13
+    out.z = mat.m2 * x + mat.m6 * y + mat.m10 * z + mat.m14
+    return out
+end
+
+function rl.MatrixSetIdentity(out)
+    out.m0, out.m4, out.m8, out.m12 = 1, 0, 0, 0
+    out.m1, out.m5, out.m9, out.m13 = 0, 1, 0, 0
+    out.m2, out.m6, out.m10, out.m14 = 0, 0, 1, 0
+    out.m3, out.m7, out.m11, out.m15 = 0, 0, 0, 1
+    return out
+end
+
+function rl.MatrixCopyInto(out, mat)
+    ffi.copy(out, mat, 64)
+    return out
+end
+
+-- same operand order as raymath: MatrixMultiply(a, b) applies a, then b
+function rl.MatrixMultiplyInto(out, left, right)
+    local l0, l1, l2, l3 = left.m0, left.m1, left.m2, left.m3
+    local l4, l5, l6, l7 = left.m4, left.m5, left.m6, left.m7
+    local l8, l9, l10, l11 = left.m8, left.m9, left.m10, left.m11
+    local l12, l13, l14, l15 = left.m12, left.m13, left.m14, left.m15
+    local r0, r1, r2, r3 = right.m0, right.m1, right.m2, right.m3
+    local r4, r5, r6, r7 = right.m4, right.m5, right.m6, right.m7
+    local r8, r9, r10, r11 = right.m8, right.m9, right.m10, right.m11
+    local r12, r13, r14, r15 = right.m12, right.m13, right.m14, right.m15
+
+    out.m0 = l0 * r0 + l1 * r4 + l2 * r8 + l3 * r12
+    out.m1 = l0 * r1 + l1 * r5 + l2 * r9 + l3 * r13
+    out.m2 = l0 * r2 + l1 * r6 + l2 * r10 + l3 * r14
+    out.m3 = l0 * r3 + l1 * r7 + l2 * r11 + l3 * r15
+    out.m4 = l4 * r0 + l5 * r4 + l6 * r8 + l7 * r12
+    out.m5 = l4 * r1 + l5 * r5 + l6 * r9 + l7 * r13
+    out.m6 = l4 * r2 + l5 * r6 + l6 * r10 + l7 * r14
+    out.m7 = l4 * r3 + l5 * r7 + l6 * r11 + l7 * r15
+    out.m8 = l8 * r0 + l9 * r4 + l10 * r8 + l11 * r12
+    out.m9 = l8 * r1 + l9 * r5 + l10 * r9 + l11 * r13
+    out.m10 = l8 * r2 + l9 * r6 + l10 * r10 + l11 * r14
+    out.m11 = l8 * r3 + l9 * r7 + l10 * r11 + l11 * r15
+    out.m12 = l12 * r0 + l13 * r4 + l14 * r8 + l15 * r12
+    out.m13 = l12 * r1 + l13 * r5 + l14 * r9 + l15 * r13
+    out.m14 = l12 * r2 + l13 * r6 + l14 * r10 + l15 * r14
+    out.m15 = l12 * r3 + l13 * r7 + l14 * r11 + l15 * r15
+    return out
+end
+
+function rl.MatrixTransposeInto(out, mat)
+    out.m0, out.m1, out.m2, out.m3, out.m4, out.m5, out.m6, out.m7,
+    out.m8, out.m9, out.m10, out.m11, out.m12, out.m13, out.m14, out.m15 =
+        mat.m0, mat.m4, mat.m8, mat.m12, mat.m1, mat.m5, mat.m9, mat.m13,
+        mat.m2, mat.m6, mat.m10, mat.m14, mat.m3, mat.m7, mat.m11, mat.m15
+    return out
+end
+
+function rl.MatrixInvertInto(out, mat)
+    local a00, a01, a02, a03 = mat.m0, mat.m1, mat.m2, mat.m3
+    local a10, a11, a12, a13 = mat.m4, mat.m5, mat.m6, mat.m7
+    local a20, a21, a22, a23 = mat.m8, mat.m9, mat.m10, mat.m11
+    local a30, a31, a32, a33 = mat.m12, mat.m13, mat.m14, mat.m15
+
+    local b00 = a00 * a11 - a01 * a10
+    local b01 = a00 * a12 - a02 * a10
+    local b02 = a00 * a13 - a03 * a10
+    local b03 = a01 * a12 - a02 * a11
+    local b04 = a01 * a13 - a03 * a11
+    local b05 = a02 * a13 - a03 * a12
+    local b06 = a20 * a31 - a21 * a30
+    local b07 = a20 * a32 - a22 * a30
+    local b08 = a20 * a33 - a23 * a30
+    local b09 = a21 * a32 - a22 * a31
+    local b10 = a21 * a33 - a23 * a31
+    local b11 = a22 * a33 - a23 * a32
+
+    local invDet = 1.0 / (b00 * b11 - b01 * b10 + b02 * b09 + b03 * b08 - b04 * b07 + b05 * b06)
+
+    out.m0 = (a11 * b11 - a12 * b10 + a13 * b09) * invDet
+    out.m1 = (-a01 * b11 + a02 * b10 - a03 * b09) * invDet
+    out.m2 = (a31 * b05 - a32 * b04 + a33 * b03) * invDet
+    out.m3 = (-a21 * b05 + a22 * b04 - a23 * b03) * invDet
+    out.m4 = (-a10 * b11 + a12 * b08 - a13 * b07) * invDet
+    out.m5 = (a00 * b11 - a02 * b08 + a03 * b07) * invDet
+    out.m6 = (-a30 * b05 + a32 * b02 - a33 * b01) * invDet
+    out.m7 = (a20 * b05 - a22 * b02 + a23 * b01) * invDet
+    out.m8 = (a10 * b10 - a11 * b08 + a13 * b06) * invDet
+    out.m9 = (-a00 * b10 + a01 * b08 - a03 * b06) * invDet
+    out.m10 = (a30 * b04 - a31 * b02 + a33 * b00) * invDet
+    out.m11 = (-a20 * b04 + a21 * b02 - a23 * b00) * invDet
+    out.m12 = (-a10 * b09 + a11 * b07 - a12 * b06) * invDet
+    out.m13 = (a00 * b09 - a01 * b07 + a02 * b06) * invDet
+    out.m14 = (-a30 * b03 + a31 * b01 - a32 * b00) * invDet
+    out.m15 = (a20 * b03 - a21 * b01 + a22 * b00) * invDet
+    return out
+end
+
+function rl.MatrixTranslateInto(out, x, y, z)
+    rl.MatrixSetIdentity(out)
+    out.m12, out.m13, out.m14 = x, y, z
+    return out
+end
+
+function rl.MatrixScaleInto(out, x, y, z)
+    rl.MatrixSetIdentity(out)
+    out.m0, out.m5, out.m10 = x, y, z
+    return out
+end
+
+function rl.QuaternionToMatrixInto(out, q)
+    local a2, b2, c2 = q.x * q.x, q.y * q.y, q.z * q.z
+    local ac, ab, bc = q.x * q.z, q.x * q.y, q.y * q.z
+    local ad, bd, cd = q.w * q.x, q.w * q.y, q.w * q.z
+
+    out.m0, out.m1, out.m2, out.m3 = 1 - 2 * (b2 + c2), 2 * (ab + cd), 2 * (ac - bd), 0
+    out.m4, out.m5, out.m6, out.m7 = 2 * (ab - cd), 1 - 2 * (a2 + c2), 2 * (bc + ad), 0
+    out.m8, out.m9, out.m10, out.m11 = 2 * (ac + bd), 2 * (bc - ad), 1 - 2 * (a2 + b2), 0
+    out.m12, out.m13, out.m14, out.m15 = 0, 0, 0, 1
+    return out
+end
+
+-- scale, then rotate, then translate (the usual model/bone transform)
+function rl.MatrixFromTRSInto(out, translation, rotation, scale)
+    rl.QuaternionToMatrixInto(out, rotation)
+    local sx, sy, sz = scale.x, scale.y, scale.z
+    out.m0, out.m1, out.m2 = out.m0 * sx, out.m1 * sx, out.m2 * sx
+    out.m4, out.m5, out.m6 = out.m4 * sy, out.m5 * sy, out.m6 * sy
+    out.m8, out.m9, out.m10 = out.m8 * sz, out.m9 * sz, out.m10 * sz
+    out.m12, out.m13, out.m14 = translation.x, translation.y, translation.z
+    return out
+end
+
+local Vector4AddInto, Vector4SubtractInto, Vector4ScaleInto = rl.Vector4AddInto, rl.Vector4SubtractInto, rl.Vector4ScaleInto
+local Vector4NegateInto, Vector4LerpInto = rl.Vector4NegateInto, rl.Vector4LerpInto
+local QuaternionMultiplyInto, QuaternionNormalizeInto = rl.QuaternionMultiplyInto, rl.QuaternionNormalizeInto
+local QuaternionInvertInto, QuaternionNlerpInto, QuaternionSlerpInto = rl.QuaternionInvertInto, rl.QuaternionNlerpInto, rl.QuaternionSlerpInto
+local QuaternionToMatrixInto, Vector3RotateByQuaternionInto = rl.QuaternionToMatrixInto, rl.Vector3RotateByQuaternionInto
+local MatrixMultiplyInto, MatrixInvertInto, MatrixTransposeInto = rl.MatrixMultiplyInto, rl.MatrixInvertInto, rl.MatrixTransposeInto
+local MatrixSetIdentity, Vector3TransformInto = rl.MatrixSetIdentity, rl.Vector3TransformInto
+
+-- Quaternion is a Vector4 alias, so both share these methods
+local vector4_methods = {
+    set = rl.Vector4Set,
+    copy = rl.Vector4CopyInto,
+    clone = function (a) return Vector4(a.x, a.y, a.z, a.w) end,
+    add_ = function (a, b) return Vector4AddInto(a, a, b) end,
+    sub_ = function (a, b) return Vector4SubtractInto(a, a, b) end,
+    scale_ = function (a, s) return Vector4ScaleInto(a, a, s) end,
+    neg_ = function (a) return Vector4NegateInto(a, a) end,
+    lerp_ = function (a, b, t) return Vector4LerpInto(a, a, b, t) end,
+    normalize_ = function (a) return QuaternionNormalizeInto(a, a) end,
+    length = function (a) return sqrt(a.x * a.x + a.y * a.y + a.z * a.z + a.w * a.w) end,
+    dot = function (a, b) return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w end,
+    -- quaternion operations
+    identity_ = function (a) a.x, a.y, a.z, a.w = 0, 0, 0, 1 return a end,
+    mul_ = function (a, b) return QuaternionMultiplyInto(a, a, b) end,
+    invert_ = function (a) return QuaternionInvertInto(a, a) end,
+    nlerp_ = function (a, b, t) return QuaternionNlerpInto(a, a, b, t) end,
+    slerp_ = function (a, b, t) return QuaternionSlerpInto(a, a, b, t) end,
+    rotate = function (q, v, out) return Vector3RotateByQuaternionInto(out or Vector3(), v, q) end,
+    toMatrix = function (q, out) return QuaternionToMatrixInto(out or Matrix(), q) end,
+}
+
+local matrix_methods = {
+    copy = rl.MatrixCopyInto,
+    clone = function (a) return Matrix(a) end,
+    identity_ = MatrixSetIdentity,
+    mul_ = function (a, b) return MatrixMultiplyInto(a, a, b) end,
+    invert_ = function (a) return MatrixInvertInto(a, a) end,
+    transpose_ = function (a) return MatrixTransposeInto(a, a) end,
+    transform = function (m, v, out) return Vector3TransformInto(out or Vector3(), v, m) end,
+}
+
+ffi.metatype(Vector4, {
+  __index = vector4_methods,
+  __add = function (a, b)
+    return Vector4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w)
+  end,
+  __sub = function (a, b)
+    return Vector4(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w)
+  end,
+  __unm = function (a)
+    return Vector4(-a.x, -a.y, -a.z, -a.w)
+  end,
+  __len = function (a)
+    return sqrt(a.x * a.x + a.y * a.y + a.z * a.z + a.w * a.w)
+  end,
+  __mul = function (a, b)
+    if type(a) == "number" then
+      -- swap if a is a number (a * vector)
+      a, b = b, a
+    end
+
+    if type(b) == "number" then
+      return Vector4(a.x * b, a.y * b, a.z * b, a.w * b)
+    elseif istype(Vector4, b) then -- quaternion product, use a:dot(b) for the dot product
+      return QuaternionMultiplyInto(Vector4(), a, b)
+    else
+      error "Invalid operation."
+    end
+  end,
+  __div = function (a, b)
+    if type(b) == "number" then
+      return Vector4(a.x / b, a.y / b, a.z / b, a.w / b)
+    else
+      error "Invalid operation"
+    end
+  end,
+  __tostring = function (a)
+    return string.format("Vector4: (%g %g %g %g)", a.x, a.y, a.z, a.w)
+  end
+})
+
+ffi.metatype(Matrix, {
+  __index = matrix_methods,
+  __mul = function (a, b)
+    if istype(Matrix, b) then
+      return MatrixMultiplyInto(Matrix(), a, b)
+    elseif istype(Vector3, b) then
+      return Vector3TransformInto(Vector3(), b, a)
+    else
+      error "Invalid operation."
+    end
+  end,
+  __tostring = function (a)
+    return string.format("Matrix: (%g %g %g %g | %g %g %g %g | %g %g %g %g | %g %g %g %g)",
+      a.m0, a.m4, a.m8, a.m12, a.m1, a.m5, a.m9, a.m13, a.m2, a.m6, a.m10, a.m14, a.m3, a.m7, a.m11, a.m15)
+  end
+})
+
+rl.Vector4Pool = function(size)
+    return new_scratch_pool(Vector4, size or 256)
+end
+
+rl.MatrixPool = function(size)
+    return new_scratch_pool(Matrix, size or 64)
+end
 
 -- Easing functions
 function rl.EaseLinearNone(t, b, c, d)
@@ -1991,17 +2780,93 @@ rl.GetFileNameWithoutExt = function(fileName)
 	if name then return name else return fileName end
 end
 
-local _resource_data_cache = {}
-local function createLoadWrapper(loadFromMemoryFn)
+-- Loaded resources are tracked natively (src/resources.cpp), keyed by a pointer or id
+-- that every copy of the returned struct shares, so unloading any copy releases the
+-- source buffer. Whatever is still registered at exit is reported as a leak.
+--
+-- Images, waves and fonts are fully decoded by the *FromMemory loaders, their file
+-- bytes are freed right away. Music decodes while playing: loose files stream from
+-- disk, files inside archives keep their bytes pinned until UnloadMusicStream.
+--
+-- `./build.sh cook` packages runtime-ready siblings next to the sources (src/cook.cpp):
+-- a.png -> a.rtex, a.wav -> a.rwav, a.ttf -> a.<size>.rfnt. When one exists the
+-- loaders below read it instead, which skips the decode entirely.
+ffi.cdef[[
+bool ResourceRegister(int type, uint64_t key, const char *fileName, unsigned char *sourceData, int sourceSize);
+bool ResourceRelease(int type, uint64_t key);
+int ResourceCount(int type);
+int64_t ResourceSourceBytes();
+int ResourceReportLeaks();
+
+typedef struct TexturePayload {
+	const unsigned char *data;
+	int dataSize;
+	int width;
+	int height;
+	int format;
+	int mipmaps;
+	unsigned int flags;
+} TexturePayload;
+
+int TexturePayloadDataSize(int width, int height, int format, int mipmaps);
+bool TexturePayloadParse(const unsigned char *fileData, int fileSize, TexturePayload *payload);
+bool ExportTexturePayload(Image image, unsigned int flags, const char *fileName);
+Image LoadImageCooked(const char *fileName);
+Texture2D LoadTextureFromPayload(const TexturePayload *payload);
+Texture2D LoadTextureCooked(const char *fileName);
+
+Wave LoadWaveCooked(const char *fileName);
+Font LoadFontCooked(const char *fileName);
+Font LoadFontSdfFromMemory(const char *fileType, const unsigned char *fileData, int dataSize, int baseSize);
+]]
+
+local RESOURCE_IMAGE, RESOURCE_WAVE, RESOURCE_MUSIC, RESOURCE_FONT, RESOURCE_TEXTURE = 0, 1, 2, 3, 4
+
+local function pointer_key(ptr)
+	return ffi.cast("uintptr_t", ptr)
+end
+
+-- Font.texture.id is 0 without a GL context, the glyph array is unique per font
+local resource_keys = {
+	[RESOURCE_IMAGE] = function(image) return pointer_key(image.data) end,
+	[RESOURCE_WAVE] = function(wave) return pointer_key(wave.data) end,
+	[RESOURCE_MUSIC] = function(music) return pointer_key(music.stream.buffer) end,
+	[RESOURCE_FONT] = function(font) return pointer_key(font.glyphs) end,
+	[RESOURCE_TEXTURE] = function(texture) return texture.id end,
+}
+
+-- For resources that hold no source bytes, only tracked for leak reports
+local function registerResource(resourceType, resource, fileName)
+	local key = resource_keys[resourceType](resource)
+	if key ~= 0 then
+		ffi.C.ResourceRegister(resourceType, key, fileName, nil, 0)
+	end
+	return resource
+end
+
+local function cookedPath(fileName, suffix)
+	local path = fileName:gsub("%.[^./]*$", "") .. suffix
+	if path ~= fileName and ffi.C.VFSFileExists(path) then
+		return path
+	end
+	return nil
+end
+
+local function createLoadWrapper(resourceType, loadFromMemoryFn, keepSource)
+	local resource_key = resource_keys[resourceType]
 	return function(fileName, ...)
 		local data_size = ffi.new("int[1]")
-		local file_data = rl.LoadFileData(fileName, data_size)	
+		local file_data = rl.LoadFileData(fileName, data_size)
 		if file_data ~= nil and data_size[0] > 0 then
 			local file_ext = rl.GetFileExtension(fileName)
 			local resource = loadFromMemoryFn(file_ext, file_data, data_size[0], ...)
-			if resource then
-				_resource_data_cache[resource] = file_data
+			local key = resource_key(resource)
+			if key == 0 then
+				rl.UnloadFileData(file_data)
+			elseif keepSource then
+				ffi.C.ResourceRegister(resourceType, key, fileName, file_data, data_size[0])
 			else
+				ffi.C.ResourceRegister(resourceType, key, fileName, nil, 0)
 				rl.UnloadFileData(file_data)
 			end
 			return resource
@@ -2012,30 +2877,136 @@ local function createLoadWrapper(loadFromMemoryFn)
 	end
 end
 
-local function createUnloadWrapper(originalUnloadFn)
+local function createCookedLoadWrapper(resourceType, suffix, loadCookedFn, loadFn)
+	return function(fileName, ...)
+		local cooked = cookedPath(fileName, suffix)
+		if cooked then
+			return registerResource(resourceType, loadCookedFn(cooked), fileName)
+		end
+		return loadFn(fileName, ...)
+	end
+end
+
+-- The raylib function behind a wrapper, declared on the first call so wrapping a lazy
+-- group's loaders at startup leaves the group undeclared until the game uses it
+local function nativeFunction(name)
+	local fn
+	return function(...)
+		if not fn then
+			if pending_functions[name] == nil and #lazy_blocks > 0 then
+				scan_lazy_blocks()
+			end
+			declare_pending({ name })
+			fn = raylib[name]
+		end
+		return fn(...)
+	end
+end
+
+local function createUnloadWrapper(resourceType, originalUnloadFn)
+	local resource_key = resource_keys[resourceType]
 	return function(resource)
 		if resource then
-			if _resource_data_cache[resource] then
-				rl.UnloadFileData(_resource_data_cache[resource])
-				_resource_data_cache[resource] = nil
-			end
+			ffi.C.ResourceRelease(resourceType, resource_key(resource))
 			originalUnloadFn(resource)
 		end
 	end
 end
 
-rl.LoadMusicStream = createLoadWrapper(rl.LoadMusicStreamFromMemory)
-rl.UnloadMusicStream = createUnloadWrapper(raylib.UnloadMusicStream)
+-- raylib's own loader streams from a real file, only archived music needs the pinned buffer
+local raylib_LoadMusicStream = nativeFunction("LoadMusicStream")
+local loadPinnedMusicStream = createLoadWrapper(RESOURCE_MUSIC, nativeFunction("LoadMusicStreamFromMemory"), true)
+local disk_path = ffi.new("char[?]", 4096)
+rl.LoadMusicStream = function(fileName)
+	if ffi.C.VFSGetDiskPath(fileName, disk_path, 4096) then
+		return registerResource(RESOURCE_MUSIC, raylib_LoadMusicStream(disk_path), fileName)
+	end
+	return loadPinnedMusicStream(fileName)
+end
+rl.UnloadMusicStream = createUnloadWrapper(RESOURCE_MUSIC, nativeFunction("UnloadMusicStream"))
+
+rl.LoadWave = createCookedLoadWrapper(RESOURCE_WAVE, ".rwav", ffi.C.LoadWaveCooked,
+	createLoadWrapper(RESOURCE_WAVE, nativeFunction("LoadWaveFromMemory")))
+rl.UnloadWave = createUnloadWrapper(RESOURCE_WAVE, nativeFunction("UnloadWave"))
+
+-- Images are for CPU edits: a cooked file gives its straight-alpha base level, the same
+-- pixels as the source; premultiplied ones fall back to decoding the source
+local loadImageSource = createLoadWrapper(RESOURCE_IMAGE, rl.LoadImageFromMemory)
+rl.LoadImage = function(fileName)
+	local cooked = cookedPath(fileName, ".rtex")
+	if cooked then
+		local image = ffi.C.LoadImageCooked(cooked)
+		if image.data ~= nil then
+			return registerResource(RESOURCE_IMAGE, image, fileName)
+		end
+	end
+	return loadImageSource(fileName)
+end
+rl.LoadImageAnim = createLoadWrapper(RESOURCE_IMAGE, rl.LoadImageAnimFromMemory)
+rl.UnloadImage = createUnloadWrapper(RESOURCE_IMAGE, rl.UnloadImage)
+
+-- Fonts are cooked per size with the default character set only
+local loadFontFromMemory = createLoadWrapper(RESOURCE_FONT, rl.LoadFontFromMemory)
+rl.LoadFontEx = function(fileName, fontSize, codepoints, codepointCount)
+	local cooked = codepoints == nil and cookedPath(fileName, "." .. fontSize .. ".rfnt")
+	if cooked then
+		return registerResource(RESOURCE_FONT, ffi.C.LoadFontCooked(cooked), fileName)
+	end
+	return loadFontFromMemory(fileName, fontSize, codepoints, codepointCount)
+end
+
+-- raylib's LoadFont rasterizes TTF/OTF at 32 px
+rl.LoadFont = createCookedLoadWrapper(RESOURCE_FONT, ".32.rfnt", ffi.C.LoadFontCooked, rl.LoadFont)
 
-rl.LoadWave = createLoadWrapper(rl.LoadWaveFromMemory)
-rl.UnloadWave = createUnloadWrapper(raylib.UnloadWave)
+---Signed distance field font, one atlas for every size; draw it with the text module.
+---Cooked builds load <name>.sdf.rfnt, dev builds render the fields from the TTF/OTF at
+---baseSize (default 32) on load.
+local loadFontSdf = createCookedLoadWrapper(RESOURCE_FONT, ".sdf.rfnt", ffi.C.LoadFontCooked,
+	createLoadWrapper(RESOURCE_FONT, ffi.C.LoadFontSdfFromMemory))
+rl.LoadFontSdf = function(fileName, baseSize)
+	return loadFontSdf(fileName, baseSize or 0)
+end
+rl.UnloadFont = createUnloadWrapper(RESOURCE_FONT, rl.UnloadFont)
 
-rl.LoadImage = createLoadWrapper(rl.LoadImageFromMemory)
-rl.LoadImageAnim = createLoadWrapper(rl.LoadImageAnimFromMemory)
-rl.UnloadImage = createUnloadWrapper(raylib.UnloadImage)
+rl.TEXTURE_PAYLOAD_PREMULTIPLIED = 1
+rl.ParseTexturePayload = function(data, size)
+	local payload = ffi.new("TexturePayload")
+	if ffi.C.TexturePayloadParse(data, size, payload) then
+		return payload
+	end
+	return nil
+end
+rl.ExportTexturePayload = ffi.C.ExportTexturePayload
 
-rl.LoadFontEx = createLoadWrapper(rl.LoadFontFromMemory)
-rl.UnloadFont = createUnloadWrapper(raylib.UnloadFont)
+---Upload a cooked texture from memory, e.g. data from sched.load(); the data can be freed afterwards
+rl.LoadTextureFromPayload = function(data, size, fileName)
+	local payload = rl.ParseTexturePayload(data, size)
+	if payload == nil then
+		return ffi.new("Texture2D")
+	end
+	return registerResource(RESOURCE_TEXTURE, ffi.C.LoadTextureFromPayload(payload), fileName or "<memory>")
+end
+
+-- Other textures decode inside raylib, they are registered without source data for leak reports only
+local raylib_LoadTexture = rl.LoadTexture
+rl.LoadTexture = function(fileName)
+	local cooked = rl.GetFileExtension(fileName) == ".rtex" and fileName or cookedPath(fileName, ".rtex")
+	if cooked then
+		return registerResource(RESOURCE_TEXTURE, ffi.C.LoadTextureCooked(cooked), fileName)
+	end
+	return registerResource(RESOURCE_TEXTURE, raylib_LoadTexture(fileName), fileName)
+end
+rl.UnloadTexture = createUnloadWrapper(RESOURCE_TEXTURE, rl.UnloadTexture)
+
+---Live resources loaded through the wrappers: count and the source bytes they still hold
+rl.GetResourceStats = function()
+	return ffi.C.ResourceCount(-1), tonumber(ffi.C.ResourceSourceBytes())
+end
+
+---Log every resource loaded through the wrappers that has not been unloaded yet
+rl.ReportResourceLeaks = function()
+	return ffi.C.ResourceReportLeaks()
+end
 
 local __require = require
 function require(modname)
@@ -2049,7 +3020,7 @@ function require(modname)
     local file_path = "lua/" .. modname:gsub("%.", "/") .. ".lua"
     local content = rl.LoadFileText(file_path)
 
-    if not content then
+    if content == nil then
         error("module '" .. modname .. "' not found in path '" .. file_path .. "'")
     end
     
@@ -0,0 +1,74 @@
+-- multi-buffered render batch so flushes stop rewriting a buffer the GPU is still reading
+--
+-- rl.InitWindow(800, 450, "game")
+-- renderbatch.init()                  -- or renderbatch.init({ buffers = 4, elements = 16384, auto = false })
+-- while not rl.WindowShouldClose() do
+--     rl.BeginDrawing() ... rl.EndDrawing()
+--     renderbatch.frame()             -- counts the frame's flushes, resizes between frames
+-- end
+-- renderbatch.stats()                 -- { flushes, peakFlushes, peakVertices, buffers, bufferElements, ... }
+--
+-- rl.CloseWindow() gives rlgl its default batch back first.
+
+local ffi = require("ffi")
+
+ffi.cdef[[
+typedef struct RenderBatchStats {
+    int buffers;
+    int bufferElements;
+    int flushes;
+    int peakFlushes;
+    int peakVertices;
+    int overflows;
+    int resizes;
+    int frames;
+} RenderBatchStats;
+
+bool RenderBatchesInit(int buffers, int bufferElements);
+void RenderBatchesSetLimits(int minElements, int maxElements, int maxBuffers, bool autoSize);
+void RenderBatchesFrame();
+void RenderBatchesGetStats(RenderBatchStats *stats);
+void UnloadRenderBatches();
+]]
+
+local C = ffi.C
+
+local renderbatch = {}
+
+local close_window = nil
+
+---Install the batch, needs a window. opts: buffers (default 3), elements (quads
+---per buffer, default 8192), auto (resize from measured use, default true),
+---minElements, maxElements, maxBuffers (bounds for automatic sizing)
+function renderbatch.init(opts)
+    opts = opts or {}
+    C.RenderBatchesSetLimits(opts.minElements or 0, opts.maxElements or 0, opts.maxBuffers or 0, opts.auto ~= false)
+    if not C.RenderBatchesInit(opts.buffers or 0, opts.elements or 0) then
+        return false
+    end
+
+    if close_window == nil then
+        close_window = rl.CloseWindow
+        rl.CloseWindow = function()
+            C.UnloadRenderBatches()
+            close_window()
+        end
+    end
+    return true
+end
+
+renderbatch.frame = C.RenderBatchesFrame
+
+---Fill `out` (a RenderBatchStats) or a new one with the counters of the last frame
+function renderbatch.stats(out)
+    out = out or ffi.new("RenderBatchStats")
+    C.RenderBatchesGetStats(out)
+    return out
+end
+
+---Back to rlgl's default batch
+function renderbatch.unload()
+    C.UnloadRenderBatches()
+end
+
+return renderbatch
@@ -0,0 +1,186 @@
+-- coroutine scheduler driven by the frame loop
+--
+-- sched.spawn(function()
+--     sched.sleep(0.5)                               -- wake up after 0.5s
+--     sched.frame()                                  -- wake up next frame
+--     local data, size = sched.load("assets/a.png")  -- load on the background thread
+--     rl.UnloadFileData(data)
+-- end)
+--
+-- while not rl.WindowShouldClose() do
+--     sched.update()
+--     ...
+-- end
+
+local ffi = require("ffi")
+local queue = require("queue")
+
+ffi.cdef[[
+typedef struct JobResult {
+    int token;
+    int status;
+    unsigned char *data;
+    int dataSize;
+} JobResult;
+
+void SchedulerSleep(int token, double wakeTime);
+int SchedulerPollTimers(double now, int *tokens, int maxTokens);
+int SchedulerTimerCount();
+
+void SchedulerLoadFile(int token, const char *fileName);
+void SchedulerComplete(int token, int status);
+]]
+
+local C = ffi.C
+local co_create, co_resume, co_running, co_status, co_yield =
+    coroutine.create, coroutine.resume, coroutine.running, coroutine.status, coroutine.yield
+
+local sched = {}
+
+local POLL_BATCH = 256
+
+local jobs = queue.find("scheduler.jobs", "JobResult")
+local job_result = ffi.new("JobResult")
+local due_tokens = ffi.new("int[?]", POLL_BATCH)
+
+local waiting = {}      -- token -> coroutine
+local reserved = {}     -- sched.token() tokens not completed yet
+local completed = {}    -- sched.token() tokens completed before sched.wait -> status
+local frame_waiters = {}
+local next_frame_waiters = {}
+local next_token = 0
+local now = 0
+
+local function report(co, ok, err)
+    if not ok then
+        rl.TraceLog(rl.LOG_ERROR, "SCHED: %s", debug.traceback(co, tostring(err)))
+    end
+end
+
+local function resume(co, ...)
+    if co_status(co) == "suspended" then
+        report(co, co_resume(co, ...))
+    end
+end
+
+local function current()
+    local co = co_running()
+    if not co then
+        error("scheduler waits must be called from a spawned coroutine", 3)
+    end
+    return co
+end
+
+local function new_token(co)
+    next_token = next_token + 1
+    waiting[next_token] = co
+    return next_token
+end
+
+---Run `fn(...)` as a scheduled coroutine, it starts immediately
+function sched.spawn(fn, ...)
+    local co = co_create(fn)
+    resume(co, ...)
+    return co
+end
+
+---Suspend the current coroutine for `seconds`, measured from the last update
+function sched.sleep(seconds)
+    local token = new_token(current())
+    C.SchedulerSleep(token, now + seconds)
+    return co_yield()
+end
+
+---Suspend the current coroutine until the next `sched.update`
+function sched.frame()
+    next_frame_waiters[#next_frame_waiters + 1] = current()
+    return co_yield()
+end
+
+---Load a file on the background thread, returns data, size (nil on failure)
+function sched.load(fileName)
+    local token = new_token(current())
+    C.SchedulerLoadFile(token, fileName)
+    local data, size = co_yield()
+    if type(data) ~= "cdata" then
+        return nil
+    end
+    return data, size
+end
+
+---Reserve a token that native code completes through SchedulerComplete
+function sched.token()
+    next_token = next_token + 1
+    reserved[next_token] = true
+    return next_token
+end
+
+---Suspend the current coroutine until `token` completes, returns ok, status; returns
+---at once if it already has
+function sched.wait(token)
+    local status = completed[token]
+    if status then
+        completed[token] = nil
+        return status == 0, status
+    end
+    if not reserved[token] then
+        error("sched.wait: unknown or already waited token " .. tostring(token), 2)
+    end
+    waiting[token] = current()
+    return co_yield()
+end
+
+---Resume everything that became due, call once per frame
+function sched.update(time)
+    now = time or rl.GetTime()
+
+    -- frame waiters queued during this update run next frame
+    frame_waiters, next_frame_waiters = next_frame_waiters, frame_waiters
+    for i = 1, #frame_waiters do
+        local co = frame_waiters[i]
+        frame_waiters[i] = nil
+        resume(co)
+    end
+
+    repeat
+        local count = C.SchedulerPollTimers(now, due_tokens, POLL_BATCH)
+        for i = 0, count - 1 do
+            local token = due_tokens[i]
+            local co = waiting[token]
+            waiting[token] = nil
+            if co then resume(co) end
+        end
+    until count < POLL_BATCH
+
+    while jobs:pop(job_result) do
+        local token, status = job_result.token, job_result.status
+        local co = waiting[token]
+        waiting[token] = nil
+
+        if job_result.data ~= nil then
+            if co then
+                resume(co, job_result.data, job_result.dataSize)
+            else
+                rl.UnloadFileData(job_result.data)
+            end
+        elseif co then
+            reserved[token] = nil
+            resume(co, status == 0, status)
+        elseif reserved[token] then
+            reserved[token] = nil
+            completed[token] = status
+        end
+    end
+end
+
+---Time passed to the last `sched.update`
+function sched.time()
+    return now
+end
+
+---Number of coroutines waiting on timers
+function sched.sleeping()
+    return C.SchedulerTimerCount()
+end
+
+return sched
@@ -0,0 +1,154 @@
+-- structure-of-arrays vector buffers with batched native kernels
+--
+-- local pos = soa.new(100000, 2)    -- capacity, components (2 or 3)
+-- local vel = soa.new(100000, 2)
+-- pos:resize(n); vel:resize(n)
+-- pos:axpy(dt, vel)                 -- pos += dt * vel, one FFI call for all n
+-- pos.x[i], pos.y[i]                -- direct float access, 0-based
+--
+-- Buffers are freed by the garbage collector or explicitly with :destroy().
+
+local ffi = require("ffi")
+
+ffi.cdef[[
+typedef struct VectorBuffer {
+    float *x;
+    float *y;
+    float *z;
+    int count;
+    int capacity;
+    int components;
+} VectorBuffer;
+
+VectorBuffer *VectorBufferCreate(int capacity, int components);
+void VectorBufferDestroy(VectorBuffer *buffer);
+bool VectorBufferResize(VectorBuffer *buffer, int count);
+
+void VectorBufferFill(VectorBuffer *buffer, Vector3 value);
+void VectorBufferScale(VectorBuffer *buffer, float scale);
+void VectorBufferAxpy(VectorBuffer *y, float a, const VectorBuffer *x);
+void VectorBufferNormalize(VectorBuffer *buffer);
+void VectorBufferTransform(VectorBuffer *out, const VectorBuffer *in, Matrix mat);
+
+void VectorBufferDistances(const VectorBuffer *buffer, Vector3 point, float *distances);
+int VectorBufferWithinRadius(const VectorBuffer *buffer, Vector3 point, float radius, int *indices, int maxIndices);
+int VectorBufferNearest(const VectorBuffer *buffer, Vector3 point);
+]]
+
+local C = ffi.C
+
+local soa = {}
+
+local Vector3 = ffi.typeof("Vector3")
+local point = Vector3()
+
+-- accepts Vector2 or Vector3, the native side always takes a Vector3
+local function as_point(v)
+    point.x, point.y = v.x, v.y
+    point.z = ffi.istype(Vector3, v) and v.z or 0
+    return point
+end
+
+local methods = {}
+
+function methods:resize(count)
+    return C.VectorBufferResize(self, count)
+end
+
+---Append one vector, growing the buffer when full; returns its index, or nil when it cannot grow
+function methods:push(x, y, z)
+    local i = self.count
+    if i == self.capacity then
+        -- the native side at least doubles the capacity, so pushes stay amortized O(1)
+        if not C.VectorBufferResize(self, i + 1) then
+            return nil
+        end
+    else
+        self.count = i + 1
+    end
+    self.x[i], self.y[i] = x, y
+    if self.z ~= nil then
+        self.z[i] = z or 0
+    end
+    return i
+end
+
+---Remove element i by moving the last element into its slot (order is not kept)
+function methods:remove(i)
+    if self.count == 0 then
+        return
+    end
+    local last = self.count - 1
+    self.x[i], self.y[i] = self.x[last], self.y[last]
+    self.x[last], self.y[last] = 0, 0
+    if self.z ~= nil then
+        self.z[i], self.z[last] = self.z[last], 0
+    end
+    self.count = last
+end
+
+function methods:set(i, x, y, z)
+    self.x[i], self.y[i] = x, y
+    if self.z ~= nil then
+        self.z[i] = z or 0
+    end
+end
+
+---Copy element i into `out` (a Vector2 or Vector3)
+function methods:get(i, out)
+    out.x, out.y = self.x[i], self.y[i]
+    if self.z ~= nil and ffi.istype(Vector3, out) then
+        out.z = self.z[i]
+    end
+    return out
+end
+
+function methods:fill(v)
+    C.VectorBufferFill(self, as_point(v))
+end
+
+methods.scale = C.VectorBufferScale
+methods.axpy = C.VectorBufferAxpy
+methods.normalize = C.VectorBufferNormalize
+
+---Transform every vector as a point by `mat`, into `out` (defaults to self)
+function methods:transform(mat, out)
+    C.VectorBufferTransform(out or self, self, mat)
+end
+
+---Write the distance of every element to `p` into a float array of at least count entries
+function methods:distances(p, out)
+    out = out or ffi.new("float[?]", self.count)
+    C.VectorBufferDistances(self, as_point(p), out)
+    return out
+end
+
+---Fill the int array `indices` with elements within `radius` of `p`, returns how many
+function methods:within(p, radius, indices, maxIndices)
+    return C.VectorBufferWithinRadius(self, as_point(p), radius, indices, maxIndices)
+end
+
+---Index of the element closest to `p`, or -1 when the buffer is empty
+function methods:nearest(p)
+    return C.VectorBufferNearest(self, as_point(p))
+end
+
+function methods:destroy()
+    C.VectorBufferDestroy(ffi.gc(self, nil))
+end
+
+ffi.metatype("VectorBuffer", {
+    __index = methods,
+    __len = function(self) return self.count end,
+})
+
+---Create a buffer with room for `capacity` vectors of 2 or 3 components (default 2)
+function soa.new(capacity, components)
+    local buffer = C.VectorBufferCreate(capacity or 0, components or 2)
+    if buffer == nil then
+        return nil
+    end
+    return ffi.gc(buffer, C.VectorBufferDestroy)
+end
+
+return soa
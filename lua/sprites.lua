@@ -0,0 +1,185 @@
+-- native sprite batcher: one FFI call per frame instead of one DrawTexturePro per sprite
+--
+-- local batch = sprites.new(10000)
+-- local list = sprites.buffer(10000)          -- Sprite[?], fill it every frame
+-- list[0]:set(texture, source, dest, origin, rotation, tint, layer)
+-- batch:submit(list, count)                   -- sort by layer/shader/texture, build, draw
+-- batch:stats()                               -- { sprites, runs, drawCalls, sortSkipped, buildMs }
+--
+-- Layers draw in ascending order; within a layer sprites are grouped by shader and
+-- texture, so overlapping sprites of different textures need different layers.
+
+local ffi = require("ffi")
+
+ffi.cdef[[
+typedef struct Sprite {
+    Texture2D texture;
+    Rectangle source;
+    Rectangle dest;
+    Vector2 origin;
+    float rotation;
+    Color tint;
+    int layer;
+    int shader;
+} Sprite;
+
+typedef struct SpriteRun {
+    int first;
+    int count;
+    unsigned int texture;
+    int shader;
+} SpriteRun;
+
+typedef struct SpriteBatchData {
+    const float *positions;
+    const float *texcoords;
+    const unsigned int *colors;
+    const SpriteRun *runs;
+    int quadCount;
+    int runCount;
+} SpriteBatchData;
+
+typedef struct SpriteBatchStats {
+    int sprites;
+    int runs;
+    int drawCalls;
+    bool sortSkipped;
+    float buildMs;
+} SpriteBatchStats;
+
+typedef struct SpriteBatch SpriteBatch;
+
+SpriteBatch *SpriteBatchCreate(int capacity);
+void SpriteBatchDestroy(SpriteBatch *batch);
+bool SpriteBatchSetShader(SpriteBatch *batch, int slot, Shader shader);
+
+int SpriteBatchBuild(SpriteBatch *batch, const Sprite *sprites, int count);
+void SpriteBatchDraw(SpriteBatch *batch);
+void SpriteBatchSubmit(SpriteBatch *batch, const Sprite *sprites, int count);
+
+void SpriteBatchGetData(const SpriteBatch *batch, SpriteBatchData *data);
+void SpriteBatchGetStats(const SpriteBatch *batch, SpriteBatchStats *stats);
+]]
+
+local C = ffi.C
+
+local sprites = {
+    MAX_SHADERS = 16,
+}
+
+local sprite_methods = {}
+
+---Fill a sprite in place, arguments as DrawTexturePro plus layer and shader slot
+function sprite_methods:set(texture, source, dest, origin, rotation, tint, layer, shader)
+    self.texture = texture
+    self.source = source
+    self.dest = dest
+    self.origin = origin
+    self.rotation = rotation or 0
+    self.tint = tint
+    self.layer = layer or 0
+    self.shader = shader or 0
+    return self
+end
+
+ffi.metatype("Sprite", { __index = sprite_methods })
+
+local batch_methods = {}
+
+batch_methods.build = C.SpriteBatchBuild
+batch_methods.draw = C.SpriteBatchDraw
+batch_methods.submit = C.SpriteBatchSubmit
+
+---Register a shader for sprites with `shader = slot` (1..15)
+function batch_methods:setShader(slot, shader)
+    return C.SpriteBatchSetShader(self, slot, shader)
+end
+
+---Counters of the last build/draw, pass a table to reuse it
+function batch_methods:stats(out)
+    local stats = ffi.new("SpriteBatchStats")
+    C.SpriteBatchGetStats(self, stats)
+    out = out or {}
+    out.sprites, out.runs, out.drawCalls = stats.sprites, stats.runs, stats.drawCalls
+    out.sortSkipped, out.buildMs = stats.sortSkipped, stats.buildMs
+    return out
+end
+
+---Vertex data of the last build (positions/texcoords: 8 floats per quad, colors: 4 per quad)
+function batch_methods:data()
+    local data = ffi.new("SpriteBatchData")
+    C.SpriteBatchGetData(self, data)
+    return data
+end
+
+function batch_methods:destroy()
+    C.SpriteBatchDestroy(ffi.gc(self, nil))
+end
+
+ffi.metatype("SpriteBatch", { __index = batch_methods })
+
+---Create a batch with room for `capacity` sprites (it grows when more are submitted)
+function sprites.new(capacity)
+    return ffi.gc(C.SpriteBatchCreate(capacity or 1024), C.SpriteBatchDestroy)
+end
+
+---Zero-initialised Sprite[size] array
+function sprites.buffer(size)
+    return ffi.new("Sprite[?]", size)
+end
+
+---Time SpriteBatchBuild on `count` random sprites over `textures` fake textures.
+---Needs no window. Returns ns per sprite for in-order and shuffled input.
+function sprites.benchmark(count, textures, iterations)
+    count = count or 10000
+    textures = textures or 16
+    iterations = iterations or 100
+
+    local list = sprites.buffer(count)
+    local random = math.random
+    for i = 0, count - 1 do
+        local s = list[i]
+        s.texture.id = random(1, textures)
+        s.texture.width, s.texture.height = 256, 256
+        s.source.x, s.source.y, s.source.width, s.source.height = random(0, 224), random(0, 224), 32, 32
+        s.dest.x, s.dest.y, s.dest.width, s.dest.height = random() * 1920, random() * 1080, 32, 32
+        s.origin.x, s.origin.y = 16, 16
+        s.rotation = (i % 4 == 0) and random() * 360 or 0
+        s.tint.r, s.tint.g, s.tint.b, s.tint.a = 255, 255, 255, 255
+        s.layer = random(0, 3)
+    end
+
+    local batch = sprites.new(count)
+    local function time_build()
+        batch:build(list, count)
+        local start = os.clock()
+        for _ = 1, iterations do
+            batch:build(list, count)
+        end
+        return (os.clock() - start) / (iterations * count) * 1e9
+    end
+
+    local shuffled = time_build()
+    local stats = batch:stats()
+
+    -- same sprites already in layer/shader/texture order
+    local order = {}
+    for i = 0, count - 1 do
+        order[i + 1] = ffi.new("Sprite", list[i])
+    end
+    table.sort(order, function(a, b)
+        if a.layer ~= b.layer then return a.layer < b.layer end
+        return a.texture.id < b.texture.id
+    end)
+    for i = 0, count - 1 do
+        list[i] = order[i + 1]
+    end
+    local sorted = time_build()
+
+    rl.TraceLog(rl.LOG_INFO, "SPRITES: %d sprites, %d textures: %.1f ns/sprite shuffled, %.1f ns/sprite in order, %d runs",
+        ffi.new("int", count), ffi.new("int", textures), shuffled, sorted, ffi.new("int", stats.runs))
+    batch:destroy()
+    return { shuffled = shuffled, sorted = sorted, runs = stats.runs }
+end
+
+return sprites
@@ -0,0 +1,250 @@
+-- cached text layout: a label is laid out once, then every label of the frame goes out as one batch
+--
+-- text.draw("Score: 10", 190, 200, 20, rl.LIGHTGRAY)         -- same arguments and pixels as rl.DrawText
+-- text.drawEx(font, str, position, size, spacing, tint, layer) -- as rl.DrawTextEx, plus a sprite layer
+-- text.measure(str, size), text.measureEx(font, str, size, spacing)
+-- text.flush()                                                -- once per frame, before rl.EndDrawing
+--
+-- local ui = text.loadSdf("assets/fonts/ui.ttf")              -- signed distance field font
+-- text.drawEx(ui, "Title", position, 48, 0, rl.WHITE)          -- one atlas, sharp at every size
+--
+-- Queued labels are drawn by text.flush, on top of whatever raylib drew before it; use
+-- layers to order labels among themselves. Drawing the same string again, anywhere,
+-- reuses its layout. text.new() gives a separate cache to submit to your own sprite batch.
+-- Unload fonts with text.unload(font), or call text.clear() after unloading one.
+
+local ffi = require("ffi")
+local sprites = require("sprites")
+
+ffi.cdef[[
+typedef struct TextCacheStats {
+    int layouts;
+    int labels;
+    int glyphs;
+    int hits;
+    int misses;
+    int evicted;
+    float layoutMs;
+} TextCacheStats;
+
+typedef struct TextCache TextCache;
+
+TextCache *TextCacheCreate(int maxLayouts);
+void TextCacheDestroy(TextCache *cache);
+void TextCacheClear(TextCache *cache);
+void TextCacheSetLineSpacing(TextCache *cache, int spacing);
+
+Vector2 TextCacheAdd(TextCache *cache, Font font, const char *text, Vector2 position, float fontSize, float spacing,
+                     Color tint, int layer, int shader);
+Vector2 TextCacheMeasure(TextCache *cache, Font font, const char *text, float fontSize, float spacing);
+
+int TextCacheGetSprites(const TextCache *cache, const Sprite **sprites);
+void TextCacheSubmit(TextCache *cache, SpriteBatch *batch);
+void TextCacheGetStats(const TextCache *cache, TextCacheStats *stats);
+
+Shader LoadFontSdfShader(void);
+]]
+
+local C = ffi.C
+
+local text = {
+    SDF_SHADER_SLOT = 1,   -- sprite batch slot of the SDF shader in the default batch
+}
+
+local cache_methods = {}
+
+cache_methods.clear = C.TextCacheClear
+cache_methods.lineSpacing = C.TextCacheSetLineSpacing
+cache_methods.measure = C.TextCacheMeasure
+
+---Queue a label like rl.DrawTextEx, returns its size; `shader` is a slot of the batch it
+---is submitted to (SDF fonts need one holding text.sdfShader())
+function cache_methods:add(font, str, position, size, spacing, tint, layer, shader)
+    return C.TextCacheAdd(self, font, str, position, size, spacing, tint, layer or 0, shader or 0)
+end
+
+---Draw the queued labels through a sprite batch and start the next frame
+function cache_methods:submit(batch)
+    C.TextCacheSubmit(self, batch)
+end
+
+---Counters since the last submit (layouts and evicted are totals), pass a table to reuse it
+function cache_methods:stats(out)
+    local stats = ffi.new("TextCacheStats")
+    C.TextCacheGetStats(self, stats)
+    out = out or {}
+    out.layouts, out.labels, out.glyphs = stats.layouts, stats.labels, stats.glyphs
+    out.hits, out.misses, out.evicted, out.layoutMs = stats.hits, stats.misses, stats.evicted, stats.layoutMs
+    return out
+end
+
+function cache_methods:destroy()
+    C.TextCacheDestroy(ffi.gc(self, nil))
+end
+
+ffi.metatype("TextCache", { __index = cache_methods })
+
+---Cache of up to `maxLayouts` laid out strings (default 1024), least recently drawn go first
+function text.new(maxLayouts)
+    return ffi.gc(C.TextCacheCreate(maxLayouts or 0), C.TextCacheDestroy)
+end
+
+---Shader for SDF fonts, needs a window
+text.sdfShader = C.LoadFontSdfShader
+
+-- default cache and batch behind text.draw / text.flush
+local cache, batch
+local default_font
+local position = ffi.new("Vector2")
+
+-- SDF fonts by glyph array, and the shader the default batch draws them with. A font
+-- unloaded with rl.UnloadFont can leave its entry behind and a new font may get the
+-- same glyph address, so the texture and base size have to match too.
+local sdf_fonts = {}
+local sdf_shader
+
+local function font_key(font)
+    return tonumber(ffi.cast("uintptr_t", font.glyphs))
+end
+
+local function is_sdf(font)
+    local entry = sdf_fonts[font_key(font)]
+    return entry ~= nil and entry.texture == font.texture.id and entry.baseSize == font.baseSize
+end
+
+local function default_cache()
+    if not cache then
+        cache = text.new()
+        batch = sprites.new(4096)
+    end
+    return cache
+end
+
+local function get_default_font()
+    if not default_font or default_font.texture.id == 0 then
+        default_font = rl.GetFontDefault()
+    end
+    return default_font
+end
+
+---Queue a label in the default font, arguments as rl.DrawText
+function text.draw(str, x, y, size, color, layer)
+    -- rl.DrawText: at least 10 px, integer spacing of one default font pixel
+    size = math.max(size, 10)
+    position.x, position.y = x, y
+    return default_cache():add(get_default_font(), str, position, size, math.floor(size / 10), color, layer)
+end
+
+---Queue a label like rl.DrawTextEx; SDF fonts from text.loadSdf take the SDF shader
+function text.drawEx(font, str, pos, size, spacing, tint, layer)
+    local labels = default_cache()
+    local shader = 0
+    if is_sdf(font) then
+        if not sdf_shader and rl.IsWindowReady() then
+            sdf_shader = text.sdfShader()
+            batch:setShader(text.SDF_SHADER_SLOT, sdf_shader)
+        end
+        shader = text.SDF_SHADER_SLOT
+    end
+    return labels:add(font, str, pos, size, spacing, tint, layer, shader)
+end
+
+---Load a signed distance field font (rl.LoadFontSdf: cooked .sdf.rfnt, or rendered from
+---the TTF/OTF at baseSize, default 32) for text.drawEx. Below about half the base size
+---thin strokes start to drop out, small print reads better from a bitmap size.
+function text.loadSdf(fileName, baseSize)
+    local font = rl.LoadFontSdf(fileName, baseSize)
+    if font and font.glyphs ~= nil then
+        sdf_fonts[font_key(font)] = { texture = font.texture.id, baseSize = font.baseSize }
+    end
+    return font
+end
+
+---Unload a font drawn through the text module and forget its layouts
+function text.unload(font)
+    sdf_fonts[font_key(font)] = nil
+    text.clear()
+    rl.UnloadFont(font)
+end
+
+---Size of a label in the default font, as rl.MeasureText (a number) but cached
+function text.measure(str, size)
+    size = math.max(size, 10)
+    return math.floor(default_cache():measure(get_default_font(), str, size, math.floor(size / 10)).x)
+end
+
+---Size of a label like rl.MeasureTextEx, cached
+function text.measureEx(font, str, size, spacing)
+    return default_cache():measure(font, str, size, spacing)
+end
+
+---Draw every label queued this frame, call it before rl.EndDrawing
+function text.flush()
+    if cache then
+        cache:submit(batch)
+    end
+end
+
+---Line gap for multi-line labels, sets raylib's too
+function text.lineSpacing(spacing)
+    rl.SetTextLineSpacing(spacing)
+    default_cache():lineSpacing(spacing)
+end
+
+---Forget every layout, after unloading a font
+function text.clear()
+    if cache then
+        cache:clear()
+    end
+end
+
+---Counters of the default cache, pass a table to reuse it
+function text.stats(out)
+    return default_cache():stats(out)
+end
+
+---Time `count` labels (default 500) drawn every frame: text.draw + text.flush against a
+---loop of rl.DrawText. Needs a window for raylib's default font, without one both sides
+---are empty. Call it between frames, nothing is presented. Returns ms per frame for both.
+function text.benchmark(count, iterations)
+    count = count or 500
+    iterations = iterations or 120
+
+    local window = rl.IsWindowReady()
+    local labels = {}
+    for i = 1, count do
+        labels[i] = "Label " .. i .. ": value " .. i * 37
+    end
+
+    local function frame(draw)
+        for i = 1, count do
+            draw(labels[i], (i - 1) % 10 * 80, math.floor((i - 1) / 10) * 12, 10, rl.WHITE)
+        end
+    end
+
+    frame(text.draw)
+    text.flush()
+    local start = os.clock()
+    for _ = 1, iterations do
+        frame(text.draw)
+        text.flush()
+    end
+    local cached = (os.clock() - start) / iterations * 1000
+    local stats = batch:stats()
+
+    local raylib = 0
+    if window then
+        start = os.clock()
+        for _ = 1, iterations do
+            frame(rl.DrawText)
+            rl.rlDrawRenderBatchActive()
+        end
+        raylib = (os.clock() - start) / iterations * 1000
+    end
+
+    rl.TraceLog(rl.LOG_INFO, "TEXT: %d labels: %.3f ms cached (%d glyphs, %d draw calls), %.3f ms with rl.DrawText per frame",
+        ffi.new("int", count), cached, ffi.new("int", stats.sprites), ffi.new("int", stats.drawCalls), raylib)
+    return { cached = cached, raylib = raylib }
+end
+
+return text
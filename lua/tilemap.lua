@@ -0,0 +1,177 @@
+-- retained tile map layers: chunked static geometry, one draw call per visible chunk
+--
+-- local map = tilemap.new(1000, 1000, 16, 16)        -- tiles, tile size in world units
+-- map:tileset(texture, 16, 16)                       -- tile size in pixels (+ spacing, region)
+-- map:set(x, y, 3)                                   -- 0-based cells, tile ids from 1, 0 is empty
+-- map:fill(0, 0, 1000, 1, 7)
+-- map.tiles[y * map.width + x] = id                  -- bulk writes, then map:dirty(x, y, w, h)
+-- map.position, map.tint                             -- moving a layer rebuilds nothing
+-- map:draw(camera)                                   -- inside BeginMode2D, Camera2D or a world Rectangle
+--
+-- A chunk's quads are rebuilt only after one of its tiles changed, when it is next drawn.
+
+local ffi = require("ffi")
+local culling = require("culling")
+
+ffi.cdef[[
+typedef struct TileMap {
+    uint16_t *tiles;
+    int width;
+    int height;
+    float tileWidth;
+    float tileHeight;
+    int chunkSize;
+    Vector2 position;
+    Color tint;
+} TileMap;
+
+typedef struct TileMapStats {
+    int chunks;
+    int visibleChunks;
+    int rebuiltChunks;
+    int drawCalls;
+    int quads;
+    float buildMs;
+} TileMapStats;
+
+TileMap *TileMapCreate(int width, int height, float tileWidth, float tileHeight, int chunkSize);
+void TileMapDestroy(TileMap *map);
+void TileMapSetTileset(TileMap *map, Texture2D texture, Rectangle region, int tileWidth, int tileHeight, int spacing);
+
+void TileMapSetTile(TileMap *map, int x, int y, int tile);
+int TileMapGetTile(const TileMap *map, int x, int y);
+void TileMapFill(TileMap *map, int x, int y, int width, int height, int tile);
+void TileMapMarkDirty(TileMap *map, int x, int y, int width, int height);
+
+void TileMapUpdate(TileMap *map);
+void TileMapDraw(TileMap *map, Rectangle view);
+void TileMapGetStats(const TileMap *map, TileMapStats *stats);
+]]
+
+local C = ffi.C
+
+local tilemap = {}
+
+local map_methods = {}
+
+map_methods.set = C.TileMapSetTile
+map_methods.get = C.TileMapGetTile
+map_methods.fill = C.TileMapFill
+map_methods.update = C.TileMapUpdate
+
+---Tiles are tileWidth x tileHeight pixels of texture, `spacing` pixels apart, inside
+---`region` (default the whole texture; an atlas sprite's source works)
+function map_methods:tileset(texture, tileWidth, tileHeight, spacing, region)
+    C.TileMapSetTileset(self, texture, region or rl.new("Rectangle"), tileWidth, tileHeight, spacing or 0)
+end
+
+---Mark an area changed after writing tiles[] directly; no arguments marks the whole map
+function map_methods:dirty(x, y, width, height)
+    C.TileMapMarkDirty(self, x or 0, y or 0, width or self.width, height or self.height)
+end
+
+---Draw what `view` shows: a Camera2D (for the screen size) or a world space Rectangle
+function map_methods:draw(view)
+    if ffi.istype("Camera2D", view) then
+        view = culling.view2d(view, rl.GetScreenWidth(), rl.GetScreenHeight())
+    end
+    C.TileMapDraw(self, view)
+end
+
+---Counters of the last draw, pass a table to reuse it
+function map_methods:stats(out)
+    local stats = ffi.new("TileMapStats")
+    C.TileMapGetStats(self, stats)
+    out = out or {}
+    out.chunks, out.visibleChunks, out.rebuiltChunks = stats.chunks, stats.visibleChunks, stats.rebuiltChunks
+    out.drawCalls, out.quads, out.buildMs = stats.drawCalls, stats.quads, stats.buildMs
+    return out
+end
+
+function map_methods:destroy()
+    C.TileMapDestroy(ffi.gc(self, nil))
+end
+
+ffi.metatype("TileMap", { __index = map_methods })
+
+---Empty width x height map of tileWidth x tileHeight world units per tile, chunks of
+---chunkSize tiles a side (default 64)
+function tilemap.new(width, height, tileWidth, tileHeight, chunkSize)
+    local map = C.TileMapCreate(width, height, tileWidth, tileHeight or tileWidth, chunkSize or 0)
+    if map == nil then
+        return nil
+    end
+    return ffi.gc(map, C.TileMapDestroy)
+end
+
+---Time a `size` x `size` map of 16 px tiles scrolled under a 1280x720 view: the
+---native draw against a Lua loop of rl.DrawTextureRec over the visible tiles (that
+---part needs a window; without one the native draw only culls). Call it between
+---frames, nothing is presented. Returns ms per frame for both and the full build time.
+function tilemap.benchmark(size, iterations)
+    size = size or 1000
+    iterations = iterations or 120
+
+    local window = rl.IsWindowReady()
+    local map = tilemap.new(size, size, 16, 16)
+    local texture = ffi.new("Texture2D", { width = 256, height = 256 })
+    if window then
+        local image = rl.GenImageChecked(256, 256, 16, 16, rl.WHITE, rl.GRAY)
+        texture = rl.LoadTextureFromImage(image)
+        rl.UnloadImage(image)
+    end
+    map:tileset(texture, 16, 16)
+    local random = math.random
+    for i = 0, size * size - 1 do
+        map.tiles[i] = random(0, 256)
+    end
+
+    local start = os.clock()
+    map:dirty()
+    map:update()
+    local build = (os.clock() - start) * 1000
+
+    local view = rl.new("Rectangle", 0, 0, 1280, 720)
+    local function scroll(frame)
+        view.x = (frame * 7) % (size * 16 - 1280)
+        view.y = (frame * 3) % (size * 16 - 720)
+    end
+
+    start = os.clock()
+    for frame = 1, iterations do
+        scroll(frame)
+        map:draw(view)
+    end
+    local native = (os.clock() - start) / iterations * 1000
+    local stats = map:stats()
+
+    local lua = 0
+    if window then
+        local source, position = rl.new("Rectangle", 0, 0, 16, 16), rl.new("Vector2")
+        start = os.clock()
+        for frame = 1, iterations do
+            scroll(frame)
+            local x0, y0 = math.floor(view.x / 16), math.floor(view.y / 16)
+            for y = y0, math.min(y0 + 45, size - 1) do
+                for x = x0, math.min(x0 + 80, size - 1) do
+                    local tile = map.tiles[y * size + x]
+                    if tile > 0 then
+                        source.x, source.y = (tile - 1) % 16 * 16, math.floor((tile - 1) / 16) * 16
+                        position.x, position.y = x * 16, y * 16
+                        rl.DrawTextureRec(texture, source, position, rl.WHITE)
+                    end
+                end
+            end
+            rl.rlDrawRenderBatchActive()
+        end
+        lua = (os.clock() - start) / iterations * 1000
+        rl.UnloadTexture(texture)
+    end
+
+    rl.TraceLog(rl.LOG_INFO, "TILEMAP: %dx%d map built in %.1f ms; %.3f ms native (%d chunks, %d draw calls), %.2f ms from Lua per frame",
+        ffi.new("int", size), ffi.new("int", size), build, native, ffi.new("int", stats.visibleChunks), ffi.new("int", stats.drawCalls), lua)
+    map:destroy()
+    return { build = build, native = native, lua = lua }
+end
+
+return tilemap
@@ -0,0 +1,11 @@
+#ifndef API_HPP
+#define API_HPP
+
+// Marks functions that are looked up by LuaJIT through ffi.C
+#if defined(_WIN32)
+#define GAME_API extern "C" __declspec(dllexport)
+#else
+#define GAME_API extern "C" __attribute__((visibility("default")))
+#endif
+
+#endif
@@ -0,0 +1,469 @@
+#include "atlas.hpp"
+#include "cooked.hpp"
+#include "headless.hpp"
+#include "texture.hpp"
+#include "bytes.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static constexpr char COOKED_ATLAS_MAGIC[4] = {'R', 'A', 'T', 'L'};
+static constexpr int COOKED_ATLAS_ENTRY_SIZE = 32;
+
+struct PackRect
+{
+    int x, y, width, height;
+};
+
+struct PackItem
+{
+    int index; // into the input images
+    int width; // with the border
+    int height;
+};
+
+struct AtlasEntry
+{
+    uint32_t hash;
+    int nameOffset;
+    int nameLength;
+    int page;
+    Rectangle source;
+};
+
+struct TextureAtlas
+{
+    std::vector<AtlasEntry> entries; // sorted by hash
+    std::vector<char> names;
+    std::vector<Texture2D> pages;
+    std::vector<Vector2> pageSizes; // pages are empty textures without a window, placeholders in headless runs
+};
+
+static uint32_t HashName(const char *name, size_t length)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++)
+    {
+        hash ^= static_cast<unsigned char>(name[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// ---- max-rects packing ----
+
+static bool Contains(const PackRect &outer, const PackRect &inner)
+{
+    return inner.x >= outer.x && inner.y >= outer.y && inner.x + inner.width <= outer.x + outer.width &&
+           inner.y + inner.height <= outer.y + outer.height;
+}
+
+// Best short side fit: the free rectangle that leaves the smallest leftover on
+// its tighter side, ties broken by the longer side
+static bool FindPosition(const std::vector<PackRect> &freeRects, int width, int height, PackRect &position)
+{
+    int bestShort = INT32_MAX;
+    int bestLong = INT32_MAX;
+    for (const PackRect &free : freeRects)
+    {
+        if (free.width < width || free.height < height)
+            continue;
+
+        const int leftoverX = free.width - width;
+        const int leftoverY = free.height - height;
+        const int shortSide = std::min(leftoverX, leftoverY);
+        const int longSide = std::max(leftoverX, leftoverY);
+        if (shortSide < bestShort || (shortSide == bestShort && longSide < bestLong))
+        {
+            position = {free.x, free.y, width, height};
+            bestShort = shortSide;
+            bestLong = longSide;
+        }
+    }
+    return bestShort != INT32_MAX;
+}
+
+// Splits every free rectangle the placed one overlaps into the (overlapping)
+// maximal rectangles around it, then drops the new ones contained in another.
+// Untouched rectangles were maximal already, and cannot lie inside a piece of
+// another one.
+static void PlaceRect(std::vector<PackRect> &freeRects, const PackRect &placed)
+{
+    std::vector<PackRect> pieces;
+    size_t kept = 0;
+    for (const PackRect &free : freeRects)
+    {
+        if (placed.x >= free.x + free.width || placed.x + placed.width <= free.x || placed.y >= free.y + free.height ||
+            placed.y + placed.height <= free.y)
+        {
+            freeRects[kept++] = free;
+            continue;
+        }
+
+        if (placed.x > free.x)
+            pieces.push_back({free.x, free.y, placed.x - free.x, free.height});
+        if (placed.x + placed.width < free.x + free.width)
+            pieces.push_back({placed.x + placed.width, free.y, free.x + free.width - placed.x - placed.width, free.height});
+        if (placed.y > free.y)
+            pieces.push_back({free.x, free.y, free.width, placed.y - free.y});
+        if (placed.y + placed.height < free.y + free.height)
+            pieces.push_back({free.x, placed.y + placed.height, free.width, free.y + free.height - placed.y - placed.height});
+    }
+    freeRects.resize(kept);
+
+    for (size_t i = 0; i < pieces.size(); i++)
+    {
+        bool contained = false;
+        for (size_t j = 0; j < kept && !contained; j++)
+            contained = Contains(freeRects[j], pieces[i]);
+        for (size_t j = 0; j < pieces.size() && !contained; j++)
+            contained = j != i && Contains(pieces[j], pieces[i]) && (!Contains(pieces[i], pieces[j]) || j < i);
+        if (!contained)
+            freeRects.push_back(pieces[i]);
+    }
+}
+
+// Packs items in order into a width x height page; positions[i] is set for the
+// items that fit, returns how many did
+static int PackPage(const std::vector<PackItem> &items, int width, int height, std::vector<PackRect> &positions,
+                    std::vector<bool> &placed)
+{
+    std::vector<PackRect> freeRects = {{0, 0, width, height}};
+    positions.assign(items.size(), {});
+    placed.assign(items.size(), false);
+
+    int count = 0;
+    for (size_t i = 0; i < items.size(); i++)
+    {
+        if (!FindPosition(freeRects, items[i].width, items[i].height, positions[i]))
+            continue;
+        PlaceRect(freeRects, positions[i]);
+        placed[i] = true;
+        count++;
+    }
+    return count;
+}
+
+// Copies image into page at (x, y) inside its border, the border repeats the edge pixels
+static void BlitWithBorder(Image &page, const Image &image, int x, int y)
+{
+    unsigned char *pixels = static_cast<unsigned char *>(page.data);
+    const unsigned char *source = static_cast<const unsigned char *>(image.data);
+    for (int row = -ATLAS_SPRITE_BORDER; row < image.height + ATLAS_SPRITE_BORDER; row++)
+    {
+        const int sourceRow = std::clamp(row, 0, image.height - 1);
+        const unsigned char *from = source + static_cast<size_t>(sourceRow) * image.width * 4;
+        unsigned char *to = pixels + (static_cast<size_t>(y + row) * page.width + x) * 4;
+        for (int column = -ATLAS_SPRITE_BORDER; column < 0; column++)
+            memcpy(to + column * 4, from, 4);
+        memcpy(to, from, static_cast<size_t>(image.width) * 4);
+        for (int column = image.width; column < image.width + ATLAS_SPRITE_BORDER; column++)
+            memcpy(to + column * 4, from + (image.width - 1) * 4, 4);
+    }
+}
+
+static int NextPowerOfTwo(int value)
+{
+    int power = 1;
+    while (power < value)
+        power *= 2;
+    return power;
+}
+
+GAME_API bool ExportTextureAtlas(const Image *images, const char *const *names, int count, int maxPageSize,
+                                 unsigned int flags, const char *fileName)
+{
+    if (!images || !names || count <= 0 || maxPageSize <= 2 * ATLAS_SPRITE_BORDER || !fileName)
+        return false;
+
+    std::vector<PackItem> remaining;
+    for (int i = 0; i < count; i++)
+    {
+        const Image &image = images[i];
+        if (!image.data || image.format != PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 || !names[i])
+        {
+            TraceLog(LOG_WARNING, "COOK: Atlas %s needs RGBA images, %s is not", fileName, names[i] ? names[i] : "");
+            return false;
+        }
+        if (image.width + 2 * ATLAS_SPRITE_BORDER > maxPageSize || image.height + 2 * ATLAS_SPRITE_BORDER > maxPageSize)
+        {
+            TraceLog(LOG_WARNING, "COOK: %s (%dx%d) does not fit atlas pages of %d", names[i], image.width,
+                     image.height, maxPageSize);
+            return false;
+        }
+        remaining.push_back({i, image.width + 2 * ATLAS_SPRITE_BORDER, image.height + 2 * ATLAS_SPRITE_BORDER});
+    }
+
+    // Tall and wide items first, they are the hard ones to place
+    std::stable_sort(remaining.begin(), remaining.end(), [](const PackItem &a, const PackItem &b) {
+        const int sideA = std::max(a.width, a.height);
+        const int sideB = std::max(b.width, b.height);
+        return sideA != sideB ? sideA > sideB : a.width * a.height > b.width * b.height;
+    });
+
+    // Every page is packed at the smallest power of two size that takes all the
+    // remaining items, or at the full size with as many as fit
+    struct Page
+    {
+        int width, height;
+    };
+    std::vector<Page> pages;
+    std::vector<int> pageOf(count, -1);
+    std::vector<PackRect> rectOf(count);
+    std::vector<PackRect> positions;
+    std::vector<bool> placed;
+    while (!remaining.empty())
+    {
+        int64_t area = 0;
+        int widest = 0, tallest = 0;
+        for (const PackItem &item : remaining)
+        {
+            area += static_cast<int64_t>(item.width) * item.height;
+            widest = std::max(widest, item.width);
+            tallest = std::max(tallest, item.height);
+        }
+
+        int width = NextPowerOfTwo(widest);
+        int height = NextPowerOfTwo(tallest);
+        while (static_cast<int64_t>(width) * height < area && (width < maxPageSize || height < maxPageSize))
+            (width <= height && width < maxPageSize ? width : height) *= 2;
+        width = std::min(width, maxPageSize);
+        height = std::min(height, maxPageSize);
+
+        while (PackPage(remaining, width, height, positions, placed) < static_cast<int>(remaining.size()) &&
+               (width < maxPageSize || height < maxPageSize))
+        {
+            (width <= height && width < maxPageSize ? width : height) *= 2;
+            width = std::min(width, maxPageSize);
+            height = std::min(height, maxPageSize);
+        }
+
+        std::vector<PackItem> left;
+        for (size_t i = 0; i < remaining.size(); i++)
+        {
+            if (!placed[i])
+            {
+                left.push_back(remaining[i]);
+                continue;
+            }
+            pageOf[remaining[i].index] = static_cast<int>(pages.size());
+            rectOf[remaining[i].index] = positions[i];
+        }
+        pages.push_back({width, height});
+        remaining.swap(left);
+    }
+
+    // Table sorted by name hash for binary search at runtime
+    std::vector<int> order(count);
+    std::vector<uint32_t> hashes(count);
+    for (int i = 0; i < count; i++)
+    {
+        order[i] = i;
+        hashes[i] = HashName(names[i], strlen(names[i]));
+    }
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return hashes[a] != hashes[b] ? hashes[a] < hashes[b] : strcmp(names[a], names[b]) < 0;
+    });
+
+    std::vector<unsigned char> file(COOKED_HEADER_SIZE + static_cast<size_t>(count) * COOKED_ATLAS_ENTRY_SIZE);
+    std::vector<char> nameData;
+    for (int i = 0; i < count; i++)
+    {
+        const int index = order[i];
+        const int length = static_cast<int>(strlen(names[index]));
+        const PackRect &rect = rectOf[index];
+        unsigned char *entry = file.data() + COOKED_HEADER_SIZE + i * COOKED_ATLAS_ENTRY_SIZE;
+        WriteI32(entry + 0, static_cast<int32_t>(hashes[index]));
+        WriteI32(entry + 4, static_cast<int32_t>(nameData.size()));
+        WriteI32(entry + 8, length);
+        WriteI32(entry + 12, pageOf[index]);
+        WriteI32(entry + 16, rect.x + ATLAS_SPRITE_BORDER);
+        WriteI32(entry + 20, rect.y + ATLAS_SPRITE_BORDER);
+        WriteI32(entry + 24, images[index].width);
+        WriteI32(entry + 28, images[index].height);
+        nameData.insert(nameData.end(), names[index], names[index] + length + 1);
+    }
+    file.insert(file.end(), nameData.begin(), nameData.end());
+
+    memcpy(file.data(), COOKED_ATLAS_MAGIC, sizeof(COOKED_ATLAS_MAGIC));
+    WriteU16(file.data() + 4, COOKED_ATLAS_VERSION);
+    WriteU16(file.data() + 6, 0);
+    WriteI32(file.data() + 8, static_cast<int32_t>(pages.size()));
+    WriteI32(file.data() + 12, count);
+    WriteI32(file.data() + 16, static_cast<int32_t>(nameData.size()));
+
+    for (size_t p = 0; p < pages.size(); p++)
+    {
+        Image page = GenImageColor(pages[p].width, pages[p].height, BLANK);
+        for (int i = 0; i < count; i++)
+            if (pageOf[i] == static_cast<int>(p))
+                BlitWithBorder(page, images[i], rectOf[i].x + ATLAS_SPRITE_BORDER, rectOf[i].y + ATLAS_SPRITE_BORDER);
+        if (flags & TEXTURE_PAYLOAD_PREMULTIPLIED)
+            ImageAlphaPremultiply(&page);
+
+        const bool appended = AppendTexturePayload(page, flags, file);
+        UnloadImage(page);
+        if (!appended)
+            return false;
+    }
+
+    return SaveFileData(fileName, file.data(), static_cast<int>(file.size()));
+}
+
+// ---- runtime ----
+
+GAME_API TextureAtlas *LoadTextureAtlas(const char *fileName)
+{
+    int fileSize = 0;
+    unsigned char *fileData = LoadFileData(fileName, &fileSize);
+    if (!fileData)
+        return nullptr;
+
+    if (!CheckCookedHeader(fileData, fileSize, COOKED_ATLAS_MAGIC, COOKED_ATLAS_VERSION, fileName))
+    {
+        UnloadFileData(fileData);
+        return nullptr;
+    }
+
+    const int pageCount = ReadI32(fileData + 8);
+    const int spriteCount = ReadI32(fileData + 12);
+    const int namesSize = ReadI32(fileData + 16);
+    const int64_t namesOffset = COOKED_HEADER_SIZE + static_cast<int64_t>(spriteCount) * COOKED_ATLAS_ENTRY_SIZE;
+
+    TextureAtlas *atlas = new TextureAtlas;
+    bool valid = pageCount > 0 && spriteCount > 0 && namesSize > 0 && namesOffset + namesSize <= fileSize &&
+                 fileData[namesOffset + namesSize - 1] == '\0';
+
+    // Pages first, the sprite rectangles are checked against their sizes
+    std::vector<TexturePayload> payloads;
+    int64_t offset = namesOffset + namesSize;
+    for (int p = 0; valid && p < pageCount; p++)
+    {
+        TexturePayload payload;
+        valid = offset < fileSize &&
+                TexturePayloadParse(fileData + offset, fileSize - static_cast<int>(offset), &payload) &&
+                payload.format < PIXELFORMAT_COMPRESSED_DXT1_RGB;
+        if (valid)
+        {
+            payloads.push_back(payload);
+            offset += TEXTURE_PAYLOAD_HEADER_SIZE + payload.dataSize;
+        }
+    }
+
+    for (int i = 0; valid && i < spriteCount; i++)
+    {
+        const unsigned char *entry = fileData + COOKED_HEADER_SIZE + i * COOKED_ATLAS_ENTRY_SIZE;
+        AtlasEntry sprite;
+        sprite.hash = static_cast<uint32_t>(ReadI32(entry + 0));
+        sprite.nameOffset = ReadI32(entry + 4);
+        sprite.nameLength = ReadI32(entry + 8);
+        sprite.page = ReadI32(entry + 12);
+        const int x = ReadI32(entry + 16), y = ReadI32(entry + 20);
+        const int width = ReadI32(entry + 24), height = ReadI32(entry + 28);
+
+        valid = sprite.nameOffset >= 0 && sprite.nameLength >= 0 &&
+                static_cast<int64_t>(sprite.nameOffset) + sprite.nameLength < namesSize &&
+                fileData[namesOffset + sprite.nameOffset + sprite.nameLength] == '\0' && sprite.page >= 0 &&
+                sprite.page < pageCount && x >= 0 && y >= 0 && width > 0 && height > 0 &&
+                x + width <= payloads[sprite.page].width && y + height <= payloads[sprite.page].height &&
+                (i == 0 || atlas->entries.back().hash <= sprite.hash);
+        sprite.source = {static_cast<float>(x), static_cast<float>(y), static_cast<float>(width),
+                         static_cast<float>(height)};
+        atlas->entries.push_back(sprite);
+    }
+
+    if (!valid)
+    {
+        TraceLog(LOG_WARNING, "COOK: Corrupt texture atlas %s", fileName);
+        UnloadFileData(fileData);
+        delete atlas;
+        return nullptr;
+    }
+
+    atlas->names.assign(fileData + namesOffset, fileData + namesOffset + namesSize);
+    for (const TexturePayload &payload : payloads)
+    {
+        // Headless pages get placeholder ids so sprite batches keep the sprites drawn from them
+        if (IsWindowReady())
+            atlas->pages.push_back(LoadTextureFromPayload(&payload));
+        else if (HeadlessIsEnabled())
+            atlas->pages.push_back({HeadlessFakeTextureId(), payload.width, payload.height, payload.mipmaps, payload.format});
+        else
+            atlas->pages.push_back({});
+        atlas->pageSizes.push_back({static_cast<float>(payload.width), static_cast<float>(payload.height)});
+    }
+
+    UnloadFileData(fileData);
+    return atlas;
+}
+
+GAME_API void UnloadTextureAtlas(TextureAtlas *atlas)
+{
+    if (!atlas)
+        return;
+
+    for (const Texture2D &page : atlas->pages)
+        if (page.id != 0 && !HeadlessIsEnabled())
+            UnloadTexture(page);
+    delete atlas;
+}
+
+GAME_API int TextureAtlasSpriteCount(const TextureAtlas *atlas)
+{
+    return atlas ? static_cast<int>(atlas->entries.size()) : 0;
+}
+
+GAME_API int TextureAtlasPageCount(const TextureAtlas *atlas)
+{
+    return atlas ? static_cast<int>(atlas->pages.size()) : 0;
+}
+
+GAME_API Texture2D TextureAtlasGetPage(const TextureAtlas *atlas, int page)
+{
+    if (!atlas || page < 0 || page >= static_cast<int>(atlas->pages.size()))
+        return {};
+    return atlas->pages[page];
+}
+
+GAME_API int TextureAtlasFind(const TextureAtlas *atlas, const char *name)
+{
+    if (!atlas || !name)
+        return -1;
+
+    const size_t length = strlen(name);
+    const uint32_t hash = HashName(name, length);
+    auto it = std::lower_bound(atlas->entries.begin(), atlas->entries.end(), hash,
+                               [](const AtlasEntry &entry, uint32_t value) { return entry.hash < value; });
+    for (; it != atlas->entries.end() && it->hash == hash; ++it)
+    {
+        if (static_cast<size_t>(it->nameLength) == length &&
+            memcmp(atlas->names.data() + it->nameOffset, name, length) == 0)
+            return static_cast<int>(it - atlas->entries.begin());
+    }
+    return -1;
+}
+
+GAME_API bool TextureAtlasGetSprite(const TextureAtlas *atlas, int index, AtlasSprite *sprite)
+{
+    if (!atlas || !sprite || index < 0 || index >= static_cast<int>(atlas->entries.size()))
+        return false;
+
+    const AtlasEntry &entry = atlas->entries[index];
+    const Vector2 size = atlas->pageSizes[entry.page];
+    sprite->texture = atlas->pages[entry.page];
+    sprite->source = entry.source;
+    sprite->uv = {entry.source.x / size.x, entry.source.y / size.y, entry.source.width / size.x,
+                  entry.source.height / size.y};
+    sprite->page = entry.page;
+    return true;
+}
+
+GAME_API const char *TextureAtlasGetName(const TextureAtlas *atlas, int index)
+{
+    if (!atlas || index < 0 || index >= static_cast<int>(atlas->entries.size()))
+        return nullptr;
+    return atlas->names.data() + atlas->entries[index].nameOffset;
+}
@@ -0,0 +1,50 @@
+#ifndef ATLAS_HPP
+#define ATLAS_HPP
+
+#include "api.hpp"
+
+#include <raylib/raylib.h>
+
+// Texture atlases written by the cook tool (src/cook.cpp): every image of an
+// atlas directory packed (max-rects) into a few RGBA pages, so the sprites of
+// a directory share one texture and draw in one batch. Each sprite gets a
+// 1 px border copied from its edge pixels, filtering never samples a neighbour.
+//
+// .ratl  "RATL" u16 version, u16 flags, i32 pageCount, spriteCount, namesSize,
+//        3 x reserved; then spriteCount x { u32 nameHash, i32 nameOffset,
+//        nameLength, page, x, y, width, height } sorted by hash; then namesSize
+//        bytes of zero-terminated names; then pageCount embedded .rtex pages
+//
+// Names are paths relative to the atlas directory without extension
+// ("ui/button"), hashed with FNV-1a. All fields are little-endian.
+constexpr int COOKED_ATLAS_VERSION = 1;
+constexpr int ATLAS_SPRITE_BORDER = 1; // pixels on each side
+
+struct AtlasSprite
+{
+    Texture2D texture; // the page, id 0 without a window
+    Rectangle source;  // pixels, for DrawTextureRec/DrawTexturePro and Sprite.source
+    Rectangle uv;      // the same rectangle in 0..1 texture coordinates
+    int page;
+};
+
+typedef struct TextureAtlas TextureAtlas;
+
+// Packs count RGBA images into pages of at most maxPageSize squared, fails if
+// one does not fit; flags are TEXTURE_PAYLOAD_* bits (premultiplied is applied)
+GAME_API bool ExportTextureAtlas(const Image *images, const char *const *names, int count, int maxPageSize,
+                                 unsigned int flags, const char *fileName);
+
+// Reads through the VFS and uploads the pages; lookups work without a window
+GAME_API TextureAtlas *LoadTextureAtlas(const char *fileName);
+GAME_API void UnloadTextureAtlas(TextureAtlas *atlas);
+
+GAME_API int TextureAtlasSpriteCount(const TextureAtlas *atlas);
+GAME_API int TextureAtlasPageCount(const TextureAtlas *atlas);
+GAME_API Texture2D TextureAtlasGetPage(const TextureAtlas *atlas, int page);
+// Index of the sprite called name, -1 if there is none
+GAME_API int TextureAtlasFind(const TextureAtlas *atlas, const char *name);
+GAME_API bool TextureAtlasGetSprite(const TextureAtlas *atlas, int index, AtlasSprite *sprite);
+GAME_API const char *TextureAtlasGetName(const TextureAtlas *atlas, int index);
+
+#endif
@@ -0,0 +1,634 @@
+#include "batchmath.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#define RAYMATH_STATIC_INLINE
+#include <raylib/raymath.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define BATCHMATH_USE_SSE2 1
+#endif
+
+// AVX2 kernels are compiled per function with the target attribute and only
+// called after the CPU check, the rest of the file stays baseline x86-64
+#if defined(BATCHMATH_USE_SSE2) && defined(__GNUC__)
+#include <immintrin.h>
+#define BATCHMATH_USE_AVX2 1
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+#endif
+
+static int g_SupportedLevel = BATCHMATH_SCALAR;
+static int g_Level = BATCHMATH_SCALAR;
+
+static const char *LevelName(int level)
+{
+    switch (level)
+    {
+    case BATCHMATH_AVX2:
+        return "AVX2";
+    case BATCHMATH_SSE2:
+        return "SSE2";
+    default:
+        return "scalar";
+    }
+}
+
+// --- Scalar ---
+
+static BoundingBox BoundingBoxTransform(BoundingBox box, const Matrix &mat)
+{
+    // transformed center plus extents through the absolute rotation/scale part (Arvo)
+    const float cx = (box.min.x + box.max.x) * 0.5f, ex = (box.max.x - box.min.x) * 0.5f;
+    const float cy = (box.min.y + box.max.y) * 0.5f, ey = (box.max.y - box.min.y) * 0.5f;
+    const float cz = (box.min.z + box.max.z) * 0.5f, ez = (box.max.z - box.min.z) * 0.5f;
+
+    const Vector3 center = Vector3Transform({cx, cy, cz}, mat);
+    const Vector3 extent = {
+        fabsf(mat.m0) * ex + fabsf(mat.m4) * ey + fabsf(mat.m8) * ez,
+        fabsf(mat.m1) * ex + fabsf(mat.m5) * ey + fabsf(mat.m9) * ez,
+        fabsf(mat.m2) * ex + fabsf(mat.m6) * ey + fabsf(mat.m10) * ez,
+    };
+
+    return {Vector3Subtract(center, extent), Vector3Add(center, extent)};
+}
+
+// --- SSE2 ---
+
+#if defined(BATCHMATH_USE_SSE2)
+
+static inline __m128 Select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3  <->  x0..x3 | y0..y3 | z0..z3
+static inline void Deinterleave3(__m128 a, __m128 b, __m128 c, __m128 &x, __m128 &y, __m128 &z)
+{
+    const __m128 xy23 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+    const __m128 yz01 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+    x = _mm_shuffle_ps(a, xy23, _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm_shuffle_ps(yz01, xy23, _MM_SHUFFLE(3, 1, 2, 0));
+    z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+static inline void Interleave3(__m128 x, __m128 y, __m128 z, __m128 &a, __m128 &b, __m128 &c)
+{
+    const __m128 xy01 = _mm_unpacklo_ps(x, y);
+    const __m128 xy23 = _mm_unpackhi_ps(x, y);
+    a = _mm_shuffle_ps(xy01, _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));
+    b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), xy23, _MM_SHUFFLE(1, 0, 2, 0));
+    const __m128 zxy = _mm_shuffle_ps(z, xy23, _MM_SHUFFLE(3, 2, 3, 2));
+    c = _mm_shuffle_ps(zxy, zxy, _MM_SHUFFLE(1, 3, 2, 0));
+}
+
+static void Vector3TransformSSE2(const Vector3 *points, Vector3 *out, int count, const Matrix &mat)
+{
+    const __m128 m0 = _mm_set1_ps(mat.m0), m4 = _mm_set1_ps(mat.m4), m8 = _mm_set1_ps(mat.m8), m12 = _mm_set1_ps(mat.m12);
+    const __m128 m1 = _mm_set1_ps(mat.m1), m5 = _mm_set1_ps(mat.m5), m9 = _mm_set1_ps(mat.m9), m13 = _mm_set1_ps(mat.m13);
+    const __m128 m2 = _mm_set1_ps(mat.m2), m6 = _mm_set1_ps(mat.m6), m10 = _mm_set1_ps(mat.m10), m14 = _mm_set1_ps(mat.m14);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const float *src = &points[i].x;
+        float *dst = &out[i].x;
+
+        __m128 x, y, z;
+        Deinterleave3(_mm_loadu_ps(src), _mm_loadu_ps(src + 4), _mm_loadu_ps(src + 8), x, y, z);
+
+        const __m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m4, y)), _mm_add_ps(_mm_mul_ps(m8, z), m12));
+        const __m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, x), _mm_mul_ps(m5, y)), _mm_add_ps(_mm_mul_ps(m9, z), m13));
+        const __m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, x), _mm_mul_ps(m6, y)), _mm_add_ps(_mm_mul_ps(m10, z), m14));
+
+        __m128 a, b, c;
+        Interleave3(rx, ry, rz, a, b, c);
+        _mm_storeu_ps(dst, a);
+        _mm_storeu_ps(dst + 4, b);
+        _mm_storeu_ps(dst + 8, c);
+    }
+    for (; i < count; i++)
+        out[i] = Vector3Transform(points[i], mat);
+}
+
+static void MatrixMultiplySSE2(const Matrix *left, const Matrix *right, Matrix *out, int count)
+{
+    // raylib stores m0 m4 m8 m12 first, so each 4-float row of the struct
+    // is (m[j], m[j+4], m[j+8], m[j+12]) and result row j = sum_k left row k * right[j][k]
+    for (int i = 0; i < count; i++)
+    {
+        const float *l = &left[i].m0;
+        const float *r = &right[i].m0;
+        float *o = &out[i].m0;
+
+        const __m128 l0 = _mm_loadu_ps(l), l1 = _mm_loadu_ps(l + 4), l2 = _mm_loadu_ps(l + 8), l3 = _mm_loadu_ps(l + 12);
+        const __m128 r0 = _mm_loadu_ps(r), r1 = _mm_loadu_ps(r + 4), r2 = _mm_loadu_ps(r + 8), r3 = _mm_loadu_ps(r + 12);
+
+        auto row = [&](__m128 rj) {
+            return _mm_add_ps(_mm_add_ps(_mm_mul_ps(l0, _mm_shuffle_ps(rj, rj, _MM_SHUFFLE(0, 0, 0, 0))),
+                                         _mm_mul_ps(l1, _mm_shuffle_ps(rj, rj, _MM_SHUFFLE(1, 1, 1, 1)))),
+                              _mm_add_ps(_mm_mul_ps(l2, _mm_shuffle_ps(rj, rj, _MM_SHUFFLE(2, 2, 2, 2))),
+                                         _mm_mul_ps(l3, _mm_shuffle_ps(rj, rj, _MM_SHUFFLE(3, 3, 3, 3)))));
+        };
+
+        const __m128 o0 = row(r0), o1 = row(r1), o2 = row(r2), o3 = row(r3);
+        _mm_storeu_ps(o, o0);
+        _mm_storeu_ps(o + 4, o1);
+        _mm_storeu_ps(o + 8, o2);
+        _mm_storeu_ps(o + 12, o3);
+    }
+}
+
+struct Quat4
+{
+    __m128 x, y, z, w;
+};
+
+static inline Quat4 LoadQuat4(const Quaternion *q)
+{
+    Quat4 r = {_mm_loadu_ps(&q[0].x), _mm_loadu_ps(&q[1].x), _mm_loadu_ps(&q[2].x), _mm_loadu_ps(&q[3].x)};
+    _MM_TRANSPOSE4_PS(r.x, r.y, r.z, r.w);
+    return r;
+}
+
+static inline void StoreQuat4(Quaternion *q, Quat4 r)
+{
+    _MM_TRANSPOSE4_PS(r.x, r.y, r.z, r.w);
+    _mm_storeu_ps(&q[0].x, r.x);
+    _mm_storeu_ps(&q[1].x, r.y);
+    _mm_storeu_ps(&q[2].x, r.z);
+    _mm_storeu_ps(&q[3].x, r.w);
+}
+
+static inline Quat4 Nlerp4(const Quat4 &a, const Quat4 &b, __m128 t)
+{
+    Quat4 r = {
+        _mm_add_ps(a.x, _mm_mul_ps(t, _mm_sub_ps(b.x, a.x))),
+        _mm_add_ps(a.y, _mm_mul_ps(t, _mm_sub_ps(b.y, a.y))),
+        _mm_add_ps(a.z, _mm_mul_ps(t, _mm_sub_ps(b.z, a.z))),
+        _mm_add_ps(a.w, _mm_mul_ps(t, _mm_sub_ps(b.w, a.w))),
+    };
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(r.x, r.x), _mm_mul_ps(r.y, r.y)),
+                                           _mm_add_ps(_mm_mul_ps(r.z, r.z), _mm_mul_ps(r.w, r.w))));
+    length = Select(_mm_cmpeq_ps(length, _mm_setzero_ps()), one, length);
+    const __m128 inverse = _mm_div_ps(one, length);
+
+    r.x = _mm_mul_ps(r.x, inverse);
+    r.y = _mm_mul_ps(r.y, inverse);
+    r.z = _mm_mul_ps(r.z, inverse);
+    r.w = _mm_mul_ps(r.w, inverse);
+    return r;
+}
+
+static void QuaternionNlerpSSE2(const Quaternion *q1, const Quaternion *q2, Quaternion *out, int count, float amount)
+{
+    const __m128 t = _mm_set1_ps(amount);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+        StoreQuat4(out + i, Nlerp4(LoadQuat4(q1 + i), LoadQuat4(q2 + i), t));
+    for (; i < count; i++)
+        out[i] = QuaternionNlerp(q1[i], q2[i], amount);
+}
+
+// acos on [0, 1], Abramowitz & Stegun 4.4.46 (|error| <= 2e-8)
+static inline __m128 Acos4(__m128 x)
+{
+    __m128 p = _mm_set1_ps(-0.0012624911f);
+    p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(0.0066700901f));
+    p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(-0.0170881256f));
+    p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(0.0308918810f));
+    p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(-0.0501743046f));
+    p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(0.0889789874f));
+    p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(-0.2145988016f));
+    p = _mm_add_ps(_mm_mul_ps(p, x), _mm_set1_ps(1.5707963050f));
+    return _mm_mul_ps(p, _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(_mm_set1_ps(1.0f), x), _mm_setzero_ps())));
+}
+
+// sin on [0, pi/2], Taylor series up to x^11
+static inline __m128 Sin4(__m128 x)
+{
+    const __m128 x2 = _mm_mul_ps(x, x);
+    __m128 p = _mm_set1_ps(-2.5052108e-8f);
+    p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(2.7557319e-6f));
+    p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(-1.9841270e-4f));
+    p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(8.3333333e-3f));
+    p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(-1.6666667e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, x2), _mm_set1_ps(1.0f));
+    return _mm_mul_ps(p, x);
+}
+
+static void QuaternionSlerpSSE2(const Quaternion *q1, const Quaternion *q2, Quaternion *out, int count, float amount)
+{
+    const __m128 t = _mm_set1_ps(amount);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const Quat4 a = LoadQuat4(q1 + i);
+        Quat4 b = LoadQuat4(q2 + i);
+
+        // take the short way around, same as QuaternionSlerp
+        __m128 cosHalfTheta = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)),
+                                         _mm_add_ps(_mm_mul_ps(a.z, b.z), _mm_mul_ps(a.w, b.w)));
+        const __m128 flip = _mm_and_ps(cosHalfTheta, signBit);
+        b = {_mm_xor_ps(b.x, flip), _mm_xor_ps(b.y, flip), _mm_xor_ps(b.z, flip), _mm_xor_ps(b.w, flip)};
+        cosHalfTheta = _mm_xor_ps(cosHalfTheta, flip);
+
+        const __m128 halfTheta = Acos4(cosHalfTheta);
+        const __m128 sinHalfTheta = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(one, _mm_mul_ps(cosHalfTheta, cosHalfTheta)), _mm_setzero_ps()));
+        const __m128 inverseSin = _mm_div_ps(one, sinHalfTheta);
+        const __m128 ratioA = _mm_mul_ps(Sin4(_mm_mul_ps(_mm_sub_ps(one, t), halfTheta)), inverseSin);
+        const __m128 ratioB = _mm_mul_ps(Sin4(_mm_mul_ps(t, halfTheta)), inverseSin);
+
+        const Quat4 n = Nlerp4(a, b, t);
+        const __m128 useA = _mm_cmpge_ps(cosHalfTheta, one);
+        const __m128 useNlerp = _mm_cmpgt_ps(cosHalfTheta, _mm_set1_ps(0.95f));
+
+        auto blend = [&](__m128 qa, __m128 qb, __m128 qn) {
+            const __m128 s = _mm_add_ps(_mm_mul_ps(qa, ratioA), _mm_mul_ps(qb, ratioB));
+            return Select(useA, qa, Select(useNlerp, qn, s));
+        };
+
+        StoreQuat4(out + i, {blend(a.x, b.x, n.x), blend(a.y, b.y, n.y), blend(a.z, b.z, n.z), blend(a.w, b.w, n.w)});
+    }
+    for (; i < count; i++)
+        out[i] = QuaternionSlerp(q1[i], q2[i], amount);
+}
+
+static void BoundingBoxTransformSSE2(const BoundingBox *boxes, BoundingBox *out, int count, const Matrix &mat)
+{
+    const __m128 c0 = _mm_setr_ps(mat.m0, mat.m1, mat.m2, 0.0f);
+    const __m128 c1 = _mm_setr_ps(mat.m4, mat.m5, mat.m6, 0.0f);
+    const __m128 c2 = _mm_setr_ps(mat.m8, mat.m9, mat.m10, 0.0f);
+    const __m128 translation = _mm_setr_ps(mat.m12, mat.m13, mat.m14, 0.0f);
+
+    for (int i = 0; i < count; i++)
+    {
+        const BoundingBox &box = boxes[i];
+        __m128 lo = translation;
+        __m128 hi = translation;
+
+        auto axis = [&](__m128 column, float min, float max) {
+            const __m128 a = _mm_mul_ps(column, _mm_set1_ps(min));
+            const __m128 b = _mm_mul_ps(column, _mm_set1_ps(max));
+            lo = _mm_add_ps(lo, _mm_min_ps(a, b));
+            hi = _mm_add_ps(hi, _mm_max_ps(a, b));
+        };
+        axis(c0, box.min.x, box.max.x);
+        axis(c1, box.min.y, box.max.y);
+        axis(c2, box.min.z, box.max.z);
+
+        // the 16-byte store of min spills into max.x, which is written right after
+        float *dst = &out[i].min.x;
+        _mm_storeu_ps(dst, lo);
+        _mm_storel_pi(reinterpret_cast<__m64 *>(dst + 3), hi);
+        _mm_store_ss(dst + 5, _mm_movehl_ps(hi, hi));
+    }
+}
+
+#endif
+
+// --- AVX2 + FMA, 8 elements per iteration as two 128-bit lanes of 4 ---
+
+#if defined(BATCHMATH_USE_AVX2)
+
+AVX2_TARGET static inline __m256 Load2(const float *lo, const float *hi)
+{
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(lo)), _mm_loadu_ps(hi), 1);
+}
+
+AVX2_TARGET static inline void Store2(float *lo, float *hi, __m256 value)
+{
+    _mm_storeu_ps(lo, _mm256_castps256_ps128(value));
+    _mm_storeu_ps(hi, _mm256_extractf128_ps(value, 1));
+}
+
+AVX2_TARGET static inline __m256 Select(__m256 mask, __m256 a, __m256 b)
+{
+    return _mm256_blendv_ps(b, a, mask);
+}
+
+AVX2_TARGET static inline void Deinterleave3(__m256 a, __m256 b, __m256 c, __m256 &x, __m256 &y, __m256 &z)
+{
+    const __m256 xy23 = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+    const __m256 yz01 = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+    x = _mm256_shuffle_ps(a, xy23, _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm256_shuffle_ps(yz01, xy23, _MM_SHUFFLE(3, 1, 2, 0));
+    z = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm256_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+AVX2_TARGET static inline void Interleave3(__m256 x, __m256 y, __m256 z, __m256 &a, __m256 &b, __m256 &c)
+{
+    const __m256 xy01 = _mm256_unpacklo_ps(x, y);
+    const __m256 xy23 = _mm256_unpackhi_ps(x, y);
+    a = _mm256_shuffle_ps(xy01, _mm256_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));
+    b = _mm256_shuffle_ps(_mm256_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), xy23, _MM_SHUFFLE(1, 0, 2, 0));
+    const __m256 zxy = _mm256_shuffle_ps(z, xy23, _MM_SHUFFLE(3, 2, 3, 2));
+    c = _mm256_shuffle_ps(zxy, zxy, _MM_SHUFFLE(1, 3, 2, 0));
+}
+
+AVX2_TARGET static void Vector3TransformAVX2(const Vector3 *points, Vector3 *out, int count, const Matrix &mat)
+{
+    const __m256 m0 = _mm256_set1_ps(mat.m0), m4 = _mm256_set1_ps(mat.m4), m8 = _mm256_set1_ps(mat.m8), m12 = _mm256_set1_ps(mat.m12);
+    const __m256 m1 = _mm256_set1_ps(mat.m1), m5 = _mm256_set1_ps(mat.m5), m9 = _mm256_set1_ps(mat.m9), m13 = _mm256_set1_ps(mat.m13);
+    const __m256 m2 = _mm256_set1_ps(mat.m2), m6 = _mm256_set1_ps(mat.m6), m10 = _mm256_set1_ps(mat.m10), m14 = _mm256_set1_ps(mat.m14);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        // points 0-3 in the low lane, 4-7 in the high lane
+        const float *src = &points[i].x;
+        float *dst = &out[i].x;
+
+        __m256 x, y, z;
+        Deinterleave3(Load2(src, src + 12), Load2(src + 4, src + 16), Load2(src + 8, src + 20), x, y, z);
+
+        const __m256 rx = _mm256_fmadd_ps(m0, x, _mm256_fmadd_ps(m4, y, _mm256_fmadd_ps(m8, z, m12)));
+        const __m256 ry = _mm256_fmadd_ps(m1, x, _mm256_fmadd_ps(m5, y, _mm256_fmadd_ps(m9, z, m13)));
+        const __m256 rz = _mm256_fmadd_ps(m2, x, _mm256_fmadd_ps(m6, y, _mm256_fmadd_ps(m10, z, m14)));
+
+        __m256 a, b, c;
+        Interleave3(rx, ry, rz, a, b, c);
+        Store2(dst, dst + 12, a);
+        Store2(dst + 4, dst + 16, b);
+        Store2(dst + 8, dst + 20, c);
+    }
+
+    Vector3TransformSSE2(points + i, out + i, count - i, mat);
+}
+
+// lambdas do not inherit the target attribute, hence the small helpers
+AVX2_TARGET static inline __m256 MultiplyRows(__m256 l0, __m256 l1, __m256 l2, __m256 l3, __m256 rows)
+{
+    __m256 result = _mm256_mul_ps(l0, _mm256_permute_ps(rows, _MM_SHUFFLE(0, 0, 0, 0)));
+    result = _mm256_fmadd_ps(l1, _mm256_permute_ps(rows, _MM_SHUFFLE(1, 1, 1, 1)), result);
+    result = _mm256_fmadd_ps(l2, _mm256_permute_ps(rows, _MM_SHUFFLE(2, 2, 2, 2)), result);
+    return _mm256_fmadd_ps(l3, _mm256_permute_ps(rows, _MM_SHUFFLE(3, 3, 3, 3)), result);
+}
+
+AVX2_TARGET static void MatrixMultiplyAVX2(const Matrix *left, const Matrix *right, Matrix *out, int count)
+{
+    // two result rows per register, left rows duplicated into both lanes
+    for (int i = 0; i < count; i++)
+    {
+        const float *l = &left[i].m0;
+        const float *r = &right[i].m0;
+        float *o = &out[i].m0;
+
+        const __m256 l0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(l));
+        const __m256 l1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(l + 4));
+        const __m256 l2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(l + 8));
+        const __m256 l3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(l + 12));
+        const __m256 r01 = _mm256_loadu_ps(r);
+        const __m256 r23 = _mm256_loadu_ps(r + 8);
+
+        const __m256 o01 = MultiplyRows(l0, l1, l2, l3, r01);
+        const __m256 o23 = MultiplyRows(l0, l1, l2, l3, r23);
+        _mm256_storeu_ps(o, o01);
+        _mm256_storeu_ps(o + 8, o23);
+    }
+}
+
+struct Quat8
+{
+    __m256 x, y, z, w;
+};
+
+AVX2_TARGET static inline void Transpose4(__m256 &r0, __m256 &r1, __m256 &r2, __m256 &r3)
+{
+    const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    const __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    const __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+AVX2_TARGET static inline Quat8 LoadQuat8(const Quaternion *q)
+{
+    Quat8 r = {Load2(&q[0].x, &q[4].x), Load2(&q[1].x, &q[5].x), Load2(&q[2].x, &q[6].x), Load2(&q[3].x, &q[7].x)};
+    Transpose4(r.x, r.y, r.z, r.w);
+    return r;
+}
+
+AVX2_TARGET static inline void StoreQuat8(Quaternion *q, Quat8 r)
+{
+    Transpose4(r.x, r.y, r.z, r.w);
+    Store2(&q[0].x, &q[4].x, r.x);
+    Store2(&q[1].x, &q[5].x, r.y);
+    Store2(&q[2].x, &q[6].x, r.z);
+    Store2(&q[3].x, &q[7].x, r.w);
+}
+
+AVX2_TARGET static inline __m256 Dot8(const Quat8 &a, const Quat8 &b)
+{
+    return _mm256_fmadd_ps(a.x, b.x, _mm256_fmadd_ps(a.y, b.y, _mm256_fmadd_ps(a.z, b.z, _mm256_mul_ps(a.w, b.w))));
+}
+
+AVX2_TARGET static inline Quat8 Nlerp8(const Quat8 &a, const Quat8 &b, __m256 t)
+{
+    Quat8 r = {
+        _mm256_fmadd_ps(t, _mm256_sub_ps(b.x, a.x), a.x),
+        _mm256_fmadd_ps(t, _mm256_sub_ps(b.y, a.y), a.y),
+        _mm256_fmadd_ps(t, _mm256_sub_ps(b.z, a.z), a.z),
+        _mm256_fmadd_ps(t, _mm256_sub_ps(b.w, a.w), a.w),
+    };
+
+    const __m256 one = _mm256_set1_ps(1.0f);
+    __m256 length = _mm256_sqrt_ps(Dot8(r, r));
+    length = Select(_mm256_cmp_ps(length, _mm256_setzero_ps(), _CMP_EQ_OQ), one, length);
+    const __m256 inverse = _mm256_div_ps(one, length);
+
+    r.x = _mm256_mul_ps(r.x, inverse);
+    r.y = _mm256_mul_ps(r.y, inverse);
+    r.z = _mm256_mul_ps(r.z, inverse);
+    r.w = _mm256_mul_ps(r.w, inverse);
+    return r;
+}
+
+AVX2_TARGET static void QuaternionNlerpAVX2(const Quaternion *q1, const Quaternion *q2, Quaternion *out, int count, float amount)
+{
+    const __m256 t = _mm256_set1_ps(amount);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+        StoreQuat8(out + i, Nlerp8(LoadQuat8(q1 + i), LoadQuat8(q2 + i), t));
+
+    QuaternionNlerpSSE2(q1 + i, q2 + i, out + i, count - i, amount);
+}
+
+AVX2_TARGET static inline __m256 Acos8(__m256 x)
+{
+    __m256 p = _mm256_set1_ps(-0.0012624911f);
+    p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(0.0066700901f));
+    p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(-0.0170881256f));
+    p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(0.0308918810f));
+    p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(-0.0501743046f));
+    p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(0.0889789874f));
+    p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(-0.2145988016f));
+    p = _mm256_fmadd_ps(p, x, _mm256_set1_ps(1.5707963050f));
+    return _mm256_mul_ps(p, _mm256_sqrt_ps(_mm256_max_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), x), _mm256_setzero_ps())));
+}
+
+AVX2_TARGET static inline __m256 Sin8(__m256 x)
+{
+    const __m256 x2 = _mm256_mul_ps(x, x);
+    __m256 p = _mm256_set1_ps(-2.5052108e-8f);
+    p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(2.7557319e-6f));
+    p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(-1.9841270e-4f));
+    p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(8.3333333e-3f));
+    p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(-1.6666667e-1f));
+    p = _mm256_fmadd_ps(p, x2, _mm256_set1_ps(1.0f));
+    return _mm256_mul_ps(p, x);
+}
+
+AVX2_TARGET static void QuaternionSlerpAVX2(const Quaternion *q1, const Quaternion *q2, Quaternion *out, int count, float amount)
+{
+    const __m256 t = _mm256_set1_ps(amount);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        const Quat8 a = LoadQuat8(q1 + i);
+        Quat8 b = LoadQuat8(q2 + i);
+
+        __m256 cosHalfTheta = Dot8(a, b);
+        const __m256 flip = _mm256_and_ps(cosHalfTheta, signBit);
+        b = {_mm256_xor_ps(b.x, flip), _mm256_xor_ps(b.y, flip), _mm256_xor_ps(b.z, flip), _mm256_xor_ps(b.w, flip)};
+        cosHalfTheta = _mm256_xor_ps(cosHalfTheta, flip);
+
+        const __m256 halfTheta = Acos8(cosHalfTheta);
+        const __m256 sinHalfTheta = _mm256_sqrt_ps(_mm256_max_ps(_mm256_fnmadd_ps(cosHalfTheta, cosHalfTheta, one), _mm256_setzero_ps()));
+        const __m256 inverseSin = _mm256_div_ps(one, sinHalfTheta);
+        const __m256 ratioA = _mm256_mul_ps(Sin8(_mm256_mul_ps(_mm256_sub_ps(one, t), halfTheta)), inverseSin);
+        const __m256 ratioB = _mm256_mul_ps(Sin8(_mm256_mul_ps(t, halfTheta)), inverseSin);
+
+        const Quat8 n = Nlerp8(a, b, t);
+        const __m256 useA = _mm256_cmp_ps(cosHalfTheta, one, _CMP_GE_OQ);
+        const __m256 useNlerp = _mm256_cmp_ps(cosHalfTheta, _mm256_set1_ps(0.95f), _CMP_GT_OQ);
+
+        const Quat8 s = {
+            _mm256_fmadd_ps(a.x, ratioA, _mm256_mul_ps(b.x, ratioB)),
+            _mm256_fmadd_ps(a.y, ratioA, _mm256_mul_ps(b.y, ratioB)),
+            _mm256_fmadd_ps(a.z, ratioA, _mm256_mul_ps(b.z, ratioB)),
+            _mm256_fmadd_ps(a.w, ratioA, _mm256_mul_ps(b.w, ratioB)),
+        };
+
+        StoreQuat8(out + i, {
+            Select(useA, a.x, Select(useNlerp, n.x, s.x)),
+            Select(useA, a.y, Select(useNlerp, n.y, s.y)),
+            Select(useA, a.z, Select(useNlerp, n.z, s.z)),
+            Select(useA, a.w, Select(useNlerp, n.w, s.w)),
+        });
+    }
+
+    QuaternionSlerpSSE2(q1 + i, q2 + i, out + i, count - i, amount);
+}
+
+#endif
+
+// --- Dispatch ---
+
+GAME_API void Vector3TransformBatch(const Vector3 *points, Vector3 *out, int count, Matrix mat)
+{
+#if defined(BATCHMATH_USE_AVX2)
+    if (g_Level >= BATCHMATH_AVX2)
+        return Vector3TransformAVX2(points, out, count, mat);
+#endif
+#if defined(BATCHMATH_USE_SSE2)
+    if (g_Level >= BATCHMATH_SSE2)
+        return Vector3TransformSSE2(points, out, count, mat);
+#endif
+    for (int i = 0; i < count; i++)
+        out[i] = Vector3Transform(points[i], mat);
+}
+
+GAME_API void MatrixMultiplyBatch(const Matrix *left, const Matrix *right, Matrix *out, int count)
+{
+#if defined(BATCHMATH_USE_AVX2)
+    if (g_Level >= BATCHMATH_AVX2)
+        return MatrixMultiplyAVX2(left, right, out, count);
+#endif
+#if defined(BATCHMATH_USE_SSE2)
+    if (g_Level >= BATCHMATH_SSE2)
+        return MatrixMultiplySSE2(left, right, out, count);
+#endif
+    for (int i = 0; i < count; i++)
+        out[i] = MatrixMultiply(left[i], right[i]);
+}
+
+GAME_API void QuaternionNlerpBatch(const Quaternion *q1, const Quaternion *q2, Quaternion *out, int count, float amount)
+{
+#if defined(BATCHMATH_USE_AVX2)
+    if (g_Level >= BATCHMATH_AVX2)
+        return QuaternionNlerpAVX2(q1, q2, out, count, amount);
+#endif
+#if defined(BATCHMATH_USE_SSE2)
+    if (g_Level >= BATCHMATH_SSE2)
+        return QuaternionNlerpSSE2(q1, q2, out, count, amount);
+#endif
+    for (int i = 0; i < count; i++)
+        out[i] = QuaternionNlerp(q1[i], q2[i], amount);
+}
+
+GAME_API void QuaternionSlerpBatch(const Quaternion *q1, const Quaternion *q2, Quaternion *out, int count, float amount)
+{
+#if defined(BATCHMATH_USE_AVX2)
+    if (g_Level >= BATCHMATH_AVX2)
+        return QuaternionSlerpAVX2(q1, q2, out, count, amount);
+#endif
+#if defined(BATCHMATH_USE_SSE2)
+    if (g_Level >= BATCHMATH_SSE2)
+        return QuaternionSlerpSSE2(q1, q2, out, count, amount);
+#endif
+    for (int i = 0; i < count; i++)
+        out[i] = QuaternionSlerp(q1[i], q2[i], amount);
+}
+
+GAME_API void BoundingBoxTransformBatch(const BoundingBox *boxes, BoundingBox *out, int count, Matrix mat)
+{
+    // one box fills a 128-bit register, the SSE2 kernel is used for AVX2 as well
+#if defined(BATCHMATH_USE_SSE2)
+    if (g_Level >= BATCHMATH_SSE2)
+        return BoundingBoxTransformSSE2(boxes, out, count, mat);
+#endif
+    for (int i = 0; i < count; i++)
+        out[i] = BoundingBoxTransform(boxes[i], mat);
+}
+
+GAME_API int BatchMathGetLevel()
+{
+    return g_Level;
+}
+
+GAME_API int BatchMathSetLevel(int level)
+{
+    g_Level = std::clamp(level, static_cast<int>(BATCHMATH_SCALAR), g_SupportedLevel);
+    return g_Level;
+}
+
+void InitBatchMath()
+{
+#if defined(BATCHMATH_USE_AVX2)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        g_SupportedLevel = BATCHMATH_AVX2;
+    else
+        g_SupportedLevel = BATCHMATH_SSE2;
+#elif defined(BATCHMATH_USE_SSE2)
+    g_SupportedLevel = BATCHMATH_SSE2;
+#endif
+
+    g_Level = g_SupportedLevel;
+    TraceLog(LOG_INFO, "MATH: Using %s batch kernels", LevelName(g_Level));
+}
@@ -0,0 +1,35 @@
+#ifndef BATCHMATH_HPP
+#define BATCHMATH_HPP
+
+#include "api.hpp"
+
+#include <raylib/raylib.h>
+
+// Array-in/array-out versions of raymath functions. Kernels are picked at
+// runtime: AVX2+FMA, SSE2, or plain raymath as the scalar fallback.
+// out may be the same array as an input.
+enum BatchMathLevel
+{
+    BATCHMATH_SCALAR = 0,
+    BATCHMATH_SSE2 = 1,
+    BATCHMATH_AVX2 = 2,
+};
+
+// out[i] = Vector3Transform(points[i], mat)
+GAME_API void Vector3TransformBatch(const Vector3 *points, Vector3 *out, int count, Matrix mat);
+// out[i] = MatrixMultiply(left[i], right[i]), e.g. inverse bind pose * bone pose
+GAME_API void MatrixMultiplyBatch(const Matrix *left, const Matrix *right, Matrix *out, int count);
+// out[i] = QuaternionNlerp/Slerp(q1[i], q2[i], amount)
+GAME_API void QuaternionNlerpBatch(const Quaternion *q1, const Quaternion *q2, Quaternion *out, int count, float amount);
+GAME_API void QuaternionSlerpBatch(const Quaternion *q1, const Quaternion *q2, Quaternion *out, int count, float amount);
+// Axis-aligned bounds of each box after transforming it by mat
+GAME_API void BoundingBoxTransformBatch(const BoundingBox *boxes, BoundingBox *out, int count, Matrix mat);
+
+// Highest level the CPU supports, or the one forced with BatchMathSetLevel
+GAME_API int BatchMathGetLevel();
+// Forces a lower level (benchmarks, debugging), clamped to what the CPU supports
+GAME_API int BatchMathSetLevel(int level);
+
+void InitBatchMath();
+
+#endif
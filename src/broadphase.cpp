@@ -0,0 +1,520 @@
+#include "broadphase.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <raylib/raylib.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BROADPHASE_SSE2 1
+#endif
+
+static constexpr float DEFAULT_CELL_SIZE = 64.0f;
+static constexpr int MIN_PAIR_CAPACITY = 64;
+static constexpr int MIN_HASH_KEYS = 1024;
+// Objects covering more cells than this skip the hash and are tested against everyone
+static constexpr int MAX_CELLS_PER_OBJECT = 16;
+// Cell coordinates are clamped so far away objects cannot overflow them
+static constexpr float MAX_CELL_COORD = 1.0e9f;
+// Insertion sort moves allowed per object before sweep and prune re-sorts from scratch
+static constexpr int MAX_SORT_MOVES_PER_OBJECT = 8;
+
+//----------------------------------------------------------------------------------
+// Pair buffers
+//----------------------------------------------------------------------------------
+
+static bool Reserve(PairBuffer *buffer, int capacity)
+{
+    if (capacity <= buffer->capacity)
+        return true;
+
+    capacity = std::max({capacity, buffer->capacity * 2, MIN_PAIR_CAPACITY});
+    CollisionPair *grown = static_cast<CollisionPair *>(std::realloc(buffer->pairs, capacity * sizeof(CollisionPair)));
+    if (!grown)
+    {
+        TraceLog(LOG_ERROR, "BROADPHASE: Could not grow a pair buffer to %d pairs", capacity);
+        return false;
+    }
+
+    buffer->pairs = grown;
+    buffer->capacity = capacity;
+    return true;
+}
+
+static inline void PushPair(PairBuffer *buffer, int a, int b)
+{
+    if (buffer->count == buffer->capacity && !Reserve(buffer, buffer->count + 1))
+        return;
+    buffer->pairs[buffer->count++] = {std::min(a, b), std::max(a, b)};
+}
+
+GAME_API PairBuffer *PairBufferCreate(int capacity)
+{
+    PairBuffer *buffer = new PairBuffer{};
+    if (!Reserve(buffer, std::max(capacity, 1)))
+    {
+        delete buffer;
+        return nullptr;
+    }
+    return buffer;
+}
+
+GAME_API void PairBufferDestroy(PairBuffer *buffer)
+{
+    if (!buffer)
+        return;
+
+    std::free(buffer->pairs);
+    delete buffer;
+}
+
+//----------------------------------------------------------------------------------
+// Broadphase
+//----------------------------------------------------------------------------------
+
+struct CellRange
+{
+    int x0, y0, x1, y1;
+};
+
+struct HashEntry
+{
+    int object;
+    int cellX;
+    int cellY;
+    uint32_t key;
+};
+
+struct SweepEntry
+{
+    float minX, maxX, minY, maxY;
+    int object;
+};
+
+struct Broadphase
+{
+    int method;
+    float cellSize;
+
+    // spatial hash, rebuilt on every update
+    std::vector<CellRange> ranges;
+    std::vector<HashEntry> entries;
+    std::vector<HashEntry> sorted;
+    std::vector<int> keyStart;
+    std::vector<int> large;
+
+    // sweep and prune, kept sorted by minX between updates
+    std::vector<SweepEntry> sweep;
+    std::vector<float> sweepMinX;
+    std::vector<float> sweepMinY;
+    std::vector<float> sweepMaxY;
+};
+
+GAME_API Broadphase *BroadphaseCreate(int method, float cellSize)
+{
+    if (method != BROADPHASE_SPATIAL_HASH && method != BROADPHASE_SWEEP_AND_PRUNE)
+    {
+        TraceLog(LOG_ERROR, "BROADPHASE: Unknown method %d", method);
+        return nullptr;
+    }
+
+    Broadphase *broadphase = new Broadphase{};
+    broadphase->method = method;
+    broadphase->cellSize = cellSize;
+    return broadphase;
+}
+
+GAME_API void BroadphaseDestroy(Broadphase *broadphase)
+{
+    delete broadphase;
+}
+
+static int BoundsCount(const VectorBuffer *centers, const VectorBuffer *extents)
+{
+    if (!centers)
+        return 0;
+    return extents ? std::min(centers->count, extents->count) : centers->count;
+}
+
+// floor() without the libm call, NaN ends up in the lowest cell
+static inline int CellCoord(float value, float inverseCell)
+{
+    const float scaled = std::min(std::max(-MAX_CELL_COORD, value * inverseCell), MAX_CELL_COORD);
+    const int truncated = static_cast<int>(scaled);
+    return truncated - (scaled < static_cast<float>(truncated));
+}
+
+static inline uint32_t HashCell(int x, int y)
+{
+    return static_cast<uint32_t>(x) * 73856093u ^ static_cast<uint32_t>(y) * 19349663u;
+}
+
+// Two cells or more per average object, so most objects touch at most four
+static float AutomaticCellSize(const VectorBuffer *extents, int count)
+{
+    if (!extents || count == 0)
+        return DEFAULT_CELL_SIZE;
+
+    double sum = 0.0;
+    for (int i = 0; i < count; i++)
+        sum += std::max(extents->x[i], extents->y[i]);
+
+    const float size = static_cast<float>(4.0 * sum / count);
+    return size > 0.0f ? size : DEFAULT_CELL_SIZE;
+}
+
+static inline bool BoundsTouch(const VectorBuffer *centers, const VectorBuffer *extents, int a, int b)
+{
+    const float ex = extents ? extents->x[a] + extents->x[b] : 0.0f;
+    const float ey = extents ? extents->y[a] + extents->y[b] : 0.0f;
+    return std::fabs(centers->x[a] - centers->x[b]) <= ex && std::fabs(centers->y[a] - centers->y[b]) <= ey;
+}
+
+static void FindPairsHash(Broadphase *broadphase, const VectorBuffer *centers, const VectorBuffer *extents, int count, PairBuffer *pairs)
+{
+    const float cell = broadphase->cellSize > 0.0f ? broadphase->cellSize : AutomaticCellSize(extents, count);
+    const float inverseCell = 1.0f / cell;
+
+    // Cell ranges, objects that cover too many cells are handled separately
+    broadphase->ranges.resize(count);
+    broadphase->large.clear();
+    int total = 0;
+    int minX = INT_MAX, minY = INT_MAX, maxX = INT_MIN, maxY = INT_MIN;
+    for (int i = 0; i < count; i++)
+    {
+        const float ex = extents ? extents->x[i] : 0.0f;
+        const float ey = extents ? extents->y[i] : 0.0f;
+        CellRange &range = broadphase->ranges[i];
+        range = {CellCoord(centers->x[i] - ex, inverseCell), CellCoord(centers->y[i] - ey, inverseCell),
+                 CellCoord(centers->x[i] + ex, inverseCell), CellCoord(centers->y[i] + ey, inverseCell)};
+
+        const int64_t cells = (static_cast<int64_t>(range.x1) - range.x0 + 1) * (static_cast<int64_t>(range.y1) - range.y0 + 1);
+        if (cells > MAX_CELLS_PER_OBJECT)
+        {
+            broadphase->large.push_back(i);
+            range.x1 = range.x0 - 1; // marks the object as not hashed
+            continue;
+        }
+        total += static_cast<int>(cells);
+        minX = std::min(minX, range.x0);
+        minY = std::min(minY, range.y0);
+        maxX = std::max(maxX, range.x1);
+        maxY = std::max(maxY, range.y1);
+    }
+
+    // Keys index a dense grid over the occupied cells when it is not much
+    // bigger than the entry count (no collisions, neighbours stay close in
+    // memory), and a hash table otherwise
+    const int64_t width = static_cast<int64_t>(maxX) - minX + 1;
+    const int64_t height = static_cast<int64_t>(maxY) - minY + 1;
+    const bool dense = total > 0 && width * height <= std::max<int64_t>(static_cast<int64_t>(total) * 4, MIN_HASH_KEYS);
+    uint32_t keys = MIN_HASH_KEYS;
+    if (dense)
+        keys = static_cast<uint32_t>(width * height);
+    else
+        while (keys < static_cast<uint32_t>(total) * 2)
+            keys *= 2;
+    const uint32_t mask = keys - 1;
+
+    // One entry per covered cell, counting sorted by key
+    broadphase->entries.resize(total);
+    broadphase->sorted.resize(total);
+    broadphase->keyStart.assign(keys, 0);
+    int *start = broadphase->keyStart.data();
+    HashEntry *entries = broadphase->entries.data();
+    int k = 0;
+    for (int i = 0; i < count; i++)
+    {
+        const CellRange &range = broadphase->ranges[i];
+        for (int y = range.y0; y <= range.y1 && range.x1 >= range.x0; y++)
+        {
+            for (int x = range.x0; x <= range.x1; x++)
+            {
+                const uint32_t key = dense ? static_cast<uint32_t>((y - minY) * width + (x - minX)) : HashCell(x, y) & mask;
+                entries[k++] = {i, x, y, key};
+                start[key]++;
+            }
+        }
+    }
+
+    int offset = 0;
+    for (uint32_t key = 0; key < keys; key++)
+    {
+        const int size = start[key];
+        start[key] = offset;
+        offset += size;
+    }
+    HashEntry *sorted = broadphase->sorted.data();
+    for (int e = 0; e < total; e++)
+        sorted[start[entries[e].key]++] = entries[e];
+
+    // Runs of equal keys, mostly of one entry. A pair sharing several cells
+    // is reported only from the first cell of the overlap of their ranges.
+    const CellRange *ranges = broadphase->ranges.data();
+    for (int first = 0; first < total;)
+    {
+        int last = first + 1;
+        while (last < total && sorted[last].key == sorted[first].key)
+            last++;
+
+        for (int p = first; p < last; p++)
+        {
+            const HashEntry &entry = sorted[p];
+            for (int q = p + 1; q < last; q++)
+            {
+                const HashEntry &other = sorted[q];
+                if (other.cellX != entry.cellX || other.cellY != entry.cellY)
+                    continue;
+
+                const CellRange &ra = ranges[entry.object];
+                const CellRange &rb = ranges[other.object];
+                if (entry.cellX == std::max(ra.x0, rb.x0) && entry.cellY == std::max(ra.y0, rb.y0))
+                    PushPair(pairs, entry.object, other.object);
+            }
+        }
+        first = last;
+    }
+
+    // Large objects against everything touching them
+    for (size_t l = 0; l < broadphase->large.size(); l++)
+    {
+        const int a = broadphase->large[l];
+        for (int b = 0; b < count; b++)
+        {
+            const bool largeToo = ranges[b].x1 < ranges[b].x0;
+            // pairs of two large objects come from the one listed first
+            if (b == a || (largeToo && b < a))
+                continue;
+            if (BoundsTouch(centers, extents, a, b))
+                PushPair(pairs, a, b);
+        }
+    }
+}
+
+static void FillSweepEntry(SweepEntry &entry, const VectorBuffer *centers, const VectorBuffer *extents)
+{
+    const int i = entry.object;
+    const float ex = extents ? extents->x[i] : 0.0f;
+    const float ey = extents ? extents->y[i] : 0.0f;
+    entry.minX = centers->x[i] - ex;
+    entry.maxX = centers->x[i] + ex;
+    entry.minY = centers->y[i] - ey;
+    entry.maxY = centers->y[i] + ey;
+}
+
+static void FindPairsSweep(Broadphase *broadphase, const VectorBuffer *centers, const VectorBuffer *extents, int count, PairBuffer *pairs)
+{
+    std::vector<SweepEntry> &sweep = broadphase->sweep;
+    const auto byMinX = [](const SweepEntry &a, const SweepEntry &b) { return a.minX < b.minX; };
+
+    if (static_cast<int>(sweep.size()) != count)
+    {
+        sweep.resize(count);
+        for (int i = 0; i < count; i++)
+        {
+            sweep[i].object = i;
+            FillSweepEntry(sweep[i], centers, extents);
+        }
+        std::sort(sweep.begin(), sweep.end(), byMinX);
+    }
+    else
+    {
+        for (SweepEntry &entry : sweep)
+            FillSweepEntry(entry, centers, extents);
+
+        // Last update's order is almost right when objects move a little
+        int64_t moves = 0;
+        const int64_t maxMoves = static_cast<int64_t>(count) * MAX_SORT_MOVES_PER_OBJECT;
+        for (int i = 1; i < count; i++)
+        {
+            const SweepEntry entry = sweep[i];
+            int j = i;
+            while (j > 0 && sweep[j - 1].minX > entry.minX)
+            {
+                sweep[j] = sweep[j - 1];
+                j--;
+            }
+            sweep[j] = entry;
+
+            moves += i - j;
+            if (moves > maxMoves)
+            {
+                std::sort(sweep.begin(), sweep.end(), byMinX);
+                break;
+            }
+        }
+    }
+
+    // The sweep reads the sorted bounds as separate arrays, padded with
+    // entries that end it so it can always read four at a time
+    broadphase->sweepMinX.resize(count + 4);
+    broadphase->sweepMinY.resize(count + 4);
+    broadphase->sweepMaxY.resize(count + 4);
+    float *minX = broadphase->sweepMinX.data();
+    float *minY = broadphase->sweepMinY.data();
+    float *maxY = broadphase->sweepMaxY.data();
+    const SweepEntry *entries = sweep.data();
+    for (int i = 0; i < count; i++)
+    {
+        minX[i] = entries[i].minX;
+        minY[i] = entries[i].minY;
+        maxY[i] = entries[i].maxY;
+    }
+    for (int i = count; i < count + 4; i++)
+        minX[i] = minY[i] = maxY[i] = INFINITY;
+
+    for (int i = 0; i < count; i++)
+    {
+        const SweepEntry &entry = entries[i];
+#if defined(BROADPHASE_SSE2)
+        const __m128 endX = _mm_set1_ps(entry.maxX);
+        const __m128 top = _mm_set1_ps(entry.minY);
+        const __m128 bottom = _mm_set1_ps(entry.maxY);
+        for (int j = i + 1;; j += 4)
+        {
+            // minX is sorted, so the lanes still inside the sweep are a prefix
+            const __m128 inside = _mm_cmple_ps(_mm_loadu_ps(minX + j), endX);
+            const __m128 overlapY = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minY + j), bottom), _mm_cmpge_ps(_mm_loadu_ps(maxY + j), top));
+            for (int hits = _mm_movemask_ps(_mm_and_ps(inside, overlapY)), lane = 0; hits != 0; hits >>= 1, lane++)
+            {
+                if (hits & 1)
+                    PushPair(pairs, entry.object, entries[j + lane].object);
+            }
+            if (_mm_movemask_ps(inside) != 0xf)
+                break;
+        }
+#else
+        for (int j = i + 1; minX[j] <= entry.maxX; j++)
+        {
+            if (minY[j] <= entry.maxY && maxY[j] >= entry.minY)
+                PushPair(pairs, entry.object, entries[j].object);
+        }
+#endif
+    }
+}
+
+GAME_API int BroadphaseFindPairs(Broadphase *broadphase, const VectorBuffer *centers, const VectorBuffer *extents, PairBuffer *pairs)
+{
+    pairs->count = 0;
+    const int count = BoundsCount(centers, extents);
+    if (count < 2)
+        return 0;
+
+    if (broadphase->method == BROADPHASE_SPATIAL_HASH)
+        FindPairsHash(broadphase, centers, extents, count, pairs);
+    else
+        FindPairsSweep(broadphase, centers, extents, count, pairs);
+
+    return pairs->count;
+}
+
+//----------------------------------------------------------------------------------
+// Narrowphase
+//----------------------------------------------------------------------------------
+
+// Four pairs at a time: gather both ends, test, compact the survivors. The
+// pairs are read before anything is written, so contacts may alias candidates.
+template <typename Test4, typename Test1>
+static int FilterPairs(const PairBuffer *candidates, PairBuffer *contacts, Test4 test4, Test1 test1)
+{
+    const int count = candidates->count;
+    if (contacts != candidates && !Reserve(contacts, count))
+    {
+        contacts->count = 0;
+        return 0;
+    }
+
+    const CollisionPair *in = candidates->pairs;
+    CollisionPair *out = contacts->pairs;
+    int found = 0;
+
+    int i = 0;
+#if defined(BROADPHASE_SSE2)
+    for (; i + 4 <= count; i += 4)
+    {
+        const CollisionPair p[4] = {in[i], in[i + 1], in[i + 2], in[i + 3]};
+        int mask = test4(p);
+        for (int lane = 0; mask != 0; lane++, mask >>= 1)
+        {
+            if (mask & 1)
+                out[found++] = p[lane];
+        }
+    }
+#endif
+    for (; i < count; i++)
+    {
+        const CollisionPair p = in[i];
+        if (test1(p.a, p.b))
+            out[found++] = p;
+    }
+
+    contacts->count = found;
+    return found;
+}
+
+#if defined(BROADPHASE_SSE2)
+static inline __m128 Gather4(const float *values, const CollisionPair *p, bool first)
+{
+    return first ? _mm_set_ps(values[p[3].a], values[p[2].a], values[p[1].a], values[p[0].a])
+                 : _mm_set_ps(values[p[3].b], values[p[2].b], values[p[1].b], values[p[0].b]);
+}
+
+static inline __m128 Abs4(__m128 v)
+{
+    return _mm_and_ps(v, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)));
+}
+#endif
+
+GAME_API int CollideRects(const VectorBuffer *centers, const VectorBuffer *extents, const PairBuffer *candidates, PairBuffer *contacts)
+{
+    const float *xs = centers->x, *ys = centers->y;
+    const float *exs = extents ? extents->x : nullptr, *eys = extents ? extents->y : nullptr;
+
+    // Same as CheckCollisionRecs: the distance between centers is below the summed half sizes
+    const auto test1 = [=](int a, int b) {
+        const float ex = exs ? exs[a] + exs[b] : 0.0f;
+        const float ey = eys ? eys[a] + eys[b] : 0.0f;
+        return std::fabs(xs[a] - xs[b]) < ex && std::fabs(ys[a] - ys[b]) < ey;
+    };
+#if defined(BROADPHASE_SSE2)
+    const auto test4 = [=](const CollisionPair *p) {
+        const __m128 dx = Abs4(_mm_sub_ps(Gather4(xs, p, true), Gather4(xs, p, false)));
+        const __m128 dy = Abs4(_mm_sub_ps(Gather4(ys, p, true), Gather4(ys, p, false)));
+        const __m128 ex = exs ? _mm_add_ps(Gather4(exs, p, true), Gather4(exs, p, false)) : _mm_setzero_ps();
+        const __m128 ey = eys ? _mm_add_ps(Gather4(eys, p, true), Gather4(eys, p, false)) : _mm_setzero_ps();
+        return _mm_movemask_ps(_mm_and_ps(_mm_cmplt_ps(dx, ex), _mm_cmplt_ps(dy, ey)));
+    };
+#else
+    const auto test4 = [](const CollisionPair *) { return 0; };
+#endif
+
+    return FilterPairs(candidates, contacts, test4, test1);
+}
+
+GAME_API int CollideCircles(const VectorBuffer *centers, const VectorBuffer *radii, const PairBuffer *candidates, PairBuffer *contacts)
+{
+    const float *xs = centers->x, *ys = centers->y, *rs = radii->x;
+
+    // Same as CheckCollisionCircles, compared squared
+    const auto test1 = [=](int a, int b) {
+        const float dx = xs[a] - xs[b], dy = ys[a] - ys[b], r = rs[a] + rs[b];
+        return dx * dx + dy * dy <= r * r;
+    };
+#if defined(BROADPHASE_SSE2)
+    const auto test4 = [=](const CollisionPair *p) {
+        const __m128 dx = _mm_sub_ps(Gather4(xs, p, true), Gather4(xs, p, false));
+        const __m128 dy = _mm_sub_ps(Gather4(ys, p, true), Gather4(ys, p, false));
+        const __m128 r = _mm_add_ps(Gather4(rs, p, true), Gather4(rs, p, false));
+        return _mm_movemask_ps(_mm_cmple_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(r, r)));
+    };
+#else
+    const auto test4 = [](const CollisionPair *) { return 0; };
+#endif
+
+    return FilterPairs(candidates, contacts, test4, test1);
+}
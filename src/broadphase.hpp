@@ -0,0 +1,52 @@
+#ifndef BROADPHASE_HPP
+#define BROADPHASE_HPP
+
+#include "api.hpp"
+#include "soa.hpp"
+
+// 2D collision pair finding over SoA bounds: centers plus half extents, both
+// VectorBuffers (z is ignored). The broadphase reports candidate pairs whose
+// bounds may overlap; the narrowphase functions filter them down to contacts.
+struct CollisionPair
+{
+    int a; // a < b
+    int b;
+};
+
+// Reusable pair list, grown natively when a query needs more room
+struct PairBuffer
+{
+    CollisionPair *pairs;
+    int count;
+    int capacity;
+};
+
+GAME_API PairBuffer *PairBufferCreate(int capacity);
+GAME_API void PairBufferDestroy(PairBuffer *buffer);
+
+enum BroadphaseMethod
+{
+    // Objects are hashed into every cell they touch; rebuilt every update in O(n)
+    BROADPHASE_SPATIAL_HASH = 0,
+    // Objects are kept sorted along x between updates, so coherent motion
+    // costs an almost free insertion sort; best when objects spread along x
+    BROADPHASE_SWEEP_AND_PRUNE = 1,
+};
+
+struct Broadphase;
+
+// cellSize is only used by the spatial hash, <= 0 picks one from the extents
+GAME_API Broadphase *BroadphaseCreate(int method, float cellSize);
+GAME_API void BroadphaseDestroy(Broadphase *broadphase);
+// Replaces the contents of pairs with the candidates for the current bounds,
+// returns how many there are (each pair appears once)
+GAME_API int BroadphaseFindPairs(Broadphase *broadphase, const VectorBuffer *centers, const VectorBuffer *extents, PairBuffer *pairs);
+
+// Narrowphase: keeps the candidates that really collide, in order. contacts
+// may be the candidate buffer itself. Rectangles collide like
+// CheckCollisionRecs (touching edges do not count), circles like
+// CheckCollisionCircles with the radius taken from radii->x.
+GAME_API int CollideRects(const VectorBuffer *centers, const VectorBuffer *extents, const PairBuffer *candidates, PairBuffer *contacts);
+GAME_API int CollideCircles(const VectorBuffer *centers, const VectorBuffer *radii, const PairBuffer *candidates, PairBuffer *contacts);
+
+#endif
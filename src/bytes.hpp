@@ -0,0 +1,48 @@
+#ifndef BYTES_HPP
+#define BYTES_HPP
+
+#include <cstdint>
+#include <cstring>
+
+// Little-endian field access for the cooked asset formats
+
+inline uint16_t ReadU16(const unsigned char *bytes)
+{
+    return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+inline int32_t ReadI32(const unsigned char *bytes)
+{
+    return static_cast<int32_t>(static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+                                (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24));
+}
+
+inline float ReadF32(const unsigned char *bytes)
+{
+    const int32_t bits = ReadI32(bytes);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline void WriteU16(unsigned char *bytes, uint16_t value)
+{
+    bytes[0] = static_cast<unsigned char>(value);
+    bytes[1] = static_cast<unsigned char>(value >> 8);
+}
+
+inline void WriteI32(unsigned char *bytes, int32_t value)
+{
+    const uint32_t bits = static_cast<uint32_t>(value);
+    for (int i = 0; i < 4; i++)
+        bytes[i] = static_cast<unsigned char>(bits >> (8 * i));
+}
+
+inline void WriteF32(unsigned char *bytes, float value)
+{
+    int32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    WriteI32(bytes, bits);
+}
+
+#endif
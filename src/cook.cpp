@@ -0,0 +1,461 @@
+// Offline asset cooker, run by `./build.sh cook` before packaging.
+//
+//   cook <source dir> <output dir> [--font-sizes 16,32] [--sdf-size 32] [--max-sound-seconds 10]
+//        [--no-mipmaps] [--premultiply] [--atlas-dirs sprites] [--atlas-size 2048]
+//
+// Mirrors the source tree into the output directory and writes a runtime-ready
+// sibling next to every asset it understands:
+//   images  -> .rtex  pixels in their final format, mipmapped (texture.hpp)
+//   fonts   -> .<size>.rfnt  glyph table and atlas per font size (cooked.hpp)
+//              .sdf.rfnt     signed distance field atlas for every size, 0 --sdf-size skips it
+//   sounds  -> .rwav  PCM, only clips up to --max-sound-seconds so music keeps streaming
+//   atlas directories (--atlas-dirs, relative to the source dir) -> <dir>.ratl
+//            every image below them packed into shared pages (atlas.hpp), no .rtex
+// The Lua loaders pick the cooked file when it exists. Sources are kept so raylib
+// functions that load files on their own still find them. Files in the output
+// directory that the run did not write or find up to date (their source was
+// deleted, or a sound grew too long) are removed. Sounds too long to cook leave
+// an empty marker in <output dir>.skipped, so they are not decoded again until
+// they change.
+
+#include "atlas.hpp"
+#include "cooked.hpp"
+#include "texture.hpp"
+
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cctype>
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+
+#include <raylib/raylib.h>
+
+namespace fs = std::filesystem;
+
+struct CookOptions
+{
+    std::vector<int> fontSizes = {16, 32};
+    int sdfSize = FONT_SDF_BASE_SIZE;
+    float maxSoundSeconds = 10.0f;
+    bool mipmaps = true;
+    bool premultiply = false;
+    std::vector<std::string> atlasDirs = {"sprites"};
+    int atlasSize = 2048;
+};
+
+struct CookStats
+{
+    int cooked = 0;
+    int upToDate = 0;
+    int skipped = 0;
+    int failed = 0;
+};
+
+// Where one run writes
+struct CookOutput
+{
+    fs::path root;              // mirrors the source dir
+    fs::path skippedRoot;       // <root>.skipped, markers for sounds too long to cook, never packed
+    std::set<fs::path> files;   // written or up to date, the rest of root and skippedRoot is pruned
+};
+
+static const std::set<std::string> IMAGE_EXTENSIONS = {".png", ".bmp", ".tga", ".jpg", ".jpeg", ".gif", ".qoi",
+                                                        ".psd", ".hdr", ".dds", ".pkm", ".ktx", ".pvr", ".astc"};
+static const std::set<std::string> FONT_EXTENSIONS = {".ttf", ".otf"};
+static const std::set<std::string> SOUND_EXTENSIONS = {".wav", ".ogg", ".mp3", ".flac", ".qoa"};
+
+static bool IsUpToDate(const fs::path &source, const fs::path &output)
+{
+    std::error_code error;
+    const auto outputTime = fs::last_write_time(output, error);
+    return !error && outputTime >= fs::last_write_time(source);
+}
+
+static bool CookImage(const fs::path &source, const fs::path &output, const CookOptions &options)
+{
+    Image image = LoadImage(source.string().c_str());
+    if (!image.data)
+        return false;
+
+    unsigned int flags = 0;
+    const bool compressed = image.format >= PIXELFORMAT_COMPRESSED_DXT1_RGB;
+    if (!compressed)
+    {
+        if (options.premultiply)
+        {
+            ImageAlphaPremultiply(&image);
+            flags |= TEXTURE_PAYLOAD_PREMULTIPLIED;
+        }
+        if (options.mipmaps)
+            ImageMipmaps(&image);
+    }
+
+    const bool exported = ExportTexturePayload(image, flags, output.string().c_str());
+    UnloadImage(image);
+    return exported;
+}
+
+// A negative fontSize cooks the distance field atlas at -fontSize
+static bool CookFont(const fs::path &source, const fs::path &output, int fontSize)
+{
+    int dataSize = 0;
+    unsigned char *data = LoadFileData(source.string().c_str(), &dataSize);
+    if (!data)
+        return false;
+
+    const bool exported = fontSize > 0 ? ExportFontCooked(data, dataSize, fontSize, output.string().c_str())
+                                       : ExportFontCookedSdf(data, dataSize, -fontSize, output.string().c_str());
+    UnloadFileData(data);
+    return exported;
+}
+
+// Returns false on failure, sets skipped for clips too long to keep in memory as PCM
+static bool CookSound(const fs::path &source, const fs::path &output, const CookOptions &options, bool &skipped)
+{
+    Wave wave = LoadWave(source.string().c_str());
+    if (!wave.data)
+        return false;
+
+    skipped = wave.frameCount > options.maxSoundSeconds * wave.sampleRate;
+    const bool exported = skipped || ExportWaveCooked(wave, output.string().c_str());
+    UnloadWave(wave);
+    return exported;
+}
+
+static void Keep(CookOutput &out, const fs::path &file)
+{
+    out.files.insert(file.lexically_normal());
+}
+
+static bool WriteMarker(const fs::path &marker)
+{
+    std::error_code error;
+    fs::create_directories(marker.parent_path(), error);
+    FILE *file = fopen(marker.string().c_str(), "wb");
+    if (!file)
+        return false;
+    fclose(file);
+    return true;
+}
+
+static void CookFile(const fs::path &source, const fs::path &outputDir, const CookOptions &options, CookOutput &out,
+                     CookStats &stats)
+{
+    std::string extension = source.extension().string();
+    for (char &c : extension)
+        c = static_cast<char>(tolower(c));
+
+    // (cooked output, font size) pairs, font size 0 for everything but fonts, negative for SDF
+    std::vector<std::pair<fs::path, int>> outputs;
+    const fs::path stem = outputDir / source.stem();
+    if (IMAGE_EXTENSIONS.count(extension))
+        outputs.push_back({fs::path(stem).concat(".rtex"), 0});
+    else if (FONT_EXTENSIONS.count(extension))
+    {
+        for (int size : options.fontSizes)
+            outputs.push_back({fs::path(stem).concat("." + std::to_string(size) + ".rfnt"), size});
+        if (options.sdfSize > 0)
+            outputs.push_back({fs::path(stem).concat(".sdf.rfnt"), -options.sdfSize});
+    }
+    else if (SOUND_EXTENSIONS.count(extension))
+        outputs.push_back({fs::path(stem).concat(".rwav"), 0});
+
+    for (const auto &[output, fontSize] : outputs)
+    {
+        const fs::path marker = out.skippedRoot / output.lexically_relative(out.root);
+        if (IsUpToDate(source, output) || IsUpToDate(source, marker))
+        {
+            Keep(out, fs::exists(output) ? output : marker);
+            stats.upToDate++;
+            continue;
+        }
+
+        bool skipped = false;
+        bool cooked = false;
+        if (IMAGE_EXTENSIONS.count(extension))
+            cooked = CookImage(source, output, options);
+        else if (FONT_EXTENSIONS.count(extension))
+            cooked = CookFont(source, output, fontSize);
+        else
+            cooked = CookSound(source, output, options, skipped);
+
+        if (!cooked)
+        {
+            TraceLog(LOG_WARNING, "COOK: Failed to cook %s", source.string().c_str());
+            stats.failed++;
+        }
+        else if (skipped)
+        {
+            if (WriteMarker(marker))
+                Keep(out, marker);
+            stats.skipped++;
+        }
+        else
+        {
+            TraceLog(LOG_INFO, "COOK: %s -> %s", source.string().c_str(), output.filename().string().c_str());
+            Keep(out, output);
+            stats.cooked++;
+        }
+    }
+}
+
+// Packs the images below one atlas directory; those that cannot go in a page
+// (compressed, or too large) are cooked on their own instead
+static void CookAtlas(const fs::path &sourceDir, const fs::path &outputDir, const std::string &atlasDir,
+                      const std::vector<fs::path> &sources, const CookOptions &options, CookOutput &out,
+                      CookStats &stats)
+{
+    const fs::path output = fs::path(outputDir / atlasDir).concat(".ratl");
+
+    // Adding or removing a sprite touches its directory, not the other sprites
+    bool upToDate = true;
+    for (const fs::path &source : sources)
+        upToDate = upToDate && IsUpToDate(source, output) && IsUpToDate(source.parent_path(), output);
+    if (upToDate)
+    {
+        Keep(out, output);
+        stats.upToDate++;
+
+        // Sprites cooked on their own last time still have their .rtex, keep them too
+        for (const fs::path &source : sources)
+        {
+            const fs::path spriteDir = (outputDir / fs::relative(source, sourceDir)).parent_path();
+            if (fs::exists(fs::path(spriteDir / source.stem()).concat(".rtex")))
+                CookFile(source, spriteDir, options, out, stats);
+        }
+        return;
+    }
+
+    std::vector<Image> images;
+    std::vector<std::string> names;
+    std::set<std::string> packed;
+    for (const fs::path &source : sources)
+    {
+        Image image = LoadImage(source.string().c_str());
+        if (!image.data || image.format >= PIXELFORMAT_COMPRESSED_DXT1_RGB ||
+            image.width + 2 * ATLAS_SPRITE_BORDER > options.atlasSize ||
+            image.height + 2 * ATLAS_SPRITE_BORDER > options.atlasSize)
+        {
+            UnloadImage(image);
+            CookFile(source, (outputDir / fs::relative(source, sourceDir)).parent_path(), options, out, stats);
+            continue;
+        }
+
+        // "ui/button" for sprites/ui/button.png
+        const std::string name = fs::relative(source, sourceDir / atlasDir).replace_extension().generic_string();
+        if (!packed.insert(name).second)
+        {
+            TraceLog(LOG_WARNING, "COOK: %s: sprite %s already packed from another file", source.string().c_str(),
+                     name.c_str());
+            UnloadImage(image);
+            continue;
+        }
+
+        ImageFormat(&image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        images.push_back(image);
+        names.push_back(name);
+    }
+
+    if (!images.empty())
+    {
+        std::vector<const char *> namePointers;
+        for (const std::string &name : names)
+            namePointers.push_back(name.c_str());
+
+        const unsigned int flags = options.premultiply ? TEXTURE_PAYLOAD_PREMULTIPLIED : 0;
+        if (ExportTextureAtlas(images.data(), namePointers.data(), static_cast<int>(images.size()), options.atlasSize,
+                               flags, output.string().c_str()))
+        {
+            TraceLog(LOG_INFO, "COOK: %d sprites -> %s", static_cast<int>(images.size()),
+                     output.filename().string().c_str());
+            Keep(out, output);
+            stats.cooked++;
+        }
+        else
+        {
+            TraceLog(LOG_WARNING, "COOK: Failed to pack %s", atlasDir.c_str());
+            stats.failed++;
+        }
+    }
+
+    for (Image &image : images)
+        UnloadImage(image);
+}
+
+// Removes the files below root the run did not keep, then the directories left empty
+static int Prune(const fs::path &root, const std::set<fs::path> &files)
+{
+    if (!fs::is_directory(root))
+        return 0;
+
+    std::vector<fs::path> stale;
+    std::vector<fs::path> dirs;
+    for (const auto &entry : fs::recursive_directory_iterator(root))
+    {
+        if (entry.is_directory())
+            dirs.push_back(entry.path());
+        else if (!files.count(entry.path().lexically_normal()))
+            stale.push_back(entry.path());
+    }
+
+    std::error_code error;
+    for (const fs::path &file : stale)
+    {
+        TraceLog(LOG_INFO, "COOK: Removing stale %s", file.string().c_str());
+        fs::remove(file, error);
+    }
+
+    // Deepest first, so emptied parents go too
+    std::sort(dirs.begin(), dirs.end(), [](const fs::path &a, const fs::path &b) { return a.native().size() > b.native().size(); });
+    for (const fs::path &dir : dirs)
+    {
+        if (fs::is_empty(dir, error))
+            fs::remove(dir, error);
+    }
+    return static_cast<int>(stale.size());
+}
+
+// The atlas directory an image belongs to, empty if none
+static std::string FindAtlasDir(const fs::path &relative, const CookOptions &options)
+{
+    for (const std::string &atlasDir : options.atlasDirs)
+    {
+        const fs::path dir = fs::path(atlasDir).lexically_normal();
+        const auto dirEnd = std::mismatch(dir.begin(), dir.end(), relative.begin(), relative.end()).first;
+        if (dirEnd == dir.end())
+            return atlasDir;
+    }
+    return {};
+}
+
+// Directory list, without trailing slashes
+static std::vector<std::string> ParseDirs(const char *text)
+{
+    std::vector<std::string> items;
+    for (const char *c = text; *c;)
+    {
+        const char *end = strchr(c, ',');
+        const size_t length = end ? static_cast<size_t>(end - c) : strlen(c);
+        size_t trimmed = length;
+        while (trimmed > 0 && (c[trimmed - 1] == '/' || c[trimmed - 1] == '\\'))
+            trimmed--;
+        if (trimmed > 0)
+            items.emplace_back(c, trimmed);
+        c += end ? length + 1 : length;
+    }
+    return items;
+}
+
+static std::vector<int> ParseSizes(const char *text)
+{
+    std::vector<int> sizes;
+    for (const char *c = text; *c;)
+    {
+        char *end = nullptr;
+        const long size = strtol(c, &end, 10);
+        if (end == c)
+            break;
+        if (size > 0)
+            sizes.push_back(static_cast<int>(size));
+        c = *end == ',' ? end + 1 : end;
+    }
+    return sizes;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: %s <source dir> <output dir> [--font-sizes 16,32] [--sdf-size 32] [--max-sound-seconds 10] "
+                        "[--no-mipmaps] [--premultiply] [--atlas-dirs sprites] [--atlas-size 2048]\n",
+                argv[0]);
+        return 1;
+    }
+
+    CookOptions options;
+    for (int i = 3; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--font-sizes") == 0 && i + 1 < argc)
+            options.fontSizes = ParseSizes(argv[++i]);
+        else if (strcmp(argv[i], "--sdf-size") == 0 && i + 1 < argc)
+            options.sdfSize = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--max-sound-seconds") == 0 && i + 1 < argc)
+            options.maxSoundSeconds = static_cast<float>(atof(argv[++i]));
+        else if (strcmp(argv[i], "--no-mipmaps") == 0)
+            options.mipmaps = false;
+        else if (strcmp(argv[i], "--premultiply") == 0)
+            options.premultiply = true;
+        else if (strcmp(argv[i], "--atlas-dirs") == 0 && i + 1 < argc)
+            options.atlasDirs = ParseDirs(argv[++i]);
+        else if (strcmp(argv[i], "--atlas-size") == 0 && i + 1 < argc)
+            options.atlasSize = atoi(argv[++i]);
+        else
+        {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    SetTraceLogLevel(LOG_WARNING);
+
+    const fs::path sourceDir = argv[1];
+    const fs::path outputDir = argv[2];
+    if (!fs::is_directory(sourceDir))
+    {
+        TraceLog(LOG_ERROR, "COOK: %s is not a directory", sourceDir.string().c_str());
+        return 1;
+    }
+
+    CookOutput out;
+    out.root = outputDir.lexically_normal();
+    if (!out.root.has_filename())
+        out.root = out.root.parent_path();
+    out.skippedRoot = fs::path(out.root).concat(".skipped");
+
+    CookStats stats;
+    int copied = 0;
+    std::map<std::string, std::vector<fs::path>> atlases;
+    for (const auto &entry : fs::recursive_directory_iterator(sourceDir))
+    {
+        if (!entry.is_regular_file())
+            continue;
+
+        const fs::path relative = fs::relative(entry.path(), sourceDir);
+        const fs::path output = out.root / relative;
+        fs::create_directories(output.parent_path());
+
+        if (!IsUpToDate(entry.path(), output))
+        {
+            fs::copy_file(entry.path(), output, fs::copy_options::overwrite_existing);
+            copied++;
+        }
+        Keep(out, output);
+
+        std::string extension = relative.extension().string();
+        for (char &c : extension)
+            c = static_cast<char>(tolower(c));
+        const std::string atlasDir = IMAGE_EXTENSIONS.count(extension) ? FindAtlasDir(relative, options) : "";
+        if (!atlasDir.empty())
+            atlases[atlasDir].push_back(entry.path());
+        else
+            CookFile(entry.path(), output.parent_path(), options, out, stats);
+    }
+
+    // Sorted so the packing does not depend on directory iteration order
+    for (auto &[atlasDir, sources] : atlases)
+    {
+        std::sort(sources.begin(), sources.end());
+        CookAtlas(sourceDir, out.root, atlasDir, sources, options, out, stats);
+    }
+
+    const int removed = Prune(out.root, out.files) + Prune(out.skippedRoot, out.files);
+
+    printf("cook: %d cooked, %d up to date, %d too long to cook, %d failed, %d sources copied, %d stale removed\n",
+           stats.cooked, stats.upToDate, stats.skipped, stats.failed, copied, removed);
+    return stats.failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,265 @@
+#include "cooked.hpp"
+#include "texture.hpp"
+#include "bytes.hpp"
+
+#include <cstring>
+#include <vector>
+
+static constexpr char COOKED_WAVE_MAGIC[4] = {'R', 'W', 'A', 'V'};
+static constexpr char COOKED_FONT_MAGIC[4] = {'R', 'F', 'N', 'T'};
+static constexpr int COOKED_GLYPH_SIZE = 32;
+
+// raylib's LoadFontFromMemory defaults
+static constexpr int FONT_GLYPH_COUNT = 95;
+static constexpr int FONT_GLYPH_PADDING = 4;
+
+bool CheckCookedHeader(const unsigned char *fileData, int fileSize, const char (&magic)[4], int version, const char *fileName)
+{
+    if (fileSize < COOKED_HEADER_SIZE || memcmp(fileData, magic, sizeof(magic)) != 0)
+    {
+        TraceLog(LOG_WARNING, "COOK: %s is not a cooked %.4s file", fileName, magic);
+        return false;
+    }
+
+    if (ReadU16(fileData + 4) != version)
+    {
+        TraceLog(LOG_WARNING, "COOK: %s has unsupported version %d", fileName, ReadU16(fileData + 4));
+        return false;
+    }
+
+    return true;
+}
+
+GAME_API bool ExportWaveCooked(Wave wave, const char *fileName)
+{
+    const int64_t dataSize = static_cast<int64_t>(wave.frameCount) * wave.channels * (wave.sampleSize / 8);
+    if (!wave.data || dataSize <= 0 || dataSize > INT32_MAX - COOKED_HEADER_SIZE || !fileName)
+    {
+        TraceLog(LOG_WARNING, "COOK: Invalid wave for %s", fileName ? fileName : "");
+        return false;
+    }
+
+    std::vector<unsigned char> file(COOKED_HEADER_SIZE + static_cast<size_t>(dataSize));
+    memcpy(file.data(), COOKED_WAVE_MAGIC, sizeof(COOKED_WAVE_MAGIC));
+    WriteU16(file.data() + 4, COOKED_WAVE_VERSION);
+    WriteU16(file.data() + 6, 0);
+    WriteI32(file.data() + 8, static_cast<int32_t>(wave.frameCount));
+    WriteI32(file.data() + 12, static_cast<int32_t>(wave.sampleRate));
+    WriteI32(file.data() + 16, static_cast<int32_t>(wave.sampleSize));
+    WriteI32(file.data() + 20, static_cast<int32_t>(wave.channels));
+    WriteI32(file.data() + 24, static_cast<int32_t>(dataSize));
+    WriteI32(file.data() + 28, 0);
+    memcpy(file.data() + COOKED_HEADER_SIZE, wave.data, dataSize);
+
+    return SaveFileData(fileName, file.data(), static_cast<int>(file.size()));
+}
+
+GAME_API Wave LoadWaveCooked(const char *fileName)
+{
+    int fileSize = 0;
+    unsigned char *fileData = LoadFileData(fileName, &fileSize);
+    if (!fileData)
+        return {};
+
+    if (!CheckCookedHeader(fileData, fileSize, COOKED_WAVE_MAGIC, COOKED_WAVE_VERSION, fileName))
+    {
+        UnloadFileData(fileData);
+        return {};
+    }
+
+    Wave wave = {};
+    wave.frameCount = ReadI32(fileData + 8);
+    wave.sampleRate = ReadI32(fileData + 12);
+    wave.sampleSize = ReadI32(fileData + 16);
+    wave.channels = ReadI32(fileData + 20);
+    const int dataSize = ReadI32(fileData + 24);
+
+    const int64_t expectedSize = static_cast<int64_t>(wave.frameCount) * wave.channels * (wave.sampleSize / 8);
+    if (dataSize <= 0 || dataSize != expectedSize || dataSize > fileSize - COOKED_HEADER_SIZE)
+    {
+        TraceLog(LOG_WARNING, "COOK: Corrupt cooked wave %s", fileName);
+        UnloadFileData(fileData);
+        return {};
+    }
+
+    // Shift the samples over the header and keep the buffer, no copy
+    memmove(fileData, fileData + COOKED_HEADER_SIZE, dataSize);
+    wave.data = MemRealloc(fileData, dataSize);
+    return wave;
+}
+
+// Glyph table followed by the atlas
+static bool WriteFontCooked(const GlyphInfo *glyphs, const Rectangle *recs, const Image &atlas, int baseSize, int glyphPadding,
+                            unsigned int flags, const char *fileName)
+{
+    std::vector<unsigned char> file(COOKED_HEADER_SIZE + FONT_GLYPH_COUNT * COOKED_GLYPH_SIZE);
+    memcpy(file.data(), COOKED_FONT_MAGIC, sizeof(COOKED_FONT_MAGIC));
+    WriteU16(file.data() + 4, COOKED_FONT_VERSION);
+    WriteU16(file.data() + 6, static_cast<uint16_t>(flags));
+    WriteI32(file.data() + 8, baseSize);
+    WriteI32(file.data() + 12, FONT_GLYPH_COUNT);
+    WriteI32(file.data() + 16, glyphPadding);
+
+    for (int i = 0; i < FONT_GLYPH_COUNT; i++)
+    {
+        unsigned char *glyph = file.data() + COOKED_HEADER_SIZE + i * COOKED_GLYPH_SIZE;
+        WriteI32(glyph + 0, glyphs[i].value);
+        WriteI32(glyph + 4, glyphs[i].offsetX);
+        WriteI32(glyph + 8, glyphs[i].offsetY);
+        WriteI32(glyph + 12, glyphs[i].advanceX);
+        WriteF32(glyph + 16, recs[i].x);
+        WriteF32(glyph + 20, recs[i].y);
+        WriteF32(glyph + 24, recs[i].width);
+        WriteF32(glyph + 28, recs[i].height);
+    }
+
+    return AppendTexturePayload(atlas, 0, file) && SaveFileData(fileName, file.data(), static_cast<int>(file.size()));
+}
+
+GAME_API bool ExportFontCooked(const unsigned char *fileData, int dataSize, int fontSize, const char *fileName)
+{
+    if (!fileData || dataSize <= 0 || fontSize <= 0 || !fileName)
+        return false;
+
+    GlyphInfo *glyphs = LoadFontData(fileData, dataSize, fontSize, nullptr, FONT_GLYPH_COUNT, FONT_DEFAULT);
+    if (!glyphs)
+    {
+        TraceLog(LOG_WARNING, "COOK: Failed to rasterize font for %s", fileName);
+        return false;
+    }
+
+    Rectangle *recs = nullptr;
+    Image atlas = GenImageFontAtlas(glyphs, &recs, FONT_GLYPH_COUNT, fontSize, FONT_GLYPH_PADDING, 0);
+    const bool written = WriteFontCooked(glyphs, recs, atlas, fontSize, FONT_GLYPH_PADDING, 0, fileName);
+
+    UnloadImage(atlas);
+    MemFree(recs);
+    UnloadFontData(glyphs, FONT_GLYPH_COUNT);
+    return written;
+}
+
+// Distance field glyphs as raylib's FONT_SDF renders them (stb_truetype, 4 px of
+// padding baked into each glyph), packed without extra padding. The atlas keeps
+// only the distances: GenImageFontAtlas puts them in alpha under white.
+static GlyphInfo *BakeFontSdf(const unsigned char *fileData, int dataSize, int baseSize, Rectangle **recs, Image *atlas)
+{
+    GlyphInfo *glyphs = LoadFontData(fileData, dataSize, baseSize, nullptr, FONT_GLYPH_COUNT, FONT_SDF);
+    if (!glyphs)
+        return nullptr;
+
+    Image packed = GenImageFontAtlas(glyphs, recs, FONT_GLYPH_COUNT, baseSize, 0, 1);
+    ImageFormat(&packed, PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA);
+
+    const int pixelCount = packed.width * packed.height;
+    unsigned char *distances = static_cast<unsigned char *>(MemAlloc(pixelCount));
+    const unsigned char *grayAlpha = static_cast<const unsigned char *>(packed.data);
+    for (int i = 0; i < pixelCount; i++)
+        distances[i] = grayAlpha[i * 2 + 1];
+
+    *atlas = {distances, packed.width, packed.height, 1, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE};
+    UnloadImage(packed);
+    return glyphs;
+}
+
+GAME_API bool ExportFontCookedSdf(const unsigned char *fileData, int dataSize, int baseSize, const char *fileName)
+{
+    if (!fileData || dataSize <= 0 || baseSize <= 0 || !fileName)
+        return false;
+
+    Rectangle *recs = nullptr;
+    Image atlas = {};
+    GlyphInfo *glyphs = BakeFontSdf(fileData, dataSize, baseSize, &recs, &atlas);
+    if (!glyphs)
+    {
+        TraceLog(LOG_WARNING, "COOK: Failed to render distance fields for %s", fileName);
+        return false;
+    }
+
+    const bool written = WriteFontCooked(glyphs, recs, atlas, baseSize, 0, COOKED_FONT_SDF, fileName);
+
+    UnloadImage(atlas);
+    MemFree(recs);
+    UnloadFontData(glyphs, FONT_GLYPH_COUNT);
+    return written;
+}
+
+GAME_API Font LoadFontCooked(const char *fileName)
+{
+    int fileSize = 0;
+    unsigned char *fileData = LoadFileData(fileName, &fileSize);
+    if (!fileData)
+        return {};
+
+    Font font = {};
+    if (!CheckCookedHeader(fileData, fileSize, COOKED_FONT_MAGIC, COOKED_FONT_VERSION, fileName))
+    {
+        UnloadFileData(fileData);
+        return font;
+    }
+
+    const int glyphCount = ReadI32(fileData + 12);
+    const int64_t tableEnd = COOKED_HEADER_SIZE + static_cast<int64_t>(glyphCount) * COOKED_GLYPH_SIZE;
+    TexturePayload atlas;
+    if (glyphCount <= 0 || tableEnd > fileSize ||
+        !TexturePayloadParse(fileData + tableEnd, fileSize - static_cast<int>(tableEnd), &atlas) ||
+        atlas.format >= PIXELFORMAT_COMPRESSED_DXT1_RGB)
+    {
+        TraceLog(LOG_WARNING, "COOK: Corrupt cooked font %s", fileName);
+        UnloadFileData(fileData);
+        return font;
+    }
+
+    font.baseSize = ReadI32(fileData + 8);
+    font.glyphCount = glyphCount;
+    font.glyphPadding = ReadI32(fileData + 16);
+    font.glyphs = static_cast<GlyphInfo *>(MemAlloc(glyphCount * sizeof(GlyphInfo)));
+    font.recs = static_cast<Rectangle *>(MemAlloc(glyphCount * sizeof(Rectangle)));
+
+    // Glyph images are cut from the atlas the same way LoadFontFromMemory does,
+    // so ImageDrawText and friends keep working with cooked fonts
+    Image atlasView = {const_cast<unsigned char *>(atlas.data), atlas.width, atlas.height, 1, atlas.format};
+    for (int i = 0; i < glyphCount; i++)
+    {
+        const unsigned char *glyph = fileData + COOKED_HEADER_SIZE + i * COOKED_GLYPH_SIZE;
+        font.glyphs[i].value = ReadI32(glyph + 0);
+        font.glyphs[i].offsetX = ReadI32(glyph + 4);
+        font.glyphs[i].offsetY = ReadI32(glyph + 8);
+        font.glyphs[i].advanceX = ReadI32(glyph + 12);
+        font.recs[i] = {ReadF32(glyph + 16), ReadF32(glyph + 20), ReadF32(glyph + 24), ReadF32(glyph + 28)};
+        font.glyphs[i].image = ImageFromImage(atlasView, font.recs[i]);
+    }
+
+    font.texture = LoadTextureFromPayload(&atlas);
+    if ((ReadU16(fileData + 6) & COOKED_FONT_SDF) && font.texture.id != 0)
+        SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+    UnloadFileData(fileData);
+    return font;
+}
+
+GAME_API Font LoadFontSdfFromMemory(const char *fileType, const unsigned char *fileData, int dataSize, int baseSize)
+{
+    (void)fileType;
+    if (!fileData || dataSize <= 0)
+        return {};
+    if (baseSize <= 0)
+        baseSize = FONT_SDF_BASE_SIZE;
+
+    Font font = {};
+    Image atlas = {};
+    font.glyphs = BakeFontSdf(fileData, dataSize, baseSize, &font.recs, &atlas);
+    if (!font.glyphs)
+    {
+        TraceLog(LOG_WARNING, "FONT: Failed to render distance fields");
+        return {};
+    }
+
+    font.baseSize = baseSize;
+    font.glyphCount = FONT_GLYPH_COUNT;
+    if (IsWindowReady())
+    {
+        font.texture = LoadTextureFromImage(atlas);
+        SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+    }
+    UnloadImage(atlas);
+    return font;
+}
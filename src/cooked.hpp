@@ -0,0 +1,46 @@
+#ifndef COOKED_HPP
+#define COOKED_HPP
+
+#include "api.hpp"
+
+#include <raylib/raylib.h>
+
+// Runtime-ready forms of sounds and fonts written by the cook tool (src/cook.cpp).
+// Loading them is a file read plus a header check, see texture.hpp for textures.
+//
+// .rwav  "RWAV" u16 version, u16 flags, i32 frameCount, sampleRate, sampleSize,
+//        channels, dataSize, reserved; then the interleaved PCM samples
+// .rfnt  "RFNT" u16 version, u16 flags, i32 baseSize, glyphCount, glyphPadding,
+//        3 x reserved; then glyphCount x { i32 value, offsetX, offsetY, advanceX,
+//        f32 rec x, y, width, height }; then the atlas as an embedded .rtex
+//        flags COOKED_FONT_SDF: the atlas is a single channel signed distance
+//        field (0.5 on the outline), drawn at any size with LoadFontSdfShader
+//
+// All fields are little-endian.
+constexpr int COOKED_WAVE_VERSION = 1;
+constexpr int COOKED_FONT_VERSION = 1;
+constexpr int COOKED_HEADER_SIZE = 32;
+
+constexpr unsigned int COOKED_FONT_SDF = 1;
+// Glyph size the distance fields are rendered at when none is given
+constexpr int FONT_SDF_BASE_SIZE = 32;
+
+// Checks magic and version of a cooked file, logs why it is rejected
+bool CheckCookedHeader(const unsigned char *fileData, int fileSize, const char (&magic)[4], int version, const char *fileName);
+
+GAME_API bool ExportWaveCooked(Wave wave, const char *fileName);
+// The file buffer becomes the sample data, nothing is decoded
+GAME_API Wave LoadWaveCooked(const char *fileName);
+
+// Rasterizes a TTF/OTF at fontSize (default 95 ASCII glyphs) and writes glyph table and atlas
+GAME_API bool ExportFontCooked(const unsigned char *fileData, int dataSize, int fontSize, const char *fileName);
+// Same with signed distance field glyphs rendered at baseSize, one atlas for every draw size
+GAME_API bool ExportFontCookedSdf(const unsigned char *fileData, int dataSize, int baseSize, const char *fileName);
+// Texture id is 0 without a window, like raylib's own font loaders. SDF atlases
+// get bilinear filtering.
+GAME_API Font LoadFontCooked(const char *fileName);
+// Bakes the SDF font at load time when there is no cooked one (dev builds);
+// fileType is unused, TTF and OTF both work. baseSize 0 picks FONT_SDF_BASE_SIZE.
+GAME_API Font LoadFontSdfFromMemory(const char *fileType, const unsigned char *fileData, int dataSize, int baseSize);
+
+#endif
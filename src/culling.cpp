@@ -0,0 +1,746 @@
+#include "culling.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <raylib/rlgl.h>
+
+#define RAYMATH_STATIC_INLINE
+#include <raylib/raymath.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CULL_SSE2 1
+#endif
+
+static constexpr float DEFAULT_CELL_SIZE = 64.0f;
+// Grids never get more cells than this many per object (plus a fixed floor),
+// the cell size is doubled until they fit
+static constexpr int GRID_CELLS_PER_OBJECT = 4;
+static constexpr int GRID_MIN_CELLS = 1 << 16;
+
+static constexpr int BVH_LEAF_SIZE = 8;
+static constexpr int BVH_MAX_DEPTH = 64;
+static constexpr int ALL_PLANES = 0x3F;
+
+// Objects both buffers describe, 0 when they are missing or have too few components
+static int ObjectCount(const VectorBuffer *centers, const VectorBuffer *extents, int components)
+{
+    if (!centers || centers->components < components)
+        return 0;
+    if (!extents)
+        return centers->count;
+    if (extents->components < components)
+        return 0;
+    return std::min(centers->count, extents->count);
+}
+
+static inline float Extent(const float *extents, int i)
+{
+    return extents ? extents[i] : 0.0f;
+}
+
+static inline bool RectVisible(float minX, float minY, float maxX, float maxY, const Rectangle &view)
+{
+    return minX <= view.x + view.width && maxX >= view.x && minY <= view.y + view.height && maxY >= view.y;
+}
+
+// Box given as center and half extents against the planes in mask; the order
+// of operations matches BoxVisible4 so both give the same answer
+static inline bool BoxVisible(const Frustum &frustum, int mask, float cx, float cy, float cz, float ex, float ey, float ez)
+{
+    for (int p = 0; p < 6; p++)
+    {
+        if (!(mask & (1 << p)))
+            continue;
+
+        const Vector4 &plane = frustum.planes[p];
+        const float distance = plane.x * cx + plane.y * cy + plane.z * cz + plane.w;
+        const float radius = std::fabs(plane.x) * ex + std::fabs(plane.y) * ey + std::fabs(plane.z) * ez;
+        if (distance + radius < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+#if defined(CULL_SSE2)
+static inline __m128 Abs4(__m128 v)
+{
+    return _mm_and_ps(v, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)));
+}
+
+static inline int BoxVisible4(const Frustum &frustum, __m128 cx, __m128 cy, __m128 cz, __m128 ex, __m128 ey, __m128 ez)
+{
+    __m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    for (int p = 0; p < 6; p++)
+    {
+        const Vector4 &plane = frustum.planes[p];
+        const __m128 a = _mm_set1_ps(plane.x), b = _mm_set1_ps(plane.y), c = _mm_set1_ps(plane.z);
+        const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a, cx), _mm_mul_ps(b, cy)), _mm_mul_ps(c, cz)), _mm_set1_ps(plane.w));
+        const __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(Abs4(a), ex), _mm_mul_ps(Abs4(b), ey)), _mm_mul_ps(Abs4(c), ez));
+        visible = _mm_and_ps(visible, _mm_cmpge_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+    }
+    return _mm_movemask_ps(visible);
+}
+
+static inline int RectVisible4(__m128 minX, __m128 minY, __m128 maxX, __m128 maxY, __m128 viewMinX, __m128 viewMinY, __m128 viewMaxX, __m128 viewMaxY)
+{
+    const __m128 x = _mm_and_ps(_mm_cmple_ps(minX, viewMaxX), _mm_cmpge_ps(maxX, viewMinX));
+    const __m128 y = _mm_and_ps(_mm_cmple_ps(minY, viewMaxY), _mm_cmpge_ps(maxY, viewMinY));
+    return _mm_movemask_ps(_mm_and_ps(x, y));
+}
+#endif
+
+// Appends base + lane for every set lane, mapped through ids when given
+static inline int EmitLanes(int mask, int base, const int *ids, int *indices, int found, int maxIndices)
+{
+    for (int lane = 0; mask != 0 && found < maxIndices; lane++, mask >>= 1)
+    {
+        if (mask & 1)
+            indices[found++] = ids ? ids[base + lane] : base + lane;
+    }
+    return found;
+}
+
+//----------------------------------------------------------------------------------
+// Cameras
+//----------------------------------------------------------------------------------
+
+GAME_API Frustum FrustumFromMatrix(Matrix m)
+{
+    // Rows of the matrix as it multiplies column vectors (what the shaders see)
+    const Vector4 rows[4] = {
+        {m.m0, m.m4, m.m8, m.m12},
+        {m.m1, m.m5, m.m9, m.m13},
+        {m.m2, m.m6, m.m10, m.m14},
+        {m.m3, m.m7, m.m11, m.m15},
+    };
+
+    Frustum frustum = {};
+    for (int i = 0; i < 3; i++)
+    {
+        frustum.planes[i * 2] = {rows[3].x + rows[i].x, rows[3].y + rows[i].y, rows[3].z + rows[i].z, rows[3].w + rows[i].w};
+        frustum.planes[i * 2 + 1] = {rows[3].x - rows[i].x, rows[3].y - rows[i].y, rows[3].z - rows[i].z, rows[3].w - rows[i].w};
+    }
+
+    for (Vector4 &plane : frustum.planes)
+    {
+        const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (length > 0.0f)
+            plane = {plane.x / length, plane.y / length, plane.z / length, plane.w / length};
+    }
+    return frustum;
+}
+
+GAME_API Frustum FrustumFromCamera(Camera3D camera, float aspect, float nearPlane, float farPlane)
+{
+    const double nearDistance = nearPlane > 0.0f ? nearPlane : RL_CULL_DISTANCE_NEAR;
+    const double farDistance = farPlane > 0.0f ? farPlane : RL_CULL_DISTANCE_FAR;
+
+    Matrix projection;
+    if (camera.projection == CAMERA_ORTHOGRAPHIC)
+    {
+        const double top = camera.fovy / 2.0;
+        const double right = top * aspect;
+        projection = MatrixOrtho(-right, right, -top, top, nearDistance, farDistance);
+    }
+    else
+    {
+        const double top = nearDistance * tan(camera.fovy * 0.5 * DEG2RAD);
+        const double right = top * aspect;
+        projection = MatrixFrustum(-right, right, -top, top, nearDistance, farDistance);
+    }
+
+    const Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+    return FrustumFromMatrix(MatrixMultiply(view, projection));
+}
+
+GAME_API Rectangle ViewRectFromCamera2D(Camera2D camera, float width, float height)
+{
+    const Vector2 corners[4] = {{0.0f, 0.0f}, {width, 0.0f}, {0.0f, height}, {width, height}};
+
+    Vector2 min = GetScreenToWorld2D(corners[0], camera);
+    Vector2 max = min;
+    for (int i = 1; i < 4; i++)
+    {
+        const Vector2 corner = GetScreenToWorld2D(corners[i], camera);
+        min = Vector2Min(min, corner);
+        max = Vector2Max(max, corner);
+    }
+    return {min.x, min.y, max.x - min.x, max.y - min.y};
+}
+
+//----------------------------------------------------------------------------------
+// Linear scans
+//----------------------------------------------------------------------------------
+
+GAME_API int CullRects(const VectorBuffer *centers, const VectorBuffer *extents, Rectangle view, int *indices, int maxIndices)
+{
+    const int count = ObjectCount(centers, extents, 2);
+    const float *xs = centers ? centers->x : nullptr;
+    const float *ys = centers ? centers->y : nullptr;
+    const float *exs = extents ? extents->x : nullptr;
+    const float *eys = extents ? extents->y : nullptr;
+    int found = 0;
+
+    int i = 0;
+#if defined(CULL_SSE2)
+    const __m128 viewMinX = _mm_set1_ps(view.x), viewMaxX = _mm_set1_ps(view.x + view.width);
+    const __m128 viewMinY = _mm_set1_ps(view.y), viewMaxY = _mm_set1_ps(view.y + view.height);
+    for (; i + 4 <= count && found < maxIndices; i += 4)
+    {
+        const __m128 x = _mm_load_ps(xs + i), y = _mm_load_ps(ys + i);
+        const __m128 ex = exs ? _mm_load_ps(exs + i) : _mm_setzero_ps();
+        const __m128 ey = eys ? _mm_load_ps(eys + i) : _mm_setzero_ps();
+        const int mask = RectVisible4(_mm_sub_ps(x, ex), _mm_sub_ps(y, ey), _mm_add_ps(x, ex), _mm_add_ps(y, ey),
+                                      viewMinX, viewMinY, viewMaxX, viewMaxY);
+        found = EmitLanes(mask, i, nullptr, indices, found, maxIndices);
+    }
+#endif
+    for (; i < count && found < maxIndices; i++)
+    {
+        const float ex = Extent(exs, i), ey = Extent(eys, i);
+        if (RectVisible(xs[i] - ex, ys[i] - ey, xs[i] + ex, ys[i] + ey, view))
+            indices[found++] = i;
+    }
+
+    return found;
+}
+
+GAME_API int CullBoxes(const VectorBuffer *centers, const VectorBuffer *extents, const Frustum *frustum, int *indices, int maxIndices)
+{
+    const int count = ObjectCount(centers, extents, 3);
+    int found = 0;
+
+    int i = 0;
+#if defined(CULL_SSE2)
+    for (; i + 4 <= count && found < maxIndices; i += 4)
+    {
+        const __m128 ex = extents ? _mm_load_ps(extents->x + i) : _mm_setzero_ps();
+        const __m128 ey = extents ? _mm_load_ps(extents->y + i) : _mm_setzero_ps();
+        const __m128 ez = extents ? _mm_load_ps(extents->z + i) : _mm_setzero_ps();
+        const int mask = BoxVisible4(*frustum, _mm_load_ps(centers->x + i), _mm_load_ps(centers->y + i), _mm_load_ps(centers->z + i), ex, ey, ez);
+        found = EmitLanes(mask, i, nullptr, indices, found, maxIndices);
+    }
+#endif
+    for (; i < count && found < maxIndices; i++)
+    {
+        if (BoxVisible(*frustum, ALL_PLANES, centers->x[i], centers->y[i], centers->z[i],
+                       Extent(extents ? extents->x : nullptr, i), Extent(extents ? extents->y : nullptr, i), Extent(extents ? extents->z : nullptr, i)))
+            indices[found++] = i;
+    }
+
+    return found;
+}
+
+//----------------------------------------------------------------------------------
+// Uniform grid
+//----------------------------------------------------------------------------------
+
+struct GridBounds
+{
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+};
+
+struct CullGrid
+{
+    float cellSize;     // requested
+    float cell;         // in use, larger when the requested size needs too many cells
+    float originX;
+    float originY;
+    int columns;
+    int rows;
+    float maxExtentX;
+    float maxExtentY;
+
+    std::vector<int> cellStart; // first slot of every cell, row major, plus an end marker
+    std::vector<int> ids;       // object index of every slot
+    std::vector<GridBounds> bounds;
+    std::vector<int> cellOf;
+};
+
+GAME_API CullGrid *CullGridCreate(float cellSize)
+{
+    CullGrid *grid = new CullGrid{};
+    grid->cellSize = cellSize > 0.0f ? cellSize : DEFAULT_CELL_SIZE;
+    return grid;
+}
+
+GAME_API void CullGridDestroy(CullGrid *grid)
+{
+    delete grid;
+}
+
+GAME_API bool CullGridBuild(CullGrid *grid, const VectorBuffer *centers, const VectorBuffer *extents)
+{
+    const int count = ObjectCount(centers, extents, 2);
+    grid->columns = 0;
+    grid->rows = 0;
+    grid->ids.clear();
+    if (count == 0)
+        return centers != nullptr;
+
+    const float *xs = centers->x;
+    const float *ys = centers->y;
+    const float *exs = extents ? extents->x : nullptr;
+    const float *eys = extents ? extents->y : nullptr;
+
+    float minX = xs[0], maxX = xs[0], minY = ys[0], maxY = ys[0];
+    float maxExtentX = 0.0f, maxExtentY = 0.0f;
+    for (int i = 0; i < count; i++)
+    {
+        minX = std::min(minX, xs[i]);
+        maxX = std::max(maxX, xs[i]);
+        minY = std::min(minY, ys[i]);
+        maxY = std::max(maxY, ys[i]);
+        maxExtentX = std::max(maxExtentX, Extent(exs, i));
+        maxExtentY = std::max(maxExtentY, Extent(eys, i));
+    }
+
+    if (!std::isfinite(maxX - minX) || !std::isfinite(maxY - minY))
+    {
+        TraceLog(LOG_WARNING, "CULL: Grid bounds are not finite, nothing was binned");
+        return false;
+    }
+
+    const int64_t maxCells = std::max<int64_t>(static_cast<int64_t>(count) * GRID_CELLS_PER_OBJECT, GRID_MIN_CELLS);
+    float cell = grid->cellSize;
+    int64_t columns, rows;
+    for (;;)
+    {
+        columns = static_cast<int64_t>((maxX - minX) / cell) + 1;
+        rows = static_cast<int64_t>((maxY - minY) / cell) + 1;
+        if (columns * rows <= maxCells)
+            break;
+        cell *= 2.0f;
+    }
+
+    grid->cell = cell;
+    grid->originX = minX;
+    grid->originY = minY;
+    grid->columns = static_cast<int>(columns);
+    grid->rows = static_cast<int>(rows);
+    grid->maxExtentX = maxExtentX;
+    grid->maxExtentY = maxExtentY;
+
+    // Counting sort of the objects into their cells
+    const int cells = grid->columns * grid->rows;
+    grid->cellStart.assign(cells + 1, 0);
+    grid->cellOf.resize(count);
+    const float inverseCell = 1.0f / cell;
+    for (int i = 0; i < count; i++)
+    {
+        const int column = std::min(static_cast<int>((xs[i] - minX) * inverseCell), grid->columns - 1);
+        const int row = std::min(static_cast<int>((ys[i] - minY) * inverseCell), grid->rows - 1);
+        const int c = row * grid->columns + column;
+        grid->cellOf[i] = c;
+        grid->cellStart[c + 1]++;
+    }
+    for (int c = 0; c < cells; c++)
+        grid->cellStart[c + 1] += grid->cellStart[c];
+
+    grid->ids.resize(count);
+    grid->bounds.resize(count);
+
+    // cellStart[c] serves as the write cursor of cell c, which leaves it at
+    // the start of cell c + 1; shifted back into place afterwards. The bounds
+    // of a slot sit together so scattering them costs one cache miss
+    for (int i = 0; i < count; i++)
+    {
+        const int slot = grid->cellStart[grid->cellOf[i]]++;
+        const float ex = Extent(exs, i), ey = Extent(eys, i);
+        grid->ids[slot] = i;
+        grid->bounds[slot] = {xs[i] - ex, ys[i] - ey, xs[i] + ex, ys[i] + ey};
+    }
+    for (int c = cells; c > 0; c--)
+        grid->cellStart[c] = grid->cellStart[c - 1];
+    grid->cellStart[0] = 0;
+
+    return true;
+}
+
+// Tests the slots [first, last), which all lie in one row of cells
+static int QueryRange(const CullGrid *grid, int first, int last, Rectangle view, int *indices, int found, int maxIndices)
+{
+    const GridBounds *bounds = grid->bounds.data();
+
+    int slot = first;
+#if defined(CULL_SSE2)
+    const __m128 viewMinX = _mm_set1_ps(view.x), viewMaxX = _mm_set1_ps(view.x + view.width);
+    const __m128 viewMinY = _mm_set1_ps(view.y), viewMaxY = _mm_set1_ps(view.y + view.height);
+    for (; slot + 4 <= last && found < maxIndices; slot += 4)
+    {
+        // Four slots in, four bounds components out
+        __m128 b0 = _mm_loadu_ps(&bounds[slot].minX), b1 = _mm_loadu_ps(&bounds[slot + 1].minX);
+        __m128 b2 = _mm_loadu_ps(&bounds[slot + 2].minX), b3 = _mm_loadu_ps(&bounds[slot + 3].minX);
+        _MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+        const int mask = RectVisible4(b0, b1, b2, b3, viewMinX, viewMinY, viewMaxX, viewMaxY);
+        found = EmitLanes(mask, slot, grid->ids.data(), indices, found, maxIndices);
+    }
+#endif
+    for (; slot < last && found < maxIndices; slot++)
+    {
+        if (RectVisible(bounds[slot].minX, bounds[slot].minY, bounds[slot].maxX, bounds[slot].maxY, view))
+            indices[found++] = grid->ids[slot];
+    }
+
+    return found;
+}
+
+GAME_API int CullGridQuery(const CullGrid *grid, Rectangle view, int *indices, int maxIndices)
+{
+    if (grid->columns == 0)
+        return 0;
+
+    // Objects are binned by center, so widen the view by the largest extent
+    const float inverseCell = 1.0f / grid->cell;
+    const float left = (view.x - grid->maxExtentX - grid->originX) * inverseCell;
+    const float right = (view.x + view.width + grid->maxExtentX - grid->originX) * inverseCell;
+    const float top = (view.y - grid->maxExtentY - grid->originY) * inverseCell;
+    const float bottom = (view.y + view.height + grid->maxExtentY - grid->originY) * inverseCell;
+    if (right < 0.0f || bottom < 0.0f || left >= grid->columns || top >= grid->rows)
+        return 0;
+
+    const int firstColumn = std::max(static_cast<int>(left), 0);
+    const int lastColumn = std::min(static_cast<int>(right), grid->columns - 1);
+    const int firstRow = std::max(static_cast<int>(top), 0);
+    const int lastRow = std::min(static_cast<int>(bottom), grid->rows - 1);
+
+    int found = 0;
+    for (int row = firstRow; row <= lastRow && found < maxIndices; row++)
+    {
+        const int first = grid->cellStart[row * grid->columns + firstColumn];
+        const int last = grid->cellStart[row * grid->columns + lastColumn + 1];
+        found = QueryRange(grid, first, last, view, indices, found, maxIndices);
+    }
+
+    return found;
+}
+
+//----------------------------------------------------------------------------------
+// Bounding volume hierarchy
+//----------------------------------------------------------------------------------
+
+// Leaves hold count > 0 slots starting at leftFirst. Inner nodes have their
+// left child right after them and the right child at leftFirst.
+struct BvhNode
+{
+    float min[3];
+    int leftFirst;
+    float max[3];
+    int count;
+};
+
+struct BvhObject
+{
+    float center[3];
+    float extent[3];
+};
+
+struct CullBvh
+{
+    std::vector<BvhNode> nodes;
+    std::vector<int> ids;            // object index of every slot
+    std::vector<int> slots;          // slot of every object
+    std::vector<BvhObject> objects;  // slot order
+    int count;
+};
+
+GAME_API CullBvh *CullBvhCreate()
+{
+    return new CullBvh{};
+}
+
+GAME_API void CullBvhDestroy(CullBvh *bvh)
+{
+    delete bvh;
+}
+
+// Copies the bounds into slot order, reading the buffers front to back so
+// only the writes land out of order
+static void GatherBounds(CullBvh *bvh, const VectorBuffer *centers, const VectorBuffer *extents)
+{
+    for (int i = 0; i < bvh->count; i++)
+    {
+        BvhObject &object = bvh->objects[bvh->slots[i]];
+        object.center[0] = centers->x[i];
+        object.center[1] = centers->y[i];
+        object.center[2] = centers->z[i];
+        object.extent[0] = extents ? extents->x[i] : 0.0f;
+        object.extent[1] = extents ? extents->y[i] : 0.0f;
+        object.extent[2] = extents ? extents->z[i] : 0.0f;
+    }
+}
+
+// Children come after their parent, so walking backwards sees them first
+static void RefitNodes(CullBvh *bvh)
+{
+    for (int n = static_cast<int>(bvh->nodes.size()) - 1; n >= 0; n--)
+    {
+        BvhNode &node = bvh->nodes[n];
+        if (node.count > 0)
+        {
+            float lo[3] = {INFINITY, INFINITY, INFINITY};
+            float hi[3] = {-INFINITY, -INFINITY, -INFINITY};
+            for (int slot = node.leftFirst; slot < node.leftFirst + node.count; slot++)
+            {
+                const BvhObject &object = bvh->objects[slot];
+                for (int a = 0; a < 3; a++)
+                {
+                    lo[a] = std::min(lo[a], object.center[a] - object.extent[a]);
+                    hi[a] = std::max(hi[a], object.center[a] + object.extent[a]);
+                }
+            }
+            memcpy(node.min, lo, sizeof(lo));
+            memcpy(node.max, hi, sizeof(hi));
+        }
+        else
+        {
+            const BvhNode &left = bvh->nodes[n + 1];
+            const BvhNode &right = bvh->nodes[node.leftFirst];
+            for (int a = 0; a < 3; a++)
+            {
+                node.min[a] = std::min(left.min[a], right.min[a]);
+                node.max[a] = std::max(left.max[a], right.max[a]);
+            }
+        }
+    }
+}
+
+// Spreads the low 10 bits of v so there are two zero bits between each
+static inline uint32_t SpreadBits(uint32_t v)
+{
+    v = (v | (v << 16)) & 0x030000FFu;
+    v = (v | (v << 8)) & 0x0300F00Fu;
+    v = (v | (v << 4)) & 0x030C30C3u;
+    v = (v | (v << 2)) & 0x09249249u;
+    return v;
+}
+
+// LSD radix sort of (morton code << 32 | object) keys by their code
+static void SortByCode(std::vector<uint64_t> &keys, std::vector<uint64_t> &scratch)
+{
+    const int count = static_cast<int>(keys.size());
+    scratch.resize(count);
+
+    int histograms[4][256] = {};
+    for (const uint64_t key : keys)
+    {
+        for (int pass = 0; pass < 4; pass++)
+            histograms[pass][(key >> (32 + 8 * pass)) & 0xFF]++;
+    }
+
+    for (int pass = 0; pass < 4; pass++)
+    {
+        int *histogram = histograms[pass];
+        const int shift = 32 + 8 * pass;
+        if (histogram[(keys[0] >> shift) & 0xFF] == count)
+            continue;
+
+        int offset = 0;
+        for (int bucket = 0; bucket < 256; bucket++)
+        {
+            const int bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+
+        for (const uint64_t key : keys)
+            scratch[histogram[(key >> shift) & 0xFF]++] = key;
+        keys.swap(scratch);
+    }
+}
+
+// Splits [first, first + count) of the sorted codes where their highest
+// differing bit flips, or in the middle when all codes are the same
+static int BuildNode(CullBvh *bvh, const std::vector<uint64_t> &keys, int first, int count)
+{
+    const int index = static_cast<int>(bvh->nodes.size());
+    bvh->nodes.push_back({});
+
+    if (count <= BVH_LEAF_SIZE)
+    {
+        bvh->nodes[index].leftFirst = first;
+        bvh->nodes[index].count = count;
+        return index;
+    }
+
+    const int last = first + count - 1;
+    const uint32_t firstCode = static_cast<uint32_t>(keys[first] >> 32);
+    const uint32_t lastCode = static_cast<uint32_t>(keys[last] >> 32);
+
+    int middle = first + count / 2;
+    if (firstCode != lastCode)
+    {
+        // Highest bit where the range differs; the codes that have it set come last
+        uint32_t bit = 1u << 31;
+        while (!((firstCode ^ lastCode) & bit))
+            bit >>= 1;
+
+        int low = first, high = last;
+        while (low < high)
+        {
+            const int probe = (low + high) / 2;
+            if (static_cast<uint32_t>(keys[probe] >> 32) & bit)
+                high = probe;
+            else
+                low = probe + 1;
+        }
+        middle = low;
+    }
+
+    BuildNode(bvh, keys, first, middle - first);
+    const int right = BuildNode(bvh, keys, middle, first + count - middle);
+    bvh->nodes[index].leftFirst = right;
+    bvh->nodes[index].count = 0;
+    return index;
+}
+
+// Objects are ordered along a Morton curve of their centers, then the tree
+// is cut along the bits of the curve: O(n) apart from the recursion
+GAME_API bool CullBvhBuild(CullBvh *bvh, const VectorBuffer *centers, const VectorBuffer *extents)
+{
+    const int count = ObjectCount(centers, extents, 3);
+    bvh->nodes.clear();
+    bvh->count = count;
+    if (count == 0)
+        return centers != nullptr && centers->components == 3;
+
+    float lo[3] = {INFINITY, INFINITY, INFINITY};
+    float hi[3] = {-INFINITY, -INFINITY, -INFINITY};
+    const float *axes[3] = {centers->x, centers->y, centers->z};
+    for (int a = 0; a < 3; a++)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            lo[a] = std::min(lo[a], axes[a][i]);
+            hi[a] = std::max(hi[a], axes[a][i]);
+        }
+    }
+
+    float scale[3];
+    for (int a = 0; a < 3; a++)
+        scale[a] = (hi[a] > lo[a]) ? 1023.0f / (hi[a] - lo[a]) : 0.0f;
+
+    std::vector<uint64_t> keys(count), scratch;
+    for (int i = 0; i < count; i++)
+    {
+        uint32_t code = 0;
+        for (int a = 0; a < 3; a++)
+        {
+            const float cell = std::min(std::max((axes[a][i] - lo[a]) * scale[a], 0.0f), 1023.0f);
+            code |= SpreadBits(static_cast<uint32_t>(cell)) << (2 - a);
+        }
+        keys[i] = (static_cast<uint64_t>(code) << 32) | static_cast<uint32_t>(i);
+    }
+    SortByCode(keys, scratch);
+
+    bvh->ids.resize(count);
+    bvh->slots.resize(count);
+    for (int slot = 0; slot < count; slot++)
+    {
+        bvh->ids[slot] = static_cast<int>(keys[slot] & 0xFFFFFFFFu);
+        bvh->slots[bvh->ids[slot]] = slot;
+    }
+
+    bvh->nodes.reserve(static_cast<size_t>(count / BVH_LEAF_SIZE + 1) * 4);
+    BuildNode(bvh, keys, 0, count);
+
+    bvh->objects.resize(count);
+    GatherBounds(bvh, centers, extents);
+    RefitNodes(bvh);
+    return true;
+}
+
+GAME_API bool CullBvhRefit(CullBvh *bvh, const VectorBuffer *centers, const VectorBuffer *extents)
+{
+    if (ObjectCount(centers, extents, 3) != bvh->count)
+        return false;
+
+    GatherBounds(bvh, centers, extents);
+    RefitNodes(bvh);
+    return true;
+}
+
+// Clears the bits of planes the node is fully inside of, -1 when it is outside one
+static int ClassifyNode(const BvhNode &node, const Frustum &frustum, int mask)
+{
+    for (int p = 0; p < 6; p++)
+    {
+        if (!(mask & (1 << p)))
+            continue;
+
+        const Vector4 &plane = frustum.planes[p];
+        const float n[3] = {plane.x, plane.y, plane.z};
+        float nearest = plane.w, farthest = plane.w;
+        for (int a = 0; a < 3; a++)
+        {
+            nearest += n[a] * (n[a] >= 0.0f ? node.max[a] : node.min[a]);
+            farthest += n[a] * (n[a] >= 0.0f ? node.min[a] : node.max[a]);
+        }
+
+        if (nearest < 0.0f)
+            return -1;
+        if (farthest >= 0.0f)
+            mask &= ~(1 << p);
+    }
+    return mask;
+}
+
+GAME_API int CullBvhQuery(const CullBvh *bvh, const Frustum *frustum, int *indices, int maxIndices)
+{
+    if (bvh->nodes.empty())
+        return 0;
+
+    struct Entry
+    {
+        int node;
+        int mask;
+    };
+    Entry stack[BVH_MAX_DEPTH];
+    int depth = 0;
+    stack[depth++] = {0, ALL_PLANES};
+
+    int found = 0;
+    while (depth > 0 && found < maxIndices)
+    {
+        const Entry entry = stack[--depth];
+        const BvhNode &node = bvh->nodes[entry.node];
+        const int mask = ClassifyNode(node, *frustum, entry.mask);
+        if (mask < 0)
+            continue;
+
+        if (node.count > 0)
+        {
+            const int first = node.leftFirst;
+            if (mask == 0)
+            {
+                const int take = std::min(node.count, maxIndices - found);
+                memcpy(indices + found, bvh->ids.data() + first, take * sizeof(int));
+                found += take;
+                continue;
+            }
+
+            for (int slot = first; slot < first + node.count && found < maxIndices; slot++)
+            {
+                const BvhObject &object = bvh->objects[slot];
+                if (BoxVisible(*frustum, mask, object.center[0], object.center[1], object.center[2],
+                               object.extent[0], object.extent[1], object.extent[2]))
+                    indices[found++] = bvh->ids[slot];
+            }
+            continue;
+        }
+
+        // Left first so the output follows slot order
+        stack[depth++] = {node.leftFirst, mask};
+        stack[depth++] = {entry.node + 1, mask};
+    }
+
+    return found;
+}
@@ -0,0 +1,53 @@
+#ifndef CULLING_HPP
+#define CULLING_HPP
+
+#include "api.hpp"
+#include "soa.hpp"
+
+#include <raylib/raylib.h>
+
+// CPU visibility culling over SoA bounds: centers plus half extents, both
+// VectorBuffers of the same component count (2 for the 2D functions, 3 for
+// the 3D ones). extents may be NULL for points. Every query writes the indices
+// of the visible objects into `indices` and returns how many it wrote, at most
+// maxIndices. Bounds touching the view count as visible.
+
+// Planes point inwards: a*x + b*y + c*z + d >= 0 inside, normalized
+struct Frustum
+{
+    Vector4 planes[6]; // left, right, bottom, top, near, far
+};
+
+// Same projection as BeginMode3D; nearPlane/farPlane <= 0 use rlgl's cull distances
+GAME_API Frustum FrustumFromCamera(Camera3D camera, float aspect, float nearPlane, float farPlane);
+GAME_API Frustum FrustumFromMatrix(Matrix viewProjection);
+// World-space bounds of what a Camera2D shows on a width x height target
+GAME_API Rectangle ViewRectFromCamera2D(Camera2D camera, float width, float height);
+
+// Linear SIMD scans, no structure to keep up to date; the fastest option when
+// most objects move every frame. Indices come out in ascending order.
+GAME_API int CullRects(const VectorBuffer *centers, const VectorBuffer *extents, Rectangle view, int *indices, int maxIndices);
+GAME_API int CullBoxes(const VectorBuffer *centers, const VectorBuffer *extents, const Frustum *frustum, int *indices, int maxIndices);
+
+// Loose uniform grid for 2D: objects are binned by center, queries widen the
+// view by the largest extent. Rebuilding is O(n); indices come out row by row.
+struct CullGrid;
+
+GAME_API CullGrid *CullGridCreate(float cellSize);
+GAME_API void CullGridDestroy(CullGrid *grid);
+GAME_API bool CullGridBuild(CullGrid *grid, const VectorBuffer *centers, const VectorBuffer *extents);
+GAME_API int CullGridQuery(const CullGrid *grid, Rectangle view, int *indices, int maxIndices);
+
+// Bounding volume hierarchy for 3D. Build once (O(n log n)); when objects
+// move without being added or removed, Refit updates the bounds in O(n).
+// Subtrees fully inside the frustum are emitted without testing their objects.
+struct CullBvh;
+
+GAME_API CullBvh *CullBvhCreate();
+GAME_API void CullBvhDestroy(CullBvh *bvh);
+GAME_API bool CullBvhBuild(CullBvh *bvh, const VectorBuffer *centers, const VectorBuffer *extents);
+// False when the object count changed since the last build
+GAME_API bool CullBvhRefit(CullBvh *bvh, const VectorBuffer *centers, const VectorBuffer *extents);
+GAME_API int CullBvhQuery(const CullBvh *bvh, const Frustum *frustum, int *indices, int maxIndices);
+
+#endif
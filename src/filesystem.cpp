@@ -1,6 +1,8 @@
 #include "filesystem.hpp"
 
+#include <unordered_map>
 #include <string_view>
+#include <filesystem>
 #include <cassert>
 #include <climits>
 #include <cstring>
@@ -10,6 +12,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <map>
 
 #include <miniz/miniz.h>
@@ -17,12 +20,19 @@
 
 struct ArchiveInfo
 {
-    std::unique_ptr<mz_zip_archive> reader;
+    std::unique_ptr<mz_zip_archive> reader; // null for loose directory mounts
     std::string fullPath;
+    std::filesystem::file_time_type modTime;
 };
 
 static std::map<std::string, ArchiveInfo> g_DataArchives;
 
+// Archive readers are shared with background loaders
+static std::mutex g_DataArchivesMutex;
+
+// Cooked asset files, whose loaders check their own headers and payload sizes
+static constexpr const char *COOKED_EXTENSIONS = ".rtex;.rwav;.rfnt;.ratl";
+
 extern "C"
 {
     static unsigned char *LoadFileDataImpl(const char *filePath, int *dataSize);
@@ -47,6 +57,26 @@ bool InitVFS(const char *manifest_path)
         if (archive_path.empty() || archive_path[0] == '#')
             continue;
 
+        // Directories are mounted as loose files, used for development and hot-reloading
+        std::error_code ec;
+        if (std::filesystem::is_directory(archive_path, ec))
+        {
+            std::string base_name = std::filesystem::path(archive_path).lexically_normal().filename().string();
+            if (base_name.empty())
+                base_name = std::filesystem::path(archive_path).lexically_normal().parent_path().filename().string();
+
+            if (base_name.empty() || g_DataArchives.count(base_name) > 0)
+            {
+                TraceLog(LOG_ERROR, "VFS: Invalid or duplicate directory mount in manifest: %s", archive_path.c_str());
+                UnloadFileText(manifest_content);
+                return false;
+            }
+
+            TraceLog(LOG_INFO, "VFS: Mounted directory: %s (Key: %s)", archive_path.c_str(), base_name.c_str());
+            g_DataArchives[base_name] = {nullptr, archive_path, {}};
+            continue;
+        }
+
         std::string base_name = archive_path;
 
         const size_t dot_pos = archive_path.rfind('.');
@@ -82,7 +112,7 @@ bool InitVFS(const char *manifest_path)
         }
 
         TraceLog(LOG_INFO, "VFS: Loaded archive: %s (Key: %s)", archive_path.c_str(), base_name.c_str());
-        g_DataArchives[base_name] = {std::move(archive), archive_path};
+        g_DataArchives[base_name] = {std::move(archive), archive_path, std::filesystem::last_write_time(archive_path, ec)};
     }
 
     UnloadFileText(manifest_content);
@@ -119,6 +149,126 @@ void UnloadVFS()
     SetSaveFileTextCallback(nullptr);
 }
 
+std::vector<VFSMount> GetVFSMounts()
+{
+    std::lock_guard<std::mutex> lock(g_DataArchivesMutex);
+
+    std::vector<VFSMount> mounts;
+    for (const auto &[key, info] : g_DataArchives)
+        mounts.push_back({key, info.fullPath, info.reader == nullptr});
+
+    return mounts;
+}
+
+static std::string GetArchiveKeyFromPath(const char *filePath);
+static std::string GetLoosePath(const ArchiveInfo &archiveInfo, const std::string &archiveKey, const char *filePath);
+
+GAME_API bool VFSFileExists(const char *filePath)
+{
+    if (!filePath)
+        return false;
+
+    const std::string archiveKey = GetArchiveKeyFromPath(filePath);
+    if (archiveKey.empty())
+        return FileExists(filePath);
+
+    std::lock_guard<std::mutex> lock(g_DataArchivesMutex);
+
+    auto it = g_DataArchives.find(archiveKey);
+    if (it == g_DataArchives.end())
+        return false;
+
+    const ArchiveInfo &archiveInfo = it->second;
+    if (!archiveInfo.reader)
+        return FileExists(GetLoosePath(archiveInfo, archiveKey, filePath).c_str());
+
+    return mz_zip_reader_locate_file(archiveInfo.reader.get(), filePath, nullptr, MZ_ZIP_FLAG_CASE_SENSITIVE) >= 0;
+}
+
+GAME_API bool VFSGetDiskPath(const char *filePath, char *diskPath, int diskPathSize)
+{
+    if (!filePath || !diskPath || diskPathSize <= 0)
+        return false;
+
+    std::string path;
+    const std::string archiveKey = GetArchiveKeyFromPath(filePath);
+    if (archiveKey.empty())
+    {
+        path = filePath;
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock(g_DataArchivesMutex);
+
+        auto it = g_DataArchives.find(archiveKey);
+        if (it == g_DataArchives.end() || it->second.reader)
+            return false;
+
+        path = GetLoosePath(it->second, archiveKey, filePath);
+    }
+
+    if (path.size() >= static_cast<size_t>(diskPathSize) || !FileExists(path.c_str()))
+        return false;
+
+    memcpy(diskPath, path.c_str(), path.size() + 1);
+    return true;
+}
+
+static std::unordered_map<std::string, mz_uint32> GetArchiveChecksums(mz_zip_archive *archiveReader)
+{
+    std::unordered_map<std::string, mz_uint32> checksums;
+
+    const mz_uint num_files = mz_zip_reader_get_num_files(archiveReader);
+    for (mz_uint i = 0; i < num_files; ++i)
+    {
+        mz_zip_archive_file_stat fileStat;
+        if (mz_zip_reader_file_stat(archiveReader, i, &fileStat) && !fileStat.m_is_directory)
+            checksums[fileStat.m_filename] = fileStat.m_crc32;
+    }
+
+    return checksums;
+}
+
+bool ReloadVFSArchive(const std::string &archiveKey, std::vector<std::string> &changedFiles)
+{
+    std::lock_guard<std::mutex> lock(g_DataArchivesMutex);
+
+    auto it = g_DataArchives.find(archiveKey);
+    if (it == g_DataArchives.end() || !it->second.reader)
+        return false;
+
+    ArchiveInfo &archiveInfo = it->second;
+
+    std::error_code ec;
+    const auto modTime = std::filesystem::last_write_time(archiveInfo.fullPath, ec);
+    if (ec || modTime == archiveInfo.modTime)
+        return false;
+
+    auto newArchiveReader = std::make_unique<mz_zip_archive>();
+    memset(newArchiveReader.get(), 0, sizeof(mz_zip_archive));
+    if (!mz_zip_reader_init_file(newArchiveReader.get(), archiveInfo.fullPath.c_str(), 0))
+    {
+        // Probably still being written, try again on the next poll
+        TraceLog(LOG_DEBUG, "VFS: Could not reopen changed archive %s", archiveInfo.fullPath.c_str());
+        return false;
+    }
+
+    const auto oldChecksums = GetArchiveChecksums(archiveInfo.reader.get());
+    for (const auto &[fileName, checksum] : GetArchiveChecksums(newArchiveReader.get()))
+    {
+        auto old = oldChecksums.find(fileName);
+        if (old == oldChecksums.end() || old->second != checksum)
+            changedFiles.push_back(fileName);
+    }
+
+    mz_zip_reader_end(archiveInfo.reader.get());
+    archiveInfo.reader = std::move(newArchiveReader);
+    archiveInfo.modTime = modTime;
+
+    TraceLog(LOG_INFO, "VFS: Reloaded archive %s (%zu changed files)", archiveInfo.fullPath.c_str(), changedFiles.size());
+    return true;
+}
+
 static std::string GetArchiveKeyFromPath(const char *filePath)
 {
     assert(filePath);
@@ -131,6 +281,12 @@ static std::string GetArchiveKeyFromPath(const char *filePath)
     return {sv.data(), pos};
 }
 
+// "lua/main.lua" in a directory mount "../lua" resolves to "../lua/main.lua"
+static std::string GetLoosePath(const ArchiveInfo &archiveInfo, const std::string &archiveKey, const char *filePath)
+{
+    return archiveInfo.fullPath + "/" + (filePath + archiveKey.size() + 1);
+}
+
 static unsigned char *FS_LoadFileData(const char *fileName, int &dataSize);
 static unsigned char *VFS_LoadFileData(const std::string &archiveKey, const char *filePath, int &dataSize);
 
@@ -168,6 +324,8 @@ static unsigned char *VFS_LoadFileData(const std::string &archiveKey, const char
     assert(!archiveKey.empty());
     assert(filePath);
 
+    std::lock_guard<std::mutex> lock(g_DataArchivesMutex);
+
     auto it = g_DataArchives.find(archiveKey);
     if (it == g_DataArchives.end())
     {
@@ -178,7 +336,10 @@ static unsigned char *VFS_LoadFileData(const std::string &archiveKey, const char
     const ArchiveInfo &archiveInfo = it->second;
     auto *archiveReader = archiveInfo.reader.get();
 
-    if (!archiveReader || archiveReader->m_zip_mode == MZ_ZIP_MODE_INVALID)
+    if (!archiveReader)
+        return FS_LoadFileData(GetLoosePath(archiveInfo, archiveKey, filePath).c_str(), dataSize);
+
+    if (archiveReader->m_zip_mode == MZ_ZIP_MODE_INVALID)
     {
         TraceLog(LOG_WARNING, "VFS: Archive reader for key '%s' is not valid. Cannot load file: %s", archiveKey.data(), filePath);
         return nullptr;
@@ -204,7 +365,12 @@ static unsigned char *VFS_LoadFileData(const std::string &archiveKey, const char
     unsigned char *fileData = static_cast<unsigned char *>(MemAlloc(allocSize));
     assert(fileData);
 
-    if (!mz_zip_reader_extract_to_mem(archiveReader, fileIndex, fileData, uncompressedSize, 0))
+    // Stored cooked assets (see build.sh) are read raw: miniz's table CRC32 took about
+    // 40x as long as the copy itself, and their loaders validate headers and sizes.
+    // Every other entry, stored PNGs and OGGs included, is CRC checked
+    const bool skipCrc = fileStat.m_method == 0 && IsFileExtension(filePath, COOKED_EXTENSIONS);
+    const mz_uint extractFlags = skipCrc ? MZ_ZIP_FLAG_COMPRESSED_DATA : 0;
+    if (!mz_zip_reader_extract_to_mem(archiveReader, fileIndex, fileData, uncompressedSize, extractFlags))
     {
         TraceLog(LOG_ERROR, "VFS: Could not extract file '%s' from archive '%s'", filePath, archiveKey.data());
         MemFree(fileData);
@@ -286,6 +452,8 @@ static bool VFS_SaveFileData(const std::string &archiveKey, const char *filePath
     assert(data);
     assert(dataSize >= 0);
 
+    std::lock_guard<std::mutex> lock(g_DataArchivesMutex);
+
     auto it = g_DataArchives.find(archiveKey);
     if (it == g_DataArchives.end())
     {
@@ -296,7 +464,10 @@ static bool VFS_SaveFileData(const std::string &archiveKey, const char *filePath
     ArchiveInfo &archiveInfo = it->second;
     auto archiveReader = archiveInfo.reader.get();
 
-    if (!archiveReader || archiveReader->m_zip_mode == MZ_ZIP_MODE_INVALID)
+    if (!archiveReader)
+        return FS_SaveFileData(GetLoosePath(archiveInfo, archiveKey, filePath).c_str(), data, dataSize);
+
+    if (archiveReader->m_zip_mode == MZ_ZIP_MODE_INVALID)
     {
         TraceLog(LOG_WARNING, "VFS: Archive reader for key '%s' is not valid. Cannot save file: %s", archiveKey.data(), filePath);
         return false;
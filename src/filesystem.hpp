@@ -1,7 +1,31 @@
 #ifndef FILESYSTEM_HPP
 #define FILESYSTEM_HPP
 
+#include "api.hpp"
+
+#include <string>
+#include <vector>
+
 void UnloadVFS();
 bool InitVFS(const char *manifest_path);
 
+struct VFSMount
+{
+    std::string key;  // first path component, e.g. "lua"
+    std::string path; // archive file or mounted directory on disk
+    bool directory;
+};
+
+std::vector<VFSMount> GetVFSMounts();
+
+// Checks a VFS path without loading it or logging when it is missing
+GAME_API bool VFSFileExists(const char *filePath);
+// Writes the on-disk location of a VFS path into diskPath, false when the file only
+// exists inside an archive (or the buffer is too small). Lets streaming loaders read
+// loose files directly instead of keeping the whole file in memory.
+GAME_API bool VFSGetDiskPath(const char *filePath, char *diskPath, int diskPathSize);
+
+// Reopens an archive if it changed on disk and reports the entries whose contents differ
+bool ReloadVFSArchive(const std::string &archiveKey, std::vector<std::string> &changedFiles);
+
 #endif
@@ -0,0 +1,158 @@
+#include "headless.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <raylib/raylib.h>
+
+using HeadlessClock = std::chrono::steady_clock;
+
+struct FrameTiming
+{
+    float frameMs;
+    float drawMs;
+};
+
+static bool enabled = false;
+static int maxFrames = 0;
+static float frameTime = 1.0f / 60.0f;
+static int framesStarted = 0;
+static bool inFrame = false;
+static HeadlessClock::time_point frameStart;    // previous EndDrawing, or the first BeginDrawing
+static HeadlessClock::time_point drawStart;
+static std::vector<FrameTiming> timings;
+static unsigned int lastFakeId = 0;
+
+static float ElapsedMs(HeadlessClock::time_point since, HeadlessClock::time_point now)
+{
+    return std::chrono::duration<float, std::milli>(now - since).count();
+}
+
+bool InitHeadless(int frames, float step)
+{
+    if (frames < 0 || step <= 0.0f)
+        return false;
+
+    enabled = true;
+    maxFrames = frames;
+    frameTime = step;
+    framesStarted = 0;
+    inFrame = false;
+    timings.clear();
+    timings.reserve(frames > 0 ? frames : 4096);
+    return true;
+}
+
+GAME_API bool HeadlessIsEnabled()
+{
+    return enabled;
+}
+
+GAME_API double HeadlessGetTime()
+{
+    return static_cast<double>(framesStarted) * frameTime;
+}
+
+GAME_API float HeadlessGetFrameTime()
+{
+    return frameTime;
+}
+
+GAME_API bool HeadlessShouldClose()
+{
+    return maxFrames > 0 && static_cast<int>(timings.size()) >= maxFrames;
+}
+
+GAME_API void HeadlessBeginFrame()
+{
+    const HeadlessClock::time_point now = HeadlessClock::now();
+    if (timings.empty() && !inFrame)
+        frameStart = now;
+
+    drawStart = now;
+    inFrame = true;
+    framesStarted++;
+}
+
+GAME_API void HeadlessEndFrame()
+{
+    if (!inFrame)
+        return;
+
+    const HeadlessClock::time_point now = HeadlessClock::now();
+    timings.push_back({ElapsedMs(frameStart, now), ElapsedMs(drawStart, now)});
+    frameStart = now;
+    inFrame = false;
+}
+
+GAME_API void HeadlessGetStats(HeadlessStats *stats)
+{
+    *stats = {};
+    stats->frames = static_cast<int>(timings.size());
+    stats->maxFrames = maxFrames;
+    stats->frameTime = frameTime;
+    if (timings.empty())
+        return;
+
+    std::vector<float> sorted;
+    sorted.reserve(timings.size());
+    double drawTotal = 0.0;
+    for (const FrameTiming &timing : timings)
+    {
+        sorted.push_back(timing.frameMs);
+        stats->totalMs += timing.frameMs;
+        drawTotal += timing.drawMs;
+    }
+    std::sort(sorted.begin(), sorted.end());
+
+    // Nearest rank
+    auto percentile = [&sorted](float p) {
+        const size_t rank = static_cast<size_t>(p * static_cast<float>(sorted.size() - 1) + 0.5f);
+        return sorted[std::min(rank, sorted.size() - 1)];
+    };
+
+    stats->meanMs = static_cast<float>(stats->totalMs / static_cast<double>(sorted.size()));
+    stats->medianMs = percentile(0.5f);
+    stats->p95Ms = percentile(0.95f);
+    stats->p99Ms = percentile(0.99f);
+    stats->minMs = sorted.front();
+    stats->maxMs = sorted.back();
+    stats->drawMeanMs = static_cast<float>(drawTotal / static_cast<double>(sorted.size()));
+}
+
+GAME_API unsigned int HeadlessFakeTextureId()
+{
+    return ++lastFakeId;
+}
+
+void ReportHeadless(const char *fileName)
+{
+    if (!enabled)
+        return;
+
+    HeadlessStats stats;
+    HeadlessGetStats(&stats);
+    if (stats.frames == 0)
+    {
+        TraceLog(LOG_WARNING, "HEADLESS: No frames ran, the script never called BeginDrawing/EndDrawing");
+        return;
+    }
+
+    TraceLog(LOG_INFO, "HEADLESS: %d frames at a fixed %.4f s step, %.1f ms in total", stats.frames, stats.frameTime, stats.totalMs);
+    TraceLog(LOG_INFO, "HEADLESS: frame ms mean %.3f, median %.3f, p95 %.3f, p99 %.3f, min %.3f, max %.3f (drawing %.3f)",
+             stats.meanMs, stats.medianMs, stats.p95Ms, stats.p99Ms, stats.minMs, stats.maxMs, stats.drawMeanMs);
+
+    if (!fileName)
+        return;
+
+    std::string csv = "frame,frame_ms,draw_ms\n";
+    for (size_t i = 0; i < timings.size(); i++)
+        csv += TextFormat("%d,%.4f,%.4f\n", static_cast<int>(i + 1), timings[i].frameMs, timings[i].drawMs);
+
+    if (SaveFileText(fileName, csv.data()))
+        TraceLog(LOG_INFO, "HEADLESS: Frame times written to %s", fileName);
+    else
+        TraceLog(LOG_WARNING, "HEADLESS: Could not write frame times to %s", fileName);
+}
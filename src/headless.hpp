@@ -0,0 +1,43 @@
+#ifndef HEADLESS_HPP
+#define HEADLESS_HPP
+
+#include "api.hpp"
+
+// Headless runs (game --headless): no window and no GL context. Native modules
+// only run their CPU side without a window, and lua/headless.lua stubs the
+// window, drawing and upload calls of the bindings, so the VFS, Lua, batching
+// and culling all run for real. Frames advance a fixed clock of frameTime
+// seconds whatever they cost, and the wall time of each frame is recorded.
+struct HeadlessStats
+{
+    int frames;       // recorded so far
+    int maxFrames;    // the run ends after this many
+    float frameTime;  // fixed step, seconds
+    double totalMs;
+    float meanMs;     // whole frames, from one EndDrawing to the next
+    float medianMs;
+    float p95Ms;
+    float p99Ms;
+    float minMs;
+    float maxMs;
+    float drawMeanMs; // BeginDrawing to EndDrawing
+};
+
+GAME_API bool HeadlessIsEnabled();
+// Fixed clock: frames started so far times the step
+GAME_API double HeadlessGetTime();
+GAME_API float HeadlessGetFrameTime();
+GAME_API bool HeadlessShouldClose();
+
+GAME_API void HeadlessBeginFrame();
+GAME_API void HeadlessEndFrame();
+GAME_API void HeadlessGetStats(HeadlessStats *stats);
+// Placeholder GPU ids for textures and shaders, shared with lua/headless.lua so none collide
+GAME_API unsigned int HeadlessFakeTextureId();
+
+// Host side: maxFrames 0 runs until the script stops
+bool InitHeadless(int maxFrames, float frameTime);
+// Logs the frame time summary, writes one "frame,frame_ms,draw_ms" line per frame if fileName is set
+void ReportHeadless(const char *fileName);
+
+#endif
@@ -0,0 +1,451 @@
+#include "instancing.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <new>
+
+#include <raylib/rlgl.h>
+
+#define RAYMATH_STATIC_INLINE
+#include <raylib/raymath.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define INSTANCING_SSE2 1
+#endif
+
+// Same layout rules as soa buffers: 32-byte aligned, padded to 8 floats, so
+// the matrix kernel can always work on whole groups of four instances
+static constexpr size_t ARRAY_ALIGNMENT = 32;
+static constexpr int ARRAY_PADDING = 8;
+static constexpr int MATRIX_FLOATS = 16;
+static constexpr int MATRIX_BYTES = MATRIX_FLOATS * sizeof(float);
+// raylib's MAX_MATERIAL_MAPS, the size of every Material::maps array
+static constexpr int MATERIAL_MAP_COUNT = 12;
+
+struct InstanceBatchState : InstanceBatch
+{
+    float *matrices = nullptr;
+
+    // [first, last) still to rebuild, and rebuilt but not uploaded yet
+    int buildFirst = 0;
+    int buildLast = 0;
+    int uploadFirst = 0;
+    int uploadLast = 0;
+
+    // GPU side, created on the first draw with a window
+    unsigned int vboId = 0;
+    int gpuCapacity = 0;
+
+    bool warnedShader = false;
+    InstanceBatchStats stats = {};
+};
+
+static InstanceBatchState *State(InstanceBatch *batch)
+{
+    return static_cast<InstanceBatchState *>(batch);
+}
+
+static float *AllocateArray(size_t count)
+{
+    float *array = static_cast<float *>(::operator new(count * sizeof(float), std::align_val_t{ARRAY_ALIGNMENT}, std::nothrow));
+    if (array)
+        std::memset(array, 0, count * sizeof(float));
+    return array;
+}
+
+static void FreeArray(float *array)
+{
+    if (array)
+        ::operator delete(array, std::align_val_t{ARRAY_ALIGNMENT});
+}
+
+static bool GrowArray(float *&array, size_t used, size_t capacity)
+{
+    float *grown = AllocateArray(capacity);
+    if (!grown)
+        return false;
+
+    if (array)
+        std::memcpy(grown, array, used * sizeof(float));
+    FreeArray(array);
+    array = grown;
+    return true;
+}
+
+static bool Reserve(InstanceBatchState *batch, int capacity)
+{
+    capacity = (capacity + ARRAY_PADDING - 1) / ARRAY_PADDING * ARRAY_PADDING;
+    if (capacity <= batch->capacity)
+        return true;
+
+    float **rotations[4] = {&batch->rotationX, &batch->rotationY, &batch->rotationZ, &batch->rotationW};
+    for (float **rotation : rotations)
+    {
+        if (!GrowArray(*rotation, batch->count, capacity))
+            return false;
+    }
+    if (!GrowArray(batch->matrices, static_cast<size_t>(batch->count) * MATRIX_FLOATS, static_cast<size_t>(capacity) * MATRIX_FLOATS))
+        return false;
+
+    batch->capacity = capacity;
+    return true;
+}
+
+static void ExtendRange(int &first, int &last, int from, int to)
+{
+    if (first == last)
+    {
+        first = from;
+        last = to;
+        return;
+    }
+    first = std::min(first, from);
+    last = std::max(last, to);
+}
+
+GAME_API InstanceBatch *InstanceBatchCreate(int capacity)
+{
+    InstanceBatchState *batch = new InstanceBatchState{};
+    batch->positions = VectorBufferCreate(std::max(capacity, 1), 3);
+    batch->scales = VectorBufferCreate(std::max(capacity, 1), 3);
+
+    if (!batch->positions || !batch->scales || !Reserve(batch, std::max(capacity, 1)))
+    {
+        TraceLog(LOG_ERROR, "INSTANCING: Could not allocate %d instances", capacity);
+        InstanceBatchDestroy(batch);
+        return nullptr;
+    }
+
+    return batch;
+}
+
+GAME_API void InstanceBatchDestroy(InstanceBatch *batch)
+{
+    if (!batch)
+        return;
+
+    InstanceBatchState *state = State(batch);
+    if (state->vboId != 0 && IsWindowReady())
+        rlUnloadVertexBuffer(state->vboId);
+
+    VectorBufferDestroy(state->positions);
+    VectorBufferDestroy(state->scales);
+    FreeArray(state->rotationX);
+    FreeArray(state->rotationY);
+    FreeArray(state->rotationZ);
+    FreeArray(state->rotationW);
+    FreeArray(state->matrices);
+    delete state;
+}
+
+GAME_API bool InstanceBatchResize(InstanceBatch *batch, int count)
+{
+    InstanceBatchState *state = State(batch);
+    if (count < 0)
+        return false;
+
+    if ((count > state->capacity && !Reserve(state, std::max(count, state->capacity * 2))) ||
+        !VectorBufferResize(state->positions, count) || !VectorBufferResize(state->scales, count))
+    {
+        TraceLog(LOG_ERROR, "INSTANCING: Could not grow batch to %d instances", count);
+        return false;
+    }
+
+    const int previous = state->count;
+    for (int i = previous; i < count; i++)
+    {
+        state->rotationX[i] = state->rotationY[i] = state->rotationZ[i] = 0.0f;
+        state->rotationW[i] = 1.0f;
+        state->scales->x[i] = state->scales->y[i] = state->scales->z[i] = 1.0f;
+    }
+
+    state->count = count;
+    if (count > previous)
+        ExtendRange(state->buildFirst, state->buildLast, previous, count);
+    state->buildLast = std::min(state->buildLast, count);
+    state->uploadLast = std::min(state->uploadLast, count);
+    return true;
+}
+
+GAME_API void InstanceBatchMarkDirty(InstanceBatch *batch, int first, int count)
+{
+    InstanceBatchState *state = State(batch);
+    const int from = std::max(first, 0);
+    const int to = std::min(first + count, state->count);
+    if (from < to)
+        ExtendRange(state->buildFirst, state->buildLast, from, to);
+}
+
+// Scale * rotation * translation like MatrixMultiply(MatrixMultiply(MatrixScale,
+// QuaternionToMatrix), MatrixTranslate), written column-major as
+// MatrixToFloatV does. Quaternions are normalized on the way (s = 2 / |q|^2).
+static void BuildMatrices(InstanceBatchState *batch, int first, int last)
+{
+    const float *px = batch->positions->x, *py = batch->positions->y, *pz = batch->positions->z;
+    const float *sx = batch->scales->x, *sy = batch->scales->y, *sz = batch->scales->z;
+    const float *qx = batch->rotationX, *qy = batch->rotationY, *qz = batch->rotationZ, *qw = batch->rotationW;
+    float *out = batch->matrices;
+
+#if defined(INSTANCING_SSE2)
+    // Every array is padded past count to a multiple of 8, and instances
+    // outside [first, last) are rebuilt from their current values, so the
+    // range can be widened to aligned groups of four
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 tiny = _mm_set1_ps(1e-30f);
+    for (int i = first & ~3; i < last; i += 4)
+    {
+        const __m128 x = _mm_load_ps(qx + i), y = _mm_load_ps(qy + i), z = _mm_load_ps(qz + i), w = _mm_load_ps(qw + i);
+        const __m128 norm = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_add_ps(_mm_mul_ps(z, z), _mm_mul_ps(w, w)));
+        const __m128 s = _mm_div_ps(_mm_set1_ps(2.0f), _mm_max_ps(norm, tiny));
+        const __m128 xs = _mm_mul_ps(x, s), ys = _mm_mul_ps(y, s), zs = _mm_mul_ps(z, s);
+        const __m128 xx = _mm_mul_ps(x, xs), yy = _mm_mul_ps(y, ys), zz = _mm_mul_ps(z, zs);
+        const __m128 xy = _mm_mul_ps(x, ys), xz = _mm_mul_ps(x, zs), yz = _mm_mul_ps(y, zs);
+        const __m128 wx = _mm_mul_ps(w, xs), wy = _mm_mul_ps(w, ys), wz = _mm_mul_ps(w, zs);
+
+        const __m128 scaleX = _mm_load_ps(sx + i), scaleY = _mm_load_ps(sy + i), scaleZ = _mm_load_ps(sz + i);
+        __m128 columns[4][4] = {
+            {_mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), scaleX), _mm_mul_ps(_mm_add_ps(xy, wz), scaleX),
+             _mm_mul_ps(_mm_sub_ps(xz, wy), scaleX), _mm_setzero_ps()},
+            {_mm_mul_ps(_mm_sub_ps(xy, wz), scaleY), _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), scaleY),
+             _mm_mul_ps(_mm_add_ps(yz, wx), scaleY), _mm_setzero_ps()},
+            {_mm_mul_ps(_mm_add_ps(xz, wy), scaleZ), _mm_mul_ps(_mm_sub_ps(yz, wx), scaleZ),
+             _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), scaleZ), _mm_setzero_ps()},
+            {_mm_load_ps(px + i), _mm_load_ps(py + i), _mm_load_ps(pz + i), one},
+        };
+
+        // Lanes hold one element of four instances, transposing gives each
+        // instance's column
+        float *matrix = out + static_cast<size_t>(i) * MATRIX_FLOATS;
+        for (int c = 0; c < 4; c++)
+        {
+            _MM_TRANSPOSE4_PS(columns[c][0], columns[c][1], columns[c][2], columns[c][3]);
+            for (int lane = 0; lane < 4; lane++)
+                _mm_store_ps(matrix + lane * MATRIX_FLOATS + c * 4, columns[c][lane]);
+        }
+    }
+#else
+    for (int i = first; i < last; i++)
+    {
+        const float x = qx[i], y = qy[i], z = qz[i], w = qw[i];
+        const float s = 2.0f / std::max(x * x + y * y + z * z + w * w, 1e-30f);
+        const float xx = x * x * s, yy = y * y * s, zz = z * z * s;
+        const float xy = x * y * s, xz = x * z * s, yz = y * z * s;
+        const float wx = w * x * s, wy = w * y * s, wz = w * z * s;
+
+        float *m = out + static_cast<size_t>(i) * MATRIX_FLOATS;
+        m[0] = (1.0f - yy - zz) * sx[i]; m[1] = (xy + wz) * sx[i];        m[2] = (xz - wy) * sx[i];         m[3] = 0.0f;
+        m[4] = (xy - wz) * sy[i];        m[5] = (1.0f - xx - zz) * sy[i]; m[6] = (yz + wx) * sy[i];         m[7] = 0.0f;
+        m[8] = (xz + wy) * sz[i];        m[9] = (yz - wx) * sz[i];        m[10] = (1.0f - xx - yy) * sz[i]; m[11] = 0.0f;
+        m[12] = px[i];                   m[13] = py[i];                   m[14] = pz[i];                    m[15] = 1.0f;
+    }
+#endif
+}
+
+GAME_API void InstanceBatchUpdate(InstanceBatch *batch)
+{
+    InstanceBatchState *state = State(batch);
+    const auto start = std::chrono::steady_clock::now();
+
+    const int first = state->buildFirst;
+    const int last = std::min(state->buildLast, state->count);
+    state->stats.rebuilt = std::max(last - first, 0);
+    if (first < last)
+    {
+        BuildMatrices(state, first, last);
+        ExtendRange(state->uploadFirst, state->uploadLast, first, last);
+    }
+    state->buildFirst = state->buildLast = 0;
+
+    state->stats.buildMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+GAME_API const float *InstanceBatchGetMatrices(const InstanceBatch *batch)
+{
+    return static_cast<const InstanceBatchState *>(batch)->matrices;
+}
+
+// One buffer for the whole batch: static instances upload nothing, moving ones
+// only their span. Growing past it reallocates and uploads everything.
+static void EnsureGpuBuffer(InstanceBatchState *batch)
+{
+    if (batch->gpuCapacity >= batch->count)
+        return;
+
+    if (batch->vboId != 0)
+        rlUnloadVertexBuffer(batch->vboId);
+
+    batch->vboId = rlLoadVertexBuffer(nullptr, batch->capacity * MATRIX_BYTES, true);
+    batch->gpuCapacity = batch->capacity;
+    ExtendRange(batch->uploadFirst, batch->uploadLast, 0, batch->count);
+}
+
+static void SetMaterialUniform(const Material &material, int location, int map)
+{
+    if (location < 0)
+        return;
+
+    const Color color = material.maps[map].color;
+    const float values[4] = {color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f};
+    rlSetUniform(location, values, RL_SHADER_UNIFORM_VEC4, 1);
+}
+
+static bool IsCubemap(int map)
+{
+    return map == MATERIAL_MAP_CUBEMAP || map == MATERIAL_MAP_IRRADIANCE || map == MATERIAL_MAP_PREFILTER;
+}
+
+GAME_API void InstanceBatchDraw(InstanceBatch *batch, Mesh mesh, Material material)
+{
+    InstanceBatchState *state = State(batch);
+    InstanceBatchUpdate(batch);
+    state->stats.instances = state->count;
+    state->stats.uploaded = 0;
+    if (state->count == 0 || !IsWindowReady())
+        return;
+
+    // Everything raylib queued so far goes first
+    rlDrawRenderBatchActive();
+
+    EnsureGpuBuffer(state);
+    const int first = state->uploadFirst;
+    const int last = std::min(state->uploadLast, state->count);
+    if (first < last)
+    {
+        rlUpdateVertexBuffer(state->vboId, state->matrices + static_cast<size_t>(first) * MATRIX_FLOATS, (last - first) * MATRIX_BYTES,
+                             first * MATRIX_BYTES);
+        state->stats.uploaded = last - first;
+    }
+    state->uploadFirst = state->uploadLast = 0;
+
+    const int *locs = material.shader.locs;
+    const int instanceLocation = locs[SHADER_LOC_MATRIX_MODEL];
+    if (instanceLocation < 0 && !state->warnedShader)
+    {
+        TraceLog(LOG_WARNING, "INSTANCING: Shader %u has no instanceTransform attribute, every instance draws at the origin", material.shader.id);
+        state->warnedShader = true;
+    }
+
+    rlEnableShader(material.shader.id);
+    SetMaterialUniform(material, locs[SHADER_LOC_COLOR_DIFFUSE], MATERIAL_MAP_DIFFUSE);
+    SetMaterialUniform(material, locs[SHADER_LOC_COLOR_SPECULAR], MATERIAL_MAP_SPECULAR);
+
+    // Modelview only holds the camera here, the model transform is per instance
+    const Matrix view = rlGetMatrixModelview();
+    const Matrix projection = rlGetMatrixProjection();
+    if (locs[SHADER_LOC_MATRIX_VIEW] != -1)
+        rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_VIEW], view);
+    if (locs[SHADER_LOC_MATRIX_PROJECTION] != -1)
+        rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_PROJECTION], projection);
+    if (locs[SHADER_LOC_MATRIX_NORMAL] != -1)
+        rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_NORMAL], MatrixIdentity());
+    rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_MVP], MatrixMultiply(MatrixMultiply(rlGetMatrixTransform(), view), projection));
+
+    for (int map = 0; map < MATERIAL_MAP_COUNT; map++)
+    {
+        if (material.maps[map].texture.id == 0)
+            continue;
+
+        rlActiveTextureSlot(map);
+        if (IsCubemap(map))
+            rlEnableTextureCubemap(material.maps[map].texture.id);
+        else
+            rlEnableTexture(material.maps[map].texture.id);
+        rlSetUniform(locs[SHADER_LOC_MAP_DIFFUSE + map], &map, RL_SHADER_UNIFORM_INT, 1);
+    }
+
+    if (rlEnableVertexArray(mesh.vaoId))
+    {
+        if (instanceLocation >= 0)
+        {
+            rlEnableVertexBuffer(state->vboId);
+            for (int column = 0; column < 4; column++)
+            {
+                rlEnableVertexAttribute(instanceLocation + column);
+                rlSetVertexAttribute(instanceLocation + column, 4, RL_FLOAT, false, MATRIX_BYTES, column * 4 * sizeof(float));
+                rlSetVertexAttributeDivisor(instanceLocation + column, 1);
+            }
+        }
+
+        if (mesh.indices != nullptr)
+            rlDrawVertexArrayElementsInstanced(0, mesh.triangleCount * 3, nullptr, state->count);
+        else
+            rlDrawVertexArrayInstanced(0, mesh.vertexCount, state->count);
+
+        // The VAO belongs to the mesh, leave it as DrawMesh expects it
+        if (instanceLocation >= 0)
+        {
+            for (int column = 0; column < 4; column++)
+            {
+                rlSetVertexAttributeDivisor(instanceLocation + column, 0);
+                rlDisableVertexAttribute(instanceLocation + column);
+            }
+        }
+    }
+    else
+    {
+        TraceLog(LOG_WARNING, "INSTANCING: Mesh has no vertex array, upload it before drawing");
+    }
+
+    for (int map = 0; map < MATERIAL_MAP_COUNT; map++)
+    {
+        if (material.maps[map].texture.id == 0)
+            continue;
+
+        rlActiveTextureSlot(map);
+        if (IsCubemap(map))
+            rlDisableTextureCubemap();
+        else
+            rlDisableTexture();
+    }
+    rlActiveTextureSlot(0);
+
+    rlDisableVertexArray();
+    rlDisableVertexBuffer();
+    rlDisableVertexBufferElement();
+    rlDisableShader();
+}
+
+GAME_API void InstanceBatchGetStats(const InstanceBatch *batch, InstanceBatchStats *stats)
+{
+    *stats = static_cast<const InstanceBatchState *>(batch)->stats;
+}
+
+static const char *INSTANCING_VS = R"(#version 330
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in mat4 instanceTransform;
+uniform mat4 mvp;
+out vec2 fragTexCoord;
+void main()
+{
+    fragTexCoord = vertexTexCoord;
+    gl_Position = mvp*instanceTransform*vec4(vertexPosition, 1.0);
+}
+)";
+
+static const char *INSTANCING_FS = R"(#version 330
+in vec2 fragTexCoord;
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+out vec4 finalColor;
+void main()
+{
+    finalColor = texture(texture0, fragTexCoord)*colDiffuse;
+}
+)";
+
+GAME_API Shader LoadInstancingShader()
+{
+    if (!IsWindowReady())
+    {
+        TraceLog(LOG_WARNING, "INSTANCING: Shaders need a window");
+        return Shader{};
+    }
+
+    Shader shader = LoadShaderFromMemory(INSTANCING_VS, INSTANCING_FS);
+    if (IsShaderValid(shader))
+        shader.locs[SHADER_LOC_MATRIX_MODEL] = GetShaderLocationAttrib(shader, "instanceTransform");
+    return shader;
+}
@@ -0,0 +1,58 @@
+#ifndef INSTANCING_HPP
+#define INSTANCING_HPP
+
+#include "api.hpp"
+#include "soa.hpp"
+
+#include <raylib/raylib.h>
+
+// Instanced mesh drawing from packed transforms: one draw call per mesh for
+// every instance in the batch, with the per-instance matrices kept in a
+// persistent GPU buffer. Transforms live in SoA arrays owned by the batch;
+// positions and scales are soa VectorBuffers, so the soa kernels (axpy,
+// transform...) run on them directly. After changing instances, mark them
+// dirty: only dirty matrices are rebuilt (SIMD) and uploaded on the next draw.
+// Dirty ranges merge into one span, so keep instances that move every frame
+// together (or in their own batch) and static ones elsewhere.
+struct InstanceBatch
+{
+    VectorBuffer *positions; // 3 components
+    VectorBuffer *scales;    // 3 components, 1 for new instances
+    float *rotationX;        // quaternions, identity for new instances;
+    float *rotationY;        // they need not be normalized
+    float *rotationZ;
+    float *rotationW;
+    int count;
+    int capacity;
+};
+
+struct InstanceBatchStats
+{
+    int instances;   // count at the last draw
+    int rebuilt;     // matrices rebuilt by the last update
+    int uploaded;    // matrices uploaded by the last draw
+    float buildMs;   // last update
+};
+
+GAME_API InstanceBatch *InstanceBatchCreate(int capacity);
+GAME_API void InstanceBatchDestroy(InstanceBatch *batch);
+// New instances sit at the origin with identity rotation and unit scale, and are dirty
+GAME_API bool InstanceBatchResize(InstanceBatch *batch, int count);
+GAME_API void InstanceBatchMarkDirty(InstanceBatch *batch, int first, int count);
+
+// CPU side only, works without a window: rebuilds the dirty matrices
+GAME_API void InstanceBatchUpdate(InstanceBatch *batch);
+// Column-major float[16] per instance, as uploaded (valid after an update)
+GAME_API const float *InstanceBatchGetMatrices(const InstanceBatch *batch);
+
+// Update, upload what changed, then draw every instance of the mesh like
+// DrawMeshInstanced: the material shader needs its mat4 instanceTransform
+// attribute location in locs[SHADER_LOC_MATRIX_MODEL] (LoadInstancingShader
+// sets it). Flushes raylib's batch first; does nothing without a window.
+GAME_API void InstanceBatchDraw(InstanceBatch *batch, Mesh mesh, Material material);
+GAME_API void InstanceBatchGetStats(const InstanceBatch *batch, InstanceBatchStats *stats);
+
+// Unlit shader for instanced meshes: texture0 * colDiffuse
+GAME_API Shader LoadInstancingShader();
+
+#endif
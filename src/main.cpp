@@ -1,16 +1,33 @@
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 #include <vector>
 #include <string>
 
 #include <raylib/raylib.h>
 #include <luajit/lua.hpp>
 
+#include "batchmath.hpp"
 #include "filesystem.hpp"
+#include "headless.hpp"
+#include "queue.hpp"
+#include "renderbatch.hpp"
+#include "resources.hpp"
+#include "scheduler.hpp"
+#include "watcher.hpp"
 
 static lua_State *L;
 
 static bool RunLuaFiles(const std::vector<std::string> &luaFiles);
+static bool RunLuaString(const char *code);
+static bool HasFlag(int argc, char *argv[], const char *flag);
+static const char *GetFlagValue(int argc, char *argv[], const char *flag);
 
-int main()
+// --headless: no window, fixed 60 Hz clock, --frames frames (0 runs until the script ends)
+static constexpr int HEADLESS_DEFAULT_FRAMES = 600;
+static constexpr float HEADLESS_FRAME_TIME = 1.0f / 60.0f;
+
+int main(int argc, char *argv[])
 {
     // Initialize virtual file system
     if (!InitVFS("data.manifest"))
@@ -20,18 +37,68 @@ int main()
         return 1;
     }
 
+    // Initialize coroutine scheduler and background loader
+    if (!InitScheduler())
+    {
+        TraceLog(LOG_ERROR, "MAIN: Failed to initialize the scheduler");
+        UnloadScheduler();
+        UnloadVFS();
+        return 1;
+    }
+
+    // Pick SIMD kernels for the batch math functions
+    InitBatchMath();
+
+    // Headless runs stub the window and report frame times at exit
+    const bool headless = HasFlag(argc, argv, "--headless");
+    if (headless)
+    {
+        // Only a whole non-negative count; atoi would read a typo as 0, running until the script ends
+        int frameCount = HEADLESS_DEFAULT_FRAMES;
+        if (const char *frames = GetFlagValue(argc, argv, "--frames"))
+        {
+            char *end = nullptr;
+            const long value = strtol(frames, &end, 10);
+            frameCount = end != frames && *end == '\0' && value >= 0 && value <= INT_MAX ? static_cast<int>(value) : -1;
+        }
+        if (!InitHeadless(frameCount, HEADLESS_FRAME_TIME))
+        {
+            TraceLog(LOG_ERROR, "MAIN: Invalid --frames value");
+            UnloadScheduler();
+            UnloadVFS();
+            return 1;
+        }
+    }
+
     // Initialize LuaJIT
     L = luaL_newstate();
     luaL_openlibs(L);
 
     // Run Lua scripts
-    RunLuaFiles({"lua/raylib.lua", "lua/main.lua"});
+    bool scriptsRan = false;
+    if (RunLuaFiles({"lua/raylib.lua"}) && (!headless || RunLuaString("require('headless').start()")))
+    {
+        if (HasFlag(argc, argv, "--jit-diag"))
+            RunLuaString("require('jitdiag').start()");
+
+        scriptsRan = RunLuaFiles({"lua/main.lua"});
+        RunLuaString("rl.RunShutdownHooks()");
+    }
+
+    if (headless)
+        ReportHeadless(GetFlagValue(argc, argv, "--frame-times"));
 
     // Cleanup
     lua_close(L);
+    UnloadRenderBatches();
+    UnloadResources();
+    UnloadWatcher();
+    UnloadScheduler();
+    UnloadQueues();
     UnloadVFS();
 
-    return 0;
+    // Script errors fail headless runs, so CI notices them
+    return headless && !scriptsRan ? 1 : 0;
 }
 
 static bool RunLuaFiles(const std::vector<std::string> &luaFiles)
@@ -51,9 +118,14 @@ static bool RunLuaFiles(const std::vector<std::string> &luaFiles)
             return false;
         }
 
-        int status = luaL_dostring(L, file_content);
+        // Name chunks after their file so tracebacks and profiles show "lua/main.lua:12"
+        const std::string chunkName = "@" + fileName;
+        int status = luaL_loadbuffer(L, file_content, strlen(file_content), chunkName.c_str());
         MemFree((void *)file_content);
 
+        if (status == LUA_OK)
+            status = lua_pcall(L, 0, LUA_MULTRET, 0);
+
         if (status != LUA_OK)
         {
             const char *error_msg = lua_tostring(L, -1);
@@ -65,3 +137,38 @@ static bool RunLuaFiles(const std::vector<std::string> &luaFiles)
 
     return true;
 }
+
+static bool RunLuaString(const char *code)
+{
+    if (luaL_dostring(L, code) != LUA_OK)
+    {
+        const char *error_msg = lua_tostring(L, -1);
+        TraceLog(LOG_ERROR, "LUA: Error running \"%s\": %s", code, error_msg ? error_msg : "Unknown error");
+        lua_pop(L, 1);
+        return false;
+    }
+
+    return true;
+}
+
+static bool HasFlag(int argc, char *argv[], const char *flag)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], flag) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+static const char *GetFlagValue(int argc, char *argv[], const char *flag)
+{
+    for (int i = 1; i + 1 < argc; ++i)
+    {
+        if (strcmp(argv[i], flag) == 0)
+            return argv[i + 1];
+    }
+
+    return nullptr;
+}
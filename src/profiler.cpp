@@ -0,0 +1,204 @@
+#include "profiler.hpp"
+
+#include <unordered_map>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+
+#include <raylib/raylib.h>
+
+// Upper bound per thread so a forgotten profiler cannot eat all memory
+static constexpr size_t MAX_EVENTS_PER_THREAD = 1 << 20;
+
+struct ZoneEvent
+{
+    int zoneId;
+    int64_t begin; // microseconds since ProfilerReset
+    int64_t end;
+};
+
+struct OpenZone
+{
+    int zoneId;
+    int64_t begin;
+};
+
+struct ThreadBuffer
+{
+    int threadId = 0;
+    std::mutex eventsMutex; // the owning thread appends, Save and Reset read from the main thread
+    std::vector<ZoneEvent> events;
+    std::vector<OpenZone> stack;
+    int skipped = 0; // zones begun while disabled and not ended yet, their ends pop nothing
+};
+
+static std::atomic<bool> g_ProfilerEnabled{false};
+static std::chrono::steady_clock::time_point g_ProfilerEpoch = std::chrono::steady_clock::now();
+
+// Zone names are interned once, deque keeps c_str() pointers stable
+static std::mutex g_ProfilerMutex;
+static std::deque<std::string> g_ZoneNames;
+static std::unordered_map<std::string, int> g_ZoneIds;
+static std::vector<std::unique_ptr<ThreadBuffer>> g_ThreadBuffers;
+
+static int64_t NowMicroseconds()
+{
+    const auto elapsed = std::chrono::steady_clock::now() - g_ProfilerEpoch;
+    return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+
+static ThreadBuffer &GetThreadBuffer()
+{
+    thread_local ThreadBuffer *buffer = nullptr;
+    if (!buffer)
+    {
+        std::lock_guard<std::mutex> lock(g_ProfilerMutex);
+        g_ThreadBuffers.push_back(std::make_unique<ThreadBuffer>());
+        buffer = g_ThreadBuffers.back().get();
+        buffer->threadId = static_cast<int>(g_ThreadBuffers.size());
+    }
+    return *buffer;
+}
+
+GAME_API void ProfilerSetEnabled(bool enabled)
+{
+    g_ProfilerEnabled = enabled;
+}
+
+GAME_API bool ProfilerIsEnabled()
+{
+    return g_ProfilerEnabled;
+}
+
+GAME_API void ProfilerReset()
+{
+    std::lock_guard<std::mutex> lock(g_ProfilerMutex);
+    for (auto &buffer : g_ThreadBuffers)
+    {
+        std::lock_guard<std::mutex> eventsLock(buffer->eventsMutex);
+        buffer->events.clear();
+    }
+    g_ProfilerEpoch = std::chrono::steady_clock::now();
+}
+
+GAME_API int ProfilerZoneId(const char *name)
+{
+    if (!name)
+        return -1;
+
+    std::lock_guard<std::mutex> lock(g_ProfilerMutex);
+    auto it = g_ZoneIds.find(name);
+    if (it != g_ZoneIds.end())
+        return it->second;
+
+    const int zoneId = static_cast<int>(g_ZoneNames.size());
+    g_ZoneNames.emplace_back(name);
+    g_ZoneIds.emplace(name, zoneId);
+    return zoneId;
+}
+
+// Begin and end stay paired across ProfilerSetEnabled: a zone begun while disabled
+// is counted, not pushed, and its end only takes the count back down
+GAME_API void ProfilerBeginZone(int zoneId)
+{
+    if (zoneId < 0)
+        return;
+
+    ThreadBuffer &buffer = GetThreadBuffer();
+    if (!g_ProfilerEnabled)
+    {
+        buffer.skipped++;
+        return;
+    }
+
+    buffer.stack.push_back({zoneId, NowMicroseconds()});
+}
+
+GAME_API void ProfilerEndZone()
+{
+    ThreadBuffer &buffer = GetThreadBuffer();
+    if (buffer.skipped > 0)
+    {
+        buffer.skipped--;
+        return;
+    }
+    if (buffer.stack.empty())
+        return;
+
+    const OpenZone zone = buffer.stack.back();
+    buffer.stack.pop_back();
+    if (!g_ProfilerEnabled)
+        return;
+
+    std::lock_guard<std::mutex> lock(buffer.eventsMutex);
+    if (buffer.events.size() < MAX_EVENTS_PER_THREAD)
+        buffer.events.push_back({zone.zoneId, zone.begin, NowMicroseconds()});
+}
+
+GAME_API const char *ProfilerCurrentZone()
+{
+    const ThreadBuffer &buffer = GetThreadBuffer();
+    if (buffer.stack.empty())
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(g_ProfilerMutex);
+    return g_ZoneNames[buffer.stack.back().zoneId].c_str();
+}
+
+static void WriteJsonString(FILE *file, const std::string &text)
+{
+    fputc('"', file);
+    for (const char c : text)
+    {
+        if (c == '"' || c == '\\')
+            fputc('\\', file);
+        if (static_cast<unsigned char>(c) >= 0x20)
+            fputc(c, file);
+    }
+    fputc('"', file);
+}
+
+GAME_API bool ProfilerSaveChromeTrace(const char *fileName)
+{
+    if (!fileName)
+        return false;
+
+    FILE *file = fopen(fileName, "wb");
+    if (!file)
+    {
+        TraceLog(LOG_ERROR, "PROF: Could not open file %s for writing: %s", fileName, strerror(errno));
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(g_ProfilerMutex);
+
+    size_t eventCount = 0;
+    fputs("{\"traceEvents\":[\n", file);
+    for (const auto &buffer : g_ThreadBuffers)
+    {
+        std::lock_guard<std::mutex> eventsLock(buffer->eventsMutex);
+        for (const ZoneEvent &event : buffer->events)
+        {
+            if (eventCount++ > 0)
+                fputs(",\n", file);
+
+            fputs("{\"name\":", file);
+            WriteJsonString(file, g_ZoneNames[event.zoneId]);
+            fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%lld,\"dur\":%lld}", buffer->threadId,
+                    static_cast<long long>(event.begin), static_cast<long long>(event.end - event.begin));
+        }
+    }
+    fputs("\n],\"displayTimeUnit\":\"ms\"}\n", file);
+    fclose(file);
+
+    TraceLog(LOG_INFO, "PROF: Saved %zu zones to %s", eventCount, fileName);
+    return true;
+}
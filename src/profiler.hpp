@@ -0,0 +1,18 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include "api.hpp"
+
+// Timed native zones, written out as a Chrome trace (chrome://tracing, Perfetto)
+GAME_API void ProfilerSetEnabled(bool enabled);
+GAME_API bool ProfilerIsEnabled();
+GAME_API void ProfilerReset();
+
+GAME_API int ProfilerZoneId(const char *name);
+GAME_API void ProfilerBeginZone(int zoneId);
+GAME_API void ProfilerEndZone();
+GAME_API const char *ProfilerCurrentZone();
+
+GAME_API bool ProfilerSaveChromeTrace(const char *fileName);
+
+#endif
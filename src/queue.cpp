@@ -0,0 +1,300 @@
+#include "queue.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <mutex>
+
+#include <raylib/raylib.h>
+
+// Keeps producer and consumer indices on separate cache lines
+static constexpr size_t CACHE_LINE_SIZE = 64;
+
+struct Queue
+{
+    std::string name;
+    size_t recordSize = 0;
+    size_t capacity = 0;
+    size_t mask = 0;
+    bool multiProducer = false;
+
+    std::unique_ptr<unsigned char[]> records;
+    std::unique_ptr<std::atomic<size_t>[]> sequences; // MPSC only
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head{0}; // next slot to pop
+    size_t cachedTail = 0;                                 // consumer's view of tail (SPSC)
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail{0}; // next slot to push
+    size_t cachedHead = 0;                                 // producer's view of head (SPSC)
+
+    unsigned char *Slot(size_t index) const { return records.get() + (index & mask) * recordSize; }
+};
+
+// Creation and lookup are rare, only these take the lock
+static std::mutex g_QueuesMutex;
+static std::vector<std::unique_ptr<Queue>> g_Queues;
+
+static size_t RoundUpToPowerOfTwo(size_t value)
+{
+    size_t result = 1;
+    while (result < value)
+        result <<= 1;
+    return result;
+}
+
+GAME_API Queue *QueueCreate(const char *name, int recordSize, int capacity, bool multiProducer)
+{
+    if (recordSize <= 0 || capacity <= 0)
+    {
+        TraceLog(LOG_ERROR, "QUEUE: Invalid record size (%d) or capacity (%d)", recordSize, capacity);
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(g_QueuesMutex);
+
+    if (name && name[0] != '\0')
+    {
+        for (const auto &queue : g_Queues)
+        {
+            if (queue->name == name)
+            {
+                TraceLog(LOG_ERROR, "QUEUE: Queue '%s' already exists", name);
+                return nullptr;
+            }
+        }
+    }
+
+    auto queue = std::make_unique<Queue>();
+    queue->name = name ? name : "";
+    queue->recordSize = static_cast<size_t>(recordSize);
+    queue->capacity = RoundUpToPowerOfTwo(static_cast<size_t>(capacity));
+    queue->mask = queue->capacity - 1;
+    queue->multiProducer = multiProducer;
+    queue->records = std::make_unique<unsigned char[]>(queue->capacity * queue->recordSize);
+
+    if (multiProducer)
+    {
+        queue->sequences = std::make_unique<std::atomic<size_t>[]>(queue->capacity);
+        for (size_t i = 0; i < queue->capacity; ++i)
+            queue->sequences[i].store(i, std::memory_order_relaxed);
+    }
+
+    TraceLog(LOG_DEBUG, "QUEUE: Created %s queue '%s' (%zu x %zu bytes)", multiProducer ? "MPSC" : "SPSC",
+             queue->name.c_str(), queue->capacity, queue->recordSize);
+
+    g_Queues.push_back(std::move(queue));
+    return g_Queues.back().get();
+}
+
+GAME_API Queue *QueueFind(const char *name)
+{
+    if (!name || name[0] == '\0')
+        return nullptr;
+
+    std::lock_guard<std::mutex> lock(g_QueuesMutex);
+    for (const auto &queue : g_Queues)
+    {
+        if (queue->name == name)
+            return queue.get();
+    }
+
+    return nullptr;
+}
+
+GAME_API void QueueDestroy(Queue *queue)
+{
+    if (!queue)
+        return;
+
+    std::lock_guard<std::mutex> lock(g_QueuesMutex);
+    auto it = std::find_if(g_Queues.begin(), g_Queues.end(), [queue](const auto &q) { return q.get() == queue; });
+    if (it != g_Queues.end())
+        g_Queues.erase(it);
+}
+
+void UnloadQueues()
+{
+    std::lock_guard<std::mutex> lock(g_QueuesMutex);
+    g_Queues.clear();
+}
+
+static bool SPSC_Push(Queue *queue, const void *record)
+{
+    const size_t tail = queue->tail.load(std::memory_order_relaxed);
+    if (tail - queue->cachedHead >= queue->capacity)
+    {
+        queue->cachedHead = queue->head.load(std::memory_order_acquire);
+        if (tail - queue->cachedHead >= queue->capacity)
+            return false;
+    }
+
+    memcpy(queue->Slot(tail), record, queue->recordSize);
+    queue->tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+static bool SPSC_Pop(Queue *queue, void *record)
+{
+    const size_t head = queue->head.load(std::memory_order_relaxed);
+    if (head == queue->cachedTail)
+    {
+        queue->cachedTail = queue->tail.load(std::memory_order_acquire);
+        if (head == queue->cachedTail)
+            return false;
+    }
+
+    memcpy(record, queue->Slot(head), queue->recordSize);
+    queue->head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+static int SPSC_PushN(Queue *queue, const unsigned char *records, int count)
+{
+    const size_t tail = queue->tail.load(std::memory_order_relaxed);
+    size_t space = queue->capacity - (tail - queue->cachedHead);
+    if (space < static_cast<size_t>(count))
+    {
+        queue->cachedHead = queue->head.load(std::memory_order_acquire);
+        space = queue->capacity - (tail - queue->cachedHead);
+    }
+
+    const size_t n = std::min(space, static_cast<size_t>(count));
+    const size_t first = std::min(n, queue->capacity - (tail & queue->mask));
+    memcpy(queue->Slot(tail), records, first * queue->recordSize);
+    memcpy(queue->Slot(tail + first), records + first * queue->recordSize, (n - first) * queue->recordSize);
+
+    queue->tail.store(tail + n, std::memory_order_release);
+    return static_cast<int>(n);
+}
+
+static int SPSC_PopN(Queue *queue, unsigned char *records, int count)
+{
+    const size_t head = queue->head.load(std::memory_order_relaxed);
+    size_t available = queue->cachedTail - head;
+    if (available < static_cast<size_t>(count))
+    {
+        queue->cachedTail = queue->tail.load(std::memory_order_acquire);
+        available = queue->cachedTail - head;
+    }
+
+    const size_t n = std::min(available, static_cast<size_t>(count));
+    const size_t first = std::min(n, queue->capacity - (head & queue->mask));
+    memcpy(records, queue->Slot(head), first * queue->recordSize);
+    memcpy(records + first * queue->recordSize, queue->Slot(head + first), (n - first) * queue->recordSize);
+
+    queue->head.store(head + n, std::memory_order_release);
+    return static_cast<int>(n);
+}
+
+// Bounded MPMC scheme (D. Vyukov) restricted to a single consumer
+static bool MPSC_Push(Queue *queue, const void *record)
+{
+    size_t pos = queue->tail.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        const size_t seq = queue->sequences[pos & queue->mask].load(std::memory_order_acquire);
+        const ptrdiff_t diff = static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos);
+
+        if (diff == 0)
+        {
+            if (queue->tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            pos = queue->tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    memcpy(queue->Slot(pos), record, queue->recordSize);
+    queue->sequences[pos & queue->mask].store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+static bool MPSC_Pop(Queue *queue, void *record)
+{
+    const size_t pos = queue->head.load(std::memory_order_relaxed);
+    const size_t seq = queue->sequences[pos & queue->mask].load(std::memory_order_acquire);
+    if (seq != pos + 1)
+        return false;
+
+    memcpy(record, queue->Slot(pos), queue->recordSize);
+    queue->sequences[pos & queue->mask].store(pos + queue->capacity, std::memory_order_release);
+    queue->head.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+GAME_API bool QueuePush(Queue *queue, const void *record)
+{
+    if (!queue || !record)
+        return false;
+
+    return queue->multiProducer ? MPSC_Push(queue, record) : SPSC_Push(queue, record);
+}
+
+GAME_API bool QueuePop(Queue *queue, void *record)
+{
+    if (!queue || !record)
+        return false;
+
+    return queue->multiProducer ? MPSC_Pop(queue, record) : SPSC_Pop(queue, record);
+}
+
+GAME_API int QueuePushN(Queue *queue, const void *records, int count)
+{
+    if (!queue || !records || count <= 0)
+        return 0;
+
+    const unsigned char *bytes = static_cast<const unsigned char *>(records);
+    if (!queue->multiProducer)
+        return SPSC_PushN(queue, bytes, count);
+
+    int pushed = 0;
+    while (pushed < count && MPSC_Push(queue, bytes + pushed * queue->recordSize))
+        ++pushed;
+    return pushed;
+}
+
+GAME_API int QueuePopN(Queue *queue, void *records, int count)
+{
+    if (!queue || !records || count <= 0)
+        return 0;
+
+    unsigned char *bytes = static_cast<unsigned char *>(records);
+    if (!queue->multiProducer)
+        return SPSC_PopN(queue, bytes, count);
+
+    int popped = 0;
+    while (popped < count && MPSC_Pop(queue, bytes + popped * queue->recordSize))
+        ++popped;
+    return popped;
+}
+
+GAME_API int QueueCount(const Queue *queue)
+{
+    if (!queue)
+        return 0;
+
+    // Approximate while producers are active
+    const size_t head = queue->head.load(std::memory_order_acquire);
+    const size_t tail = queue->tail.load(std::memory_order_acquire);
+    return tail > head ? static_cast<int>(std::min(tail - head, queue->capacity)) : 0;
+}
+
+GAME_API int QueueCapacity(const Queue *queue)
+{
+    return queue ? static_cast<int>(queue->capacity) : 0;
+}
+
+GAME_API int QueueRecordSize(const Queue *queue)
+{
+    return queue ? static_cast<int>(queue->recordSize) : 0;
+}
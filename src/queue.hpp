@@ -0,0 +1,25 @@
+#ifndef QUEUE_HPP
+#define QUEUE_HPP
+
+#include "api.hpp"
+
+// Bounded lock-free ring buffer of fixed-size records.
+// Single consumer; one producer (SPSC) or many producers (MPSC).
+struct Queue;
+
+GAME_API Queue *QueueCreate(const char *name, int recordSize, int capacity, bool multiProducer);
+GAME_API Queue *QueueFind(const char *name);
+GAME_API void QueueDestroy(Queue *queue);
+
+GAME_API bool QueuePush(Queue *queue, const void *record);
+GAME_API bool QueuePop(Queue *queue, void *record);
+GAME_API int QueuePushN(Queue *queue, const void *records, int count);
+GAME_API int QueuePopN(Queue *queue, void *records, int count);
+
+GAME_API int QueueCount(const Queue *queue);
+GAME_API int QueueCapacity(const Queue *queue);
+GAME_API int QueueRecordSize(const Queue *queue);
+
+void UnloadQueues();
+
+#endif
@@ -0,0 +1,289 @@
+#include "renderbatch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <raylib/raylib.h>
+#include <raylib/rlgl.h>
+
+static constexpr int DEFAULT_BUFFERS = 3;
+static constexpr int MIN_BUFFERS = 2;
+static constexpr int DEFAULT_MAX_BUFFERS = 8;
+static constexpr int DEFAULT_MIN_ELEMENTS = 2048;
+static constexpr int DEFAULT_MAX_ELEMENTS = 32768;
+
+// rlgl wraps its buffer cursor at bufferCount. Every real buffer is listed this
+// many times in the array rlgl cycles through, so the cursor can count up to
+// RING_REPEAT * buffers - 1 flushes per frame while the buffers still rotate in order
+static constexpr int RING_REPEAT = 64;
+
+// Each buffer carries probes at 1/8 .. 7/8 of its capacity and one just below
+// the point where rlgl flushes a full buffer. A probe that got overwritten
+// during the frame tells how far that buffer was filled.
+static constexpr int FILL_PROBES = 8;
+static constexpr int FULL_MARGIN = 16;
+static constexpr uint32_t PROBE_BITS = 0x7fc0beefu; // quiet NaN, never written by rlgl
+
+// Frames a smaller batch has to be enough before it is shrunk
+static constexpr int SIZING_WINDOW = 300;
+
+static rlRenderBatch g_Batch = {};
+static rlVertexBuffer *g_Buffers = nullptr; // the bufferCount buffers rlLoadRenderBatch made
+static std::vector<rlVertexBuffer> g_Ring;
+static int g_BufferCount = 0;
+static int g_BufferElements = 0;
+static int g_LastCursor = 0;
+
+static int g_MinElements = DEFAULT_MIN_ELEMENTS;
+static int g_MaxElements = DEFAULT_MAX_ELEMENTS;
+static int g_MaxBuffers = DEFAULT_MAX_BUFFERS;
+static bool g_AutoSize = true;
+
+static int g_WindowFrames = 0;
+static int g_WindowPeakLevel = 0;
+static RenderBatchStats g_Stats = {};
+
+static int ProbeVertex(int elements, int probe)
+{
+    const int capacity = elements * 4;
+    return (probe == FILL_PROBES - 1) ? capacity - FULL_MARGIN : capacity * (probe + 1) / FILL_PROBES - 1;
+}
+
+static bool ProbeIntact(const rlVertexBuffer &buffer, int vertex)
+{
+    uint32_t bits;
+    memcpy(&bits, &buffer.vertices[vertex * 3], sizeof(bits));
+    return bits == PROBE_BITS;
+}
+
+// Vertices queued in the current buffer and not drawn yet
+static int PendingVertices()
+{
+    int pending = 0;
+    for (int i = 0; i < g_Batch.drawCounter - 1; i++)
+        pending += g_Batch.draws[i].vertexCount + g_Batch.draws[i].vertexAlignment;
+    return pending + g_Batch.draws[g_Batch.drawCounter - 1].vertexCount;
+}
+
+// Re-arms every probe that does not hold queued vertex data
+static void ResetProbes(int currentBuffer, int pending)
+{
+    for (int b = 0; b < g_BufferCount; b++)
+    {
+        for (int probe = 0; probe < FILL_PROBES; probe++)
+        {
+            const int vertex = ProbeVertex(g_BufferElements, probe);
+            if (b == currentBuffer && vertex < pending)
+                continue;
+            memcpy(&g_Buffers[b].vertices[vertex * 3], &PROBE_BITS, sizeof(PROBE_BITS));
+        }
+    }
+}
+
+static void FreeBatch()
+{
+    if (g_Buffers == nullptr)
+        return;
+
+    g_Batch.vertexBuffer = g_Buffers;
+    g_Batch.bufferCount = g_BufferCount;
+
+    if (IsWindowReady())
+    {
+        rlUnloadRenderBatch(g_Batch);
+    }
+    else
+    {
+        // The GL objects went with the context, only the CPU arrays are left
+        for (int i = 0; i < g_BufferCount; i++)
+        {
+            MemFree(g_Buffers[i].vertices);
+            MemFree(g_Buffers[i].texcoords);
+            MemFree(g_Buffers[i].normals);
+            MemFree(g_Buffers[i].colors);
+            MemFree(g_Buffers[i].indices);
+        }
+        MemFree(g_Buffers);
+        MemFree(g_Batch.draws);
+    }
+
+    g_Batch = {};
+    g_Buffers = nullptr;
+    g_Ring.clear();
+    g_BufferCount = 0;
+    g_BufferElements = 0;
+}
+
+// Swaps in a new batch between frames; rlgl falls back to its default batch
+// while the old one is freed
+static bool LoadBatch(int buffers, int elements)
+{
+    rlSetRenderBatchActive(nullptr);
+    FreeBatch();
+
+    g_Batch = rlLoadRenderBatch(buffers, elements);
+    if (g_Batch.vertexBuffer == nullptr)
+    {
+        TraceLog(LOG_WARNING, "BATCH: Failed to load %d buffers of %d quads", buffers, elements);
+        g_Batch = {};
+        return false;
+    }
+
+    g_Buffers = g_Batch.vertexBuffer;
+    g_BufferCount = buffers;
+    g_BufferElements = elements;
+
+    g_Ring.resize(static_cast<size_t>(buffers) * RING_REPEAT);
+    for (size_t i = 0; i < g_Ring.size(); i++)
+        g_Ring[i] = g_Buffers[i % buffers];
+    g_Batch.vertexBuffer = g_Ring.data();
+    g_Batch.bufferCount = static_cast<int>(g_Ring.size());
+    g_Batch.currentBuffer = 0;
+    g_LastCursor = 0;
+
+    ResetProbes(-1, 0);
+    rlSetRenderBatchActive(&g_Batch);
+
+    g_Stats.buffers = buffers;
+    g_Stats.bufferElements = elements;
+    return true;
+}
+
+GAME_API bool RenderBatchesInit(int buffers, int bufferElements)
+{
+    if (!IsWindowReady())
+    {
+        TraceLog(LOG_WARNING, "BATCH: Render batches need a window");
+        return false;
+    }
+
+    buffers = std::max(buffers > 0 ? buffers : DEFAULT_BUFFERS, MIN_BUFFERS);
+    bufferElements = bufferElements > 0 ? bufferElements : RL_DEFAULT_BATCH_BUFFER_ELEMENTS;
+
+    g_Stats = {};
+    g_WindowFrames = 0;
+    g_WindowPeakLevel = 0;
+    if (!LoadBatch(buffers, bufferElements))
+        return false;
+
+    TraceLog(LOG_INFO, "BATCH: %d vertex buffers of %d quads", buffers, bufferElements);
+    return true;
+}
+
+GAME_API void RenderBatchesSetLimits(int minElements, int maxElements, int maxBuffers, bool autoSize)
+{
+    g_MinElements = std::max(minElements > 0 ? minElements : DEFAULT_MIN_ELEMENTS, 64);
+    g_MaxElements = std::max(maxElements > 0 ? maxElements : DEFAULT_MAX_ELEMENTS, g_MinElements);
+    g_MaxBuffers = std::max(maxBuffers > 0 ? maxBuffers : DEFAULT_MAX_BUFFERS, MIN_BUFFERS);
+    g_AutoSize = autoSize;
+}
+
+GAME_API void RenderBatchesFrame()
+{
+    if (g_Buffers == nullptr)
+        return;
+
+    const int ringSize = g_BufferCount * RING_REPEAT;
+    const int cursor = g_Batch.currentBuffer;
+    const int flushes = (cursor - g_LastCursor + ringSize) % ringSize;
+    g_LastCursor = cursor;
+
+    // Highest probe overwritten in any buffer, 0 when none was reached
+    int level = 0;
+    for (int b = 0; b < g_BufferCount; b++)
+    {
+        for (int probe = FILL_PROBES - 1; probe >= level; probe--)
+        {
+            if (!ProbeIntact(g_Buffers[b], ProbeVertex(g_BufferElements, probe)))
+            {
+                level = probe + 1;
+                break;
+            }
+        }
+    }
+
+    const bool overflowed = level == FILL_PROBES;
+    g_Stats.flushes = flushes;
+    g_Stats.peakFlushes = std::max(g_Stats.peakFlushes, flushes);
+    g_Stats.peakVertices = g_BufferElements * 4 * level / FILL_PROBES;
+    g_Stats.overflows += overflowed ? 1 : 0;
+    g_Stats.frames++;
+
+    g_WindowPeakLevel = std::max(g_WindowPeakLevel, level);
+    g_WindowFrames++;
+
+    const int pending = PendingVertices();
+    int buffers = g_BufferCount;
+    int elements = g_BufferElements;
+
+    if (g_AutoSize && pending == 0)
+    {
+        // Grow right away so a dense scene stalls for one frame at most: the
+        // frame needed about `flushes` full buffers
+        if (overflowed)
+        {
+            int grown = elements * 2;
+            while (grown < elements * flushes && grown < g_MaxElements)
+                grown *= 2;
+            elements = std::min(grown, g_MaxElements);
+        }
+        if (flushes > buffers)
+            buffers = std::min(flushes, g_MaxBuffers);
+
+        // Shrink only after a whole window of frames fit into the smaller size
+        if (g_WindowFrames >= SIZING_WINDOW)
+        {
+            if (g_WindowPeakLevel <= FILL_PROBES / 4 && elements == g_BufferElements)
+                elements = std::max(elements / 2, g_MinElements);
+            if (g_Stats.peakFlushes < buffers)
+                buffers = std::max(g_Stats.peakFlushes, MIN_BUFFERS);
+        }
+    }
+
+    if (g_WindowFrames >= SIZING_WINDOW)
+    {
+        g_WindowFrames = 0;
+        g_WindowPeakLevel = 0;
+        g_Stats.peakFlushes = 0;
+    }
+
+    if (buffers != g_BufferCount || elements != g_BufferElements)
+    {
+        TraceLog(LOG_INFO, "BATCH: Resizing to %d buffers of %d quads (%d flushes, fill %d/%d)",
+                 buffers, elements, flushes, level, FILL_PROBES);
+        const int previousBuffers = g_BufferCount;
+        const int previousElements = g_BufferElements;
+        if (LoadBatch(buffers, elements))
+        {
+            g_Stats.resizes++;
+            g_WindowFrames = 0;
+            g_WindowPeakLevel = 0;
+        }
+        else
+        {
+            LoadBatch(previousBuffers, previousElements);
+        }
+        return;
+    }
+
+    ResetProbes(cursor % g_BufferCount, pending);
+}
+
+GAME_API void RenderBatchesGetStats(RenderBatchStats *stats)
+{
+    *stats = g_Stats;
+}
+
+GAME_API void UnloadRenderBatches()
+{
+    if (g_Buffers == nullptr)
+        return;
+
+    if (IsWindowReady())
+        rlSetRenderBatchActive(nullptr);
+    FreeBatch();
+    g_Stats.buffers = 0;
+    g_Stats.bufferElements = 0;
+}
@@ -0,0 +1,34 @@
+#ifndef RENDERBATCH_HPP
+#define RENDERBATCH_HPP
+
+#include "api.hpp"
+
+// Replaces rlgl's default render batch (one vertex buffer, rewritten on every
+// flush while the GPU may still be reading it) with a multi-buffered one.
+// rlgl moves to the next buffer after each flush; the manager measures
+// flushes and buffer fill once per frame and resizes the batch between frames.
+struct RenderBatchStats
+{
+    int buffers;        // vertex buffers rlgl rotates through
+    int bufferElements; // quads per buffer
+    int flushes;        // batch draws during the last frame
+    int peakFlushes;    // most flushes in one frame of the current sizing window
+    int peakVertices;   // fullest buffer of the last frame, rounded down to 1/8 of its capacity
+    int overflows;      // frames where a full buffer forced an extra flush
+    int resizes;
+    int frames;
+};
+
+// Needs a window. 0 picks the default for either argument
+GAME_API bool RenderBatchesInit(int buffers, int bufferElements);
+// Automatic sizing bounds; sizing is off while autoSize is false
+GAME_API void RenderBatchesSetLimits(int minElements, int maxElements, int maxBuffers, bool autoSize);
+// Call once per frame after EndDrawing: counts the frame's flushes and resizes if needed
+GAME_API void RenderBatchesFrame();
+GAME_API void RenderBatchesGetStats(RenderBatchStats *stats);
+
+// Gives rlgl its default batch back; call before CloseWindow, the host also
+// calls it at exit and only frees CPU memory once the window is gone
+GAME_API void UnloadRenderBatches();
+
+#endif
@@ -0,0 +1,136 @@
+#include "resources.hpp"
+
+#include <unordered_map>
+#include <string>
+#include <mutex>
+
+#include <raylib/raylib.h>
+
+struct ResourceEntry
+{
+    std::string fileName;
+    unsigned char *sourceData = nullptr;
+    int sourceSize = 0;
+};
+
+static const char *RESOURCE_TYPE_NAMES[RESOURCE_TYPE_COUNT] = {"image", "wave", "music", "font", "texture"};
+
+// One map per type, IDs from different types (e.g. texture ids and pointers) may collide.
+// Background loaders can register, so every access takes the lock.
+static std::mutex g_ResourcesMutex;
+static std::unordered_map<uint64_t, ResourceEntry> g_Resources[RESOURCE_TYPE_COUNT];
+static int64_t g_ResourceSourceBytes = 0;
+
+static bool IsValidType(int type)
+{
+    if (type < 0 || type >= RESOURCE_TYPE_COUNT)
+    {
+        TraceLog(LOG_ERROR, "RES: Invalid resource type %d", type);
+        return false;
+    }
+    return true;
+}
+
+GAME_API bool ResourceRegister(int type, uint64_t key, const char *fileName, unsigned char *sourceData, int sourceSize)
+{
+    if (!IsValidType(type) || key == 0)
+    {
+        UnloadFileData(sourceData);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(g_ResourcesMutex);
+
+    auto [it, inserted] = g_Resources[type].try_emplace(key);
+    ResourceEntry &entry = it->second;
+    if (!inserted)
+    {
+        // The previous owner of this ID was unloaded without going through the wrapper
+        TraceLog(LOG_WARNING, "RES: %s '%s' replaced '%s' without being released", RESOURCE_TYPE_NAMES[type],
+                 fileName ? fileName : "", entry.fileName.c_str());
+        g_ResourceSourceBytes -= entry.sourceSize;
+        UnloadFileData(entry.sourceData);
+    }
+
+    entry.fileName = fileName ? fileName : "";
+    entry.sourceData = sourceData;
+    entry.sourceSize = sourceData ? sourceSize : 0;
+    g_ResourceSourceBytes += entry.sourceSize;
+    return true;
+}
+
+GAME_API bool ResourceRelease(int type, uint64_t key)
+{
+    if (!IsValidType(type))
+        return false;
+
+    unsigned char *sourceData = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(g_ResourcesMutex);
+
+        auto it = g_Resources[type].find(key);
+        if (it == g_Resources[type].end())
+            return false;
+
+        sourceData = it->second.sourceData;
+        g_ResourceSourceBytes -= it->second.sourceSize;
+        g_Resources[type].erase(it);
+    }
+
+    UnloadFileData(sourceData);
+    return true;
+}
+
+GAME_API int ResourceCount(int type)
+{
+    std::lock_guard<std::mutex> lock(g_ResourcesMutex);
+
+    if (type >= 0 && type < RESOURCE_TYPE_COUNT)
+        return static_cast<int>(g_Resources[type].size());
+
+    size_t count = 0;
+    for (const auto &resources : g_Resources)
+        count += resources.size();
+    return static_cast<int>(count);
+}
+
+GAME_API int64_t ResourceSourceBytes()
+{
+    std::lock_guard<std::mutex> lock(g_ResourcesMutex);
+    return g_ResourceSourceBytes;
+}
+
+GAME_API int ResourceReportLeaks()
+{
+    std::lock_guard<std::mutex> lock(g_ResourcesMutex);
+
+    int count = 0;
+    for (int type = 0; type < RESOURCE_TYPE_COUNT; type++)
+    {
+        for (const auto &[key, entry] : g_Resources[type])
+        {
+            TraceLog(LOG_WARNING, "RES: Leaked %s '%s' (%d source bytes held)", RESOURCE_TYPE_NAMES[type],
+                     entry.fileName.c_str(), entry.sourceSize);
+            count++;
+        }
+    }
+
+    if (count > 0)
+        TraceLog(LOG_WARNING, "RES: %d resources were never unloaded", count);
+
+    return count;
+}
+
+void UnloadResources()
+{
+    ResourceReportLeaks();
+
+    std::lock_guard<std::mutex> lock(g_ResourcesMutex);
+    for (auto &resources : g_Resources)
+    {
+        for (auto &[key, entry] : resources)
+            UnloadFileData(entry.sourceData);
+        resources.clear();
+    }
+    g_ResourceSourceBytes = 0;
+}
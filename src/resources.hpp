@@ -0,0 +1,34 @@
+#ifndef RESOURCES_HPP
+#define RESOURCES_HPP
+
+#include "api.hpp"
+
+#include <cstdint>
+
+// Tracks resources loaded through the Lua wrappers, keyed by an ID that stays
+// the same across copies of the returned struct (Image.data, Music.stream.buffer, ...)
+// rather than by the struct itself.
+enum ResourceType
+{
+    RESOURCE_IMAGE = 0,
+    RESOURCE_WAVE = 1,
+    RESOURCE_MUSIC = 2,
+    RESOURCE_FONT = 3,
+    RESOURCE_TEXTURE = 4,
+    RESOURCE_TYPE_COUNT
+};
+
+// Takes ownership of sourceData (may be null), freed with UnloadFileData on release
+GAME_API bool ResourceRegister(int type, uint64_t key, const char *fileName, unsigned char *sourceData, int sourceSize);
+// Frees the source data of a registered resource, false if the key is unknown
+GAME_API bool ResourceRelease(int type, uint64_t key);
+
+GAME_API int ResourceCount(int type);       // live resources of a type, -1 for all types
+GAME_API int64_t ResourceSourceBytes();     // source bytes currently held by the registry
+// Logs every live resource as a warning and returns how many there are
+GAME_API int ResourceReportLeaks();
+
+// Reports leaks and frees whatever is still registered
+void UnloadResources();
+
+#endif
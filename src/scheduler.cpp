@@ -0,0 +1,174 @@
+#include "scheduler.hpp"
+#include "queue.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <mutex>
+
+#include <raylib/raylib.h>
+
+struct JobRequest
+{
+    int token;
+    char *fileName;
+};
+
+static constexpr int JOB_QUEUE_CAPACITY = 1024;
+
+// Min-heap of (wake time, token), sleeping coroutines cost one entry each
+using Timer = std::pair<double, int>;
+static std::vector<Timer> g_Timers;
+
+static Queue *g_JobRequests = nullptr;
+static Queue *g_JobResults = nullptr;
+
+static std::thread g_Worker;
+static std::mutex g_WorkerMutex;
+static std::condition_variable g_WorkerSignal;
+static std::atomic<bool> g_WorkerRunning{false};
+
+static void WorkerMain();
+
+bool InitScheduler()
+{
+    g_JobRequests = QueueCreate("scheduler.requests", sizeof(JobRequest), JOB_QUEUE_CAPACITY, true);
+    g_JobResults = QueueCreate("scheduler.jobs", sizeof(JobResult), JOB_QUEUE_CAPACITY, true);
+    if (!g_JobRequests || !g_JobResults)
+    {
+        TraceLog(LOG_ERROR, "SCHED: Could not create job queues");
+        return false;
+    }
+
+    g_WorkerRunning = true;
+    g_Worker = std::thread(WorkerMain);
+    return true;
+}
+
+void UnloadScheduler()
+{
+    if (g_Worker.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(g_WorkerMutex);
+            g_WorkerRunning = false;
+        }
+        g_WorkerSignal.notify_all();
+        g_Worker.join();
+    }
+
+    // Release anything nobody picked up
+    JobRequest request;
+    while (QueuePop(g_JobRequests, &request))
+        MemFree(request.fileName);
+
+    JobResult result;
+    while (QueuePop(g_JobResults, &result))
+    {
+        if (result.data)
+            UnloadFileData(result.data);
+    }
+
+    QueueDestroy(g_JobRequests);
+    QueueDestroy(g_JobResults);
+    g_JobRequests = nullptr;
+    g_JobResults = nullptr;
+    g_Timers.clear();
+}
+
+GAME_API void SchedulerSleep(int token, double wakeTime)
+{
+    g_Timers.emplace_back(wakeTime, token);
+    std::push_heap(g_Timers.begin(), g_Timers.end(), std::greater<Timer>());
+}
+
+GAME_API int SchedulerPollTimers(double now, int *tokens, int maxTokens)
+{
+    if (!tokens || maxTokens <= 0)
+        return 0;
+
+    int count = 0;
+    while (count < maxTokens && !g_Timers.empty() && g_Timers.front().first <= now)
+    {
+        std::pop_heap(g_Timers.begin(), g_Timers.end(), std::greater<Timer>());
+        tokens[count++] = g_Timers.back().second;
+        g_Timers.pop_back();
+    }
+
+    return count;
+}
+
+GAME_API int SchedulerTimerCount()
+{
+    return static_cast<int>(g_Timers.size());
+}
+
+static void PushResult(const JobResult &result)
+{
+    while (!QueuePush(g_JobResults, &result))
+    {
+        // The main thread drains results once per frame
+        if (!g_WorkerRunning)
+        {
+            if (result.data)
+                UnloadFileData(result.data);
+            return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+GAME_API void SchedulerLoadFile(int token, const char *fileName)
+{
+    if (!fileName || !g_JobRequests)
+    {
+        SchedulerComplete(token, -1);
+        return;
+    }
+
+    const size_t length = strlen(fileName);
+    JobRequest request = {token, static_cast<char *>(MemAlloc(static_cast<unsigned int>(length + 1)))};
+    memcpy(request.fileName, fileName, length + 1);
+
+    if (!QueuePush(g_JobRequests, &request))
+    {
+        TraceLog(LOG_WARNING, "SCHED: Job queue full, could not load %s", fileName);
+        MemFree(request.fileName);
+        SchedulerComplete(token, -1);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(g_WorkerMutex);
+    g_WorkerSignal.notify_one();
+}
+
+GAME_API void SchedulerComplete(int token, int status)
+{
+    if (g_JobResults)
+        PushResult({token, status, nullptr, 0});
+}
+
+static void WorkerMain()
+{
+    while (g_WorkerRunning)
+    {
+        JobRequest request;
+        if (!QueuePop(g_JobRequests, &request))
+        {
+            std::unique_lock<std::mutex> lock(g_WorkerMutex);
+            g_WorkerSignal.wait(lock, [] { return !g_WorkerRunning || QueueCount(g_JobRequests) > 0; });
+            continue;
+        }
+
+        int dataSize = 0;
+        unsigned char *data = LoadFileData(request.fileName, &dataSize);
+        MemFree(request.fileName);
+
+        PushResult({request.token, data ? 0 : -1, data, dataSize});
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include "api.hpp"
+
+// Completion record pushed to the "scheduler.jobs" queue
+struct JobResult
+{
+    int token;
+    int status; // 0 on success
+    unsigned char *data;
+    int dataSize;
+};
+
+// Timers, tokens identify the waiting coroutine on the Lua side
+GAME_API void SchedulerSleep(int token, double wakeTime);
+GAME_API int SchedulerPollTimers(double now, int *tokens, int maxTokens);
+GAME_API int SchedulerTimerCount();
+
+// Background jobs, completions are delivered through the jobs queue
+GAME_API void SchedulerLoadFile(int token, const char *fileName);
+GAME_API void SchedulerComplete(int token, int status);
+
+bool InitScheduler();
+void UnloadScheduler();
+
+#endif
@@ -0,0 +1,358 @@
+#include "soa.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+#include <cfloat>
+#include <cmath>
+#include <new>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SOA_SSE2 1
+#endif
+
+// Arrays are padded to a multiple of 8 floats and 32-byte aligned (AVX width)
+static constexpr size_t SOA_ALIGNMENT = 32;
+static constexpr int SOA_PADDING = 8;
+
+static float *AllocateArray(int capacity)
+{
+    float *array = static_cast<float *>(::operator new(capacity * sizeof(float), std::align_val_t{SOA_ALIGNMENT}, std::nothrow));
+    if (array)
+        std::memset(array, 0, capacity * sizeof(float));
+    return array;
+}
+
+static void FreeArray(float *array)
+{
+    if (array)
+        ::operator delete(array, std::align_val_t{SOA_ALIGNMENT});
+}
+
+static bool GrowArray(float *&array, int count, int capacity)
+{
+    float *grown = AllocateArray(capacity);
+    if (!grown)
+        return false;
+
+    if (array)
+        std::memcpy(grown, array, count * sizeof(float));
+    FreeArray(array);
+    array = grown;
+    return true;
+}
+
+static bool Reserve(VectorBuffer *buffer, int capacity)
+{
+    capacity = (capacity + SOA_PADDING - 1) / SOA_PADDING * SOA_PADDING;
+    if (capacity <= buffer->capacity)
+        return true;
+
+    if (!GrowArray(buffer->x, buffer->count, capacity) || !GrowArray(buffer->y, buffer->count, capacity))
+        return false;
+    if (buffer->components == 3 && !GrowArray(buffer->z, buffer->count, capacity))
+        return false;
+
+    buffer->capacity = capacity;
+    return true;
+}
+
+GAME_API VectorBuffer *VectorBufferCreate(int capacity, int components)
+{
+    if (capacity < 0 || (components != 2 && components != 3))
+    {
+        TraceLog(LOG_ERROR, "SOA: Invalid capacity (%d) or component count (%d)", capacity, components);
+        return nullptr;
+    }
+
+    VectorBuffer *buffer = new VectorBuffer{};
+    buffer->components = components;
+
+    if (!Reserve(buffer, std::max(capacity, 1)))
+    {
+        TraceLog(LOG_ERROR, "SOA: Could not allocate %d vectors", capacity);
+        VectorBufferDestroy(buffer);
+        return nullptr;
+    }
+
+    return buffer;
+}
+
+GAME_API void VectorBufferDestroy(VectorBuffer *buffer)
+{
+    if (!buffer)
+        return;
+
+    FreeArray(buffer->x);
+    FreeArray(buffer->y);
+    FreeArray(buffer->z);
+    delete buffer;
+}
+
+GAME_API bool VectorBufferResize(VectorBuffer *buffer, int count)
+{
+    if (count < 0)
+        return false;
+
+    if (count > buffer->capacity && !Reserve(buffer, std::max(count, buffer->capacity * 2)))
+    {
+        TraceLog(LOG_ERROR, "SOA: Could not grow buffer to %d vectors", count);
+        return false;
+    }
+
+    // shrinking zeroes the tail so growing again starts from clean values
+    if (count < buffer->count)
+    {
+        const size_t bytes = (buffer->count - count) * sizeof(float);
+        std::memset(buffer->x + count, 0, bytes);
+        std::memset(buffer->y + count, 0, bytes);
+        if (buffer->z)
+            std::memset(buffer->z + count, 0, bytes);
+    }
+
+    buffer->count = count;
+    return true;
+}
+
+GAME_API void VectorBufferFill(VectorBuffer *buffer, Vector3 value)
+{
+    std::fill_n(buffer->x, buffer->count, value.x);
+    std::fill_n(buffer->y, buffer->count, value.y);
+    if (buffer->z)
+        std::fill_n(buffer->z, buffer->count, value.z);
+}
+
+static void ScaleArray(float *array, int count, float scale)
+{
+    int i = 0;
+#if defined(SOA_SSE2)
+    const __m128 s = _mm_set1_ps(scale);
+    for (; i + 4 <= count; i += 4)
+        _mm_store_ps(array + i, _mm_mul_ps(_mm_load_ps(array + i), s));
+#endif
+    for (; i < count; i++)
+        array[i] *= scale;
+}
+
+GAME_API void VectorBufferScale(VectorBuffer *buffer, float scale)
+{
+    ScaleArray(buffer->x, buffer->count, scale);
+    ScaleArray(buffer->y, buffer->count, scale);
+    if (buffer->z)
+        ScaleArray(buffer->z, buffer->count, scale);
+}
+
+static void AxpyArray(float *y, float a, const float *x, int count)
+{
+    int i = 0;
+#if defined(SOA_SSE2)
+    const __m128 va = _mm_set1_ps(a);
+    for (; i + 4 <= count; i += 4)
+        _mm_store_ps(y + i, _mm_add_ps(_mm_load_ps(y + i), _mm_mul_ps(va, _mm_load_ps(x + i))));
+#endif
+    for (; i < count; i++)
+        y[i] += a * x[i];
+}
+
+GAME_API void VectorBufferAxpy(VectorBuffer *y, float a, const VectorBuffer *x)
+{
+    const int count = std::min(y->count, x->count);
+    AxpyArray(y->x, a, x->x, count);
+    AxpyArray(y->y, a, x->y, count);
+    if (y->z && x->z)
+        AxpyArray(y->z, a, x->z, count);
+}
+
+GAME_API void VectorBufferNormalize(VectorBuffer *buffer)
+{
+    float *xs = buffer->x;
+    float *ys = buffer->y;
+    float *zs = buffer->z;
+    const int count = buffer->count;
+
+    int i = 0;
+#if defined(SOA_SSE2)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 x = _mm_load_ps(xs + i);
+        const __m128 y = _mm_load_ps(ys + i);
+        const __m128 z = zs ? _mm_load_ps(zs + i) : zero;
+
+        const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+        // zero-length vectors are left untouched, like Vector3Normalize
+        const __m128 nonZero = _mm_cmpgt_ps(lengthSq, zero);
+        const __m128 inverse = _mm_div_ps(one, _mm_sqrt_ps(_mm_or_ps(_mm_and_ps(nonZero, lengthSq), _mm_andnot_ps(nonZero, one))));
+
+        _mm_store_ps(xs + i, _mm_mul_ps(x, inverse));
+        _mm_store_ps(ys + i, _mm_mul_ps(y, inverse));
+        if (zs)
+            _mm_store_ps(zs + i, _mm_mul_ps(z, inverse));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        const float z = zs ? zs[i] : 0.0f;
+        const float length = std::sqrt(xs[i] * xs[i] + ys[i] * ys[i] + z * z);
+        if (length > 0.0f)
+        {
+            const float inverse = 1.0f / length;
+            xs[i] *= inverse;
+            ys[i] *= inverse;
+            if (zs)
+                zs[i] *= inverse;
+        }
+    }
+}
+
+GAME_API void VectorBufferTransform(VectorBuffer *out, const VectorBuffer *in, Matrix mat)
+{
+    const int count = std::min(out->count, in->count);
+    const float *xs = in->x;
+    const float *ys = in->y;
+    const float *zs = in->z;
+
+    int i = 0;
+#if defined(SOA_SSE2)
+    const __m128 m0 = _mm_set1_ps(mat.m0), m4 = _mm_set1_ps(mat.m4), m8 = _mm_set1_ps(mat.m8), m12 = _mm_set1_ps(mat.m12);
+    const __m128 m1 = _mm_set1_ps(mat.m1), m5 = _mm_set1_ps(mat.m5), m9 = _mm_set1_ps(mat.m9), m13 = _mm_set1_ps(mat.m13);
+    const __m128 m2 = _mm_set1_ps(mat.m2), m6 = _mm_set1_ps(mat.m6), m10 = _mm_set1_ps(mat.m10), m14 = _mm_set1_ps(mat.m14);
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 x = _mm_load_ps(xs + i);
+        const __m128 y = _mm_load_ps(ys + i);
+        const __m128 z = zs ? _mm_load_ps(zs + i) : _mm_setzero_ps();
+
+        _mm_store_ps(out->x + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m4, y)), _mm_add_ps(_mm_mul_ps(m8, z), m12)));
+        _mm_store_ps(out->y + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, x), _mm_mul_ps(m5, y)), _mm_add_ps(_mm_mul_ps(m9, z), m13)));
+        if (out->z)
+            _mm_store_ps(out->z + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, x), _mm_mul_ps(m6, y)), _mm_add_ps(_mm_mul_ps(m10, z), m14)));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        const float x = xs[i];
+        const float y = ys[i];
+        const float z = zs ? zs[i] : 0.0f;
+
+        out->x[i] = mat.m0 * x + mat.m4 * y + mat.m8 * z + mat.m12;
+        out->y[i] = mat.m1 * x + mat.m5 * y + mat.m9 * z + mat.m13;
+        if (out->z)
+            out->z[i] = mat.m2 * x + mat.m6 * y + mat.m10 * z + mat.m14;
+    }
+}
+
+#if defined(SOA_SSE2)
+static inline __m128 DistanceSq4(const VectorBuffer *buffer, int i, __m128 px, __m128 py, __m128 pz)
+{
+    const __m128 dx = _mm_sub_ps(_mm_load_ps(buffer->x + i), px);
+    const __m128 dy = _mm_sub_ps(_mm_load_ps(buffer->y + i), py);
+    __m128 distanceSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+    if (buffer->z)
+    {
+        const __m128 dz = _mm_sub_ps(_mm_load_ps(buffer->z + i), pz);
+        distanceSq = _mm_add_ps(distanceSq, _mm_mul_ps(dz, dz));
+    }
+    return distanceSq;
+}
+#endif
+
+static inline float DistanceSq(const VectorBuffer *buffer, int i, Vector3 point)
+{
+    const float dx = buffer->x[i] - point.x;
+    const float dy = buffer->y[i] - point.y;
+    const float dz = buffer->z ? buffer->z[i] - point.z : 0.0f;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+GAME_API void VectorBufferDistances(const VectorBuffer *buffer, Vector3 point, float *distances)
+{
+    const int count = buffer->count;
+
+    int i = 0;
+#if defined(SOA_SSE2)
+    const __m128 px = _mm_set1_ps(point.x), py = _mm_set1_ps(point.y), pz = _mm_set1_ps(point.z);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(distances + i, _mm_sqrt_ps(DistanceSq4(buffer, i, px, py, pz)));
+#endif
+    for (; i < count; i++)
+        distances[i] = std::sqrt(DistanceSq(buffer, i, point));
+}
+
+GAME_API int VectorBufferWithinRadius(const VectorBuffer *buffer, Vector3 point, float radius, int *indices, int maxIndices)
+{
+    const int count = buffer->count;
+    const float radiusSq = radius * radius;
+    int found = 0;
+
+    int i = 0;
+#if defined(SOA_SSE2)
+    const __m128 px = _mm_set1_ps(point.x), py = _mm_set1_ps(point.y), pz = _mm_set1_ps(point.z);
+    const __m128 r = _mm_set1_ps(radiusSq);
+    for (; i + 4 <= count; i += 4)
+    {
+        int mask = _mm_movemask_ps(_mm_cmple_ps(DistanceSq4(buffer, i, px, py, pz), r));
+        while (mask != 0)
+        {
+            if (found == maxIndices)
+                return found;
+
+            int lane = 0;
+            while (!(mask & (1 << lane)))
+                lane++;
+            mask &= mask - 1;
+            indices[found++] = i + lane;
+        }
+    }
+#endif
+    for (; i < count && found < maxIndices; i++)
+    {
+        if (DistanceSq(buffer, i, point) <= radiusSq)
+            indices[found++] = i;
+    }
+
+    return found;
+}
+
+GAME_API int VectorBufferNearest(const VectorBuffer *buffer, Vector3 point)
+{
+    const int count = buffer->count;
+    float bestDistanceSq = FLT_MAX;
+    int best = -1;
+
+    int i = 0;
+#if defined(SOA_SSE2)
+    const __m128 px = _mm_set1_ps(point.x), py = _mm_set1_ps(point.y), pz = _mm_set1_ps(point.z);
+    for (; i + 4 <= count; i += 4)
+    {
+        alignas(16) float distanceSq[4];
+        const __m128 d = DistanceSq4(buffer, i, px, py, pz);
+        // only look at the lanes when one of them beats the current best
+        if (_mm_movemask_ps(_mm_cmplt_ps(d, _mm_set1_ps(bestDistanceSq))) == 0)
+            continue;
+
+        _mm_store_ps(distanceSq, d);
+        for (int lane = 0; lane < 4; lane++)
+        {
+            if (distanceSq[lane] < bestDistanceSq)
+            {
+                bestDistanceSq = distanceSq[lane];
+                best = i + lane;
+            }
+        }
+    }
+#endif
+    for (; i < count; i++)
+    {
+        const float distanceSq = DistanceSq(buffer, i, point);
+        if (distanceSq < bestDistanceSq)
+        {
+            bestDistanceSq = distanceSq;
+            best = i;
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,37 @@
+#ifndef SOA_HPP
+#define SOA_HPP
+
+#include "api.hpp"
+
+#include <raylib/raylib.h>
+
+// Structure-of-arrays vectors: one contiguous, 32-byte aligned float array
+// per component. z is NULL for 2D buffers. Lua indexes the arrays directly.
+struct VectorBuffer
+{
+    float *x;
+    float *y;
+    float *z;
+    int count;
+    int capacity;
+    int components; // 2 or 3
+};
+
+GAME_API VectorBuffer *VectorBufferCreate(int capacity, int components);
+GAME_API void VectorBufferDestroy(VectorBuffer *buffer);
+// Grows the arrays when needed, new elements are zeroed
+GAME_API bool VectorBufferResize(VectorBuffer *buffer, int count);
+
+// Kernels run over min(count) of their operands, out may be the input buffer
+GAME_API void VectorBufferFill(VectorBuffer *buffer, Vector3 value);
+GAME_API void VectorBufferScale(VectorBuffer *buffer, float scale);
+GAME_API void VectorBufferAxpy(VectorBuffer *y, float a, const VectorBuffer *x); // y += a * x
+GAME_API void VectorBufferNormalize(VectorBuffer *buffer);
+GAME_API void VectorBufferTransform(VectorBuffer *out, const VectorBuffer *in, Matrix mat);
+
+// Distance queries against a single point (z ignored for 2D buffers)
+GAME_API void VectorBufferDistances(const VectorBuffer *buffer, Vector3 point, float *distances);
+GAME_API int VectorBufferWithinRadius(const VectorBuffer *buffer, Vector3 point, float radius, int *indices, int maxIndices);
+GAME_API int VectorBufferNearest(const VectorBuffer *buffer, Vector3 point);
+
+#endif
@@ -0,0 +1,471 @@
+#include "sprites.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include <raylib/rlgl.h>
+
+#define RAYMATH_STATIC_INLINE
+#include <raylib/raymath.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SPRITES_USE_SSE2 1
+#endif
+
+// Indices are 16-bit, so one draw call reaches at most 65536 vertices; longer
+// runs are split and the attribute pointers moved to the next segment
+static constexpr int QUADS_PER_SEGMENT = 16384;
+// Vertex buffers cycled between frames so the CPU never rewrites one the GPU may still read
+static constexpr int VERTEX_BUFFER_COUNT = 3;
+// Sort keys keep the sprite index in their low bits
+static constexpr int MAX_SPRITES = 1 << 24;
+
+// Per quad: 4 xy positions, 4 uv texcoords, 4 RGBA colors
+static constexpr int POSITION_BYTES = 4 * 2 * sizeof(float);
+static constexpr int TEXCOORD_BYTES = 4 * 2 * sizeof(float);
+static constexpr int COLOR_BYTES = 4 * sizeof(uint32_t);
+
+struct SpriteBatch
+{
+    std::vector<float> positions;
+    std::vector<float> texcoords;
+    std::vector<uint32_t> colors;
+    std::vector<uint64_t> keys;
+    std::vector<uint64_t> scratch;
+    std::vector<SpriteRun> runs;
+    int quadCount = 0;
+
+    Shader shaders[SPRITE_BATCH_MAX_SHADERS] = {};
+    SpriteBatchStats stats = {};
+
+    // GPU side, created on the first draw with a window
+    unsigned int vaoId = 0;
+    unsigned int indexBufferId = 0;
+    unsigned int vertexBufferIds[VERTEX_BUFFER_COUNT] = {};
+    int gpuCapacity = 0;
+    int currentBuffer = 0;
+};
+
+static void Reserve(SpriteBatch *batch, int count)
+{
+    if (static_cast<size_t>(count) * 8 <= batch->positions.size())
+        return;
+
+    batch->positions.resize(static_cast<size_t>(count) * 8);
+    batch->texcoords.resize(static_cast<size_t>(count) * 8);
+    batch->colors.resize(static_cast<size_t>(count) * 4);
+    batch->keys.resize(count);
+    batch->scratch.resize(count);
+}
+
+GAME_API SpriteBatch *SpriteBatchCreate(int capacity)
+{
+    auto *batch = new SpriteBatch();
+    Reserve(batch, std::clamp(capacity, 1, MAX_SPRITES));
+    return batch;
+}
+
+static void UnloadGpuBuffers(SpriteBatch *batch)
+{
+    if (batch->vaoId == 0)
+        return;
+
+    for (unsigned int &id : batch->vertexBufferIds)
+    {
+        rlUnloadVertexBuffer(id);
+        id = 0;
+    }
+    rlUnloadVertexBuffer(batch->indexBufferId);
+    rlUnloadVertexArray(batch->vaoId);
+    batch->indexBufferId = 0;
+    batch->vaoId = 0;
+    batch->gpuCapacity = 0;
+}
+
+GAME_API void SpriteBatchDestroy(SpriteBatch *batch)
+{
+    if (!batch)
+        return;
+
+    if (IsWindowReady())
+        UnloadGpuBuffers(batch);
+    delete batch;
+}
+
+GAME_API bool SpriteBatchSetShader(SpriteBatch *batch, int slot, Shader shader)
+{
+    if (!batch || slot <= 0 || slot >= SPRITE_BATCH_MAX_SHADERS)
+    {
+        TraceLog(LOG_WARNING, "SPRITES: Shader slot %d out of range (1..%d)", slot, SPRITE_BATCH_MAX_SHADERS - 1);
+        return false;
+    }
+
+    batch->shaders[slot] = shader;
+    return true;
+}
+
+// --- Sorting ---
+
+// layer | shader | texture in the top 40 bits, submission index in the low 24
+static uint64_t SortKey(const Sprite &sprite, int index)
+{
+    const uint64_t layer = static_cast<uint64_t>(std::clamp(sprite.layer, -32768, 32767) + 32768);
+    const uint64_t shader = static_cast<uint64_t>(sprite.shader) & 0xFF;
+    const uint64_t texture = sprite.texture.id & 0xFFFF;
+    return (layer << 48) | (shader << 40) | (texture << 24) | static_cast<uint64_t>(index);
+}
+
+// LSD radix sort over the 5 key bytes; stable, so equal keys keep submission order.
+// Bytes that are the same for every sprite (one layer, one shader) are skipped.
+static void SortKeys(SpriteBatch *batch, int count)
+{
+    uint64_t *keys = batch->keys.data();
+    uint64_t *scratch = batch->scratch.data();
+
+    int histograms[5][256] = {};
+    for (int i = 0; i < count; i++)
+    {
+        for (int pass = 0; pass < 5; pass++)
+            histograms[pass][(keys[i] >> (24 + 8 * pass)) & 0xFF]++;
+    }
+
+    for (int pass = 0; pass < 5; pass++)
+    {
+        int *histogram = histograms[pass];
+        const int shift = 24 + 8 * pass;
+        if (histogram[(keys[0] >> shift) & 0xFF] == count)
+            continue;
+
+        int offset = 0;
+        for (int bucket = 0; bucket < 256; bucket++)
+        {
+            const int bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+
+        for (int i = 0; i < count; i++)
+            scratch[histogram[(keys[i] >> shift) & 0xFF]++] = keys[i];
+
+        std::swap(keys, scratch);
+    }
+
+    // An odd number of passes leaves the result in the scratch buffer
+    if (keys != batch->keys.data())
+        std::swap(batch->keys, batch->scratch);
+}
+
+// --- Vertex generation ---
+
+// Same math and operation order as DrawTexturePro, corners in top-left,
+// bottom-left, bottom-right, top-right order
+static void WriteQuad(const Sprite &sprite, float *positions, float *texcoords, uint32_t *colors)
+{
+    float sourceX = sprite.source.x;
+    float sourceY = sprite.source.y;
+    float sourceWidth = sprite.source.width;
+    const float sourceHeight = sprite.source.height;
+
+    const bool flipX = sourceWidth < 0;
+    if (flipX)
+        sourceWidth = -sourceWidth;
+    if (sourceHeight < 0)
+        sourceY -= sourceHeight;
+
+    const float width = static_cast<float>(sprite.texture.width);
+    const float height = static_cast<float>(sprite.texture.height);
+    float u0 = sourceX / width;
+    float u1 = (sourceX + sourceWidth) / width;
+    if (flipX)
+        std::swap(u0, u1);
+    const float v0 = sourceY / height;
+    const float v1 = (sourceY + sourceHeight) / height;
+
+    const float w = sprite.dest.width;
+    const float h = sprite.dest.height;
+    const float dx = -sprite.origin.x;
+    const float dy = -sprite.origin.y;
+
+    uint32_t tint;
+    memcpy(&tint, &sprite.tint, sizeof(tint));
+
+#if defined(SPRITES_USE_SSE2)
+    __m128 x, y;
+    if (sprite.rotation == 0.0f)
+    {
+        x = _mm_add_ps(_mm_set1_ps(sprite.dest.x - sprite.origin.x), _mm_setr_ps(0.0f, 0.0f, w, w));
+        y = _mm_add_ps(_mm_set1_ps(sprite.dest.y - sprite.origin.y), _mm_setr_ps(0.0f, h, h, 0.0f));
+    }
+    else
+    {
+        const float radians = sprite.rotation * DEG2RAD;
+        const __m128 s = _mm_set1_ps(sinf(radians));
+        const __m128 c = _mm_set1_ps(cosf(radians));
+        const __m128 lx = _mm_setr_ps(dx, dx, dx + w, dx + w);
+        const __m128 ly = _mm_setr_ps(dy, dy + h, dy + h, dy);
+        x = _mm_sub_ps(_mm_add_ps(_mm_set1_ps(sprite.dest.x), _mm_mul_ps(lx, c)), _mm_mul_ps(ly, s));
+        y = _mm_add_ps(_mm_add_ps(_mm_set1_ps(sprite.dest.y), _mm_mul_ps(lx, s)), _mm_mul_ps(ly, c));
+    }
+
+    _mm_storeu_ps(positions, _mm_unpacklo_ps(x, y));
+    _mm_storeu_ps(positions + 4, _mm_unpackhi_ps(x, y));
+
+    const __m128 u = _mm_setr_ps(u0, u0, u1, u1);
+    const __m128 v = _mm_setr_ps(v0, v1, v1, v0);
+    _mm_storeu_ps(texcoords, _mm_unpacklo_ps(u, v));
+    _mm_storeu_ps(texcoords + 4, _mm_unpackhi_ps(u, v));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(colors), _mm_set1_epi32(static_cast<int>(tint)));
+#else
+    const float lx[4] = {dx, dx, dx + w, dx + w};
+    const float ly[4] = {dy, dy + h, dy + h, dy};
+    if (sprite.rotation == 0.0f)
+    {
+        const float x = sprite.dest.x - sprite.origin.x;
+        const float y = sprite.dest.y - sprite.origin.y;
+        const float ox[4] = {0.0f, 0.0f, w, w};
+        const float oy[4] = {0.0f, h, h, 0.0f};
+        for (int i = 0; i < 4; i++)
+        {
+            positions[2 * i] = x + ox[i];
+            positions[2 * i + 1] = y + oy[i];
+        }
+    }
+    else
+    {
+        const float radians = sprite.rotation * DEG2RAD;
+        const float s = sinf(radians);
+        const float c = cosf(radians);
+        for (int i = 0; i < 4; i++)
+        {
+            positions[2 * i] = sprite.dest.x + lx[i] * c - ly[i] * s;
+            positions[2 * i + 1] = sprite.dest.y + lx[i] * s + ly[i] * c;
+        }
+    }
+
+    const float u[4] = {u0, u0, u1, u1};
+    const float v[4] = {v0, v1, v1, v0};
+    for (int i = 0; i < 4; i++)
+    {
+        texcoords[2 * i] = u[i];
+        texcoords[2 * i + 1] = v[i];
+        colors[i] = tint;
+    }
+#endif
+}
+
+GAME_API int SpriteBatchBuild(SpriteBatch *batch, const Sprite *sprites, int count)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    batch->runs.clear();
+    batch->quadCount = 0;
+    batch->stats = {};
+    if (!sprites || count <= 0)
+        return 0;
+
+    if (count > MAX_SPRITES)
+    {
+        TraceLog(LOG_WARNING, "SPRITES: %d sprites submitted, only the first %d are drawn", count, MAX_SPRITES);
+        count = MAX_SPRITES;
+    }
+    Reserve(batch, count);
+
+    bool sorted = true;
+    uint64_t *keys = batch->keys.data();
+    for (int i = 0; i < count; i++)
+    {
+        keys[i] = SortKey(sprites[i], i);
+        sorted = sorted && (i == 0 || keys[i - 1] < keys[i]);
+    }
+    if (!sorted)
+        SortKeys(batch, count);
+    keys = batch->keys.data();
+
+    float *positions = batch->positions.data();
+    float *texcoords = batch->texcoords.data();
+    uint32_t *colors = batch->colors.data();
+    int quad = 0;
+    for (int i = 0; i < count; i++)
+    {
+        const Sprite &sprite = sprites[keys[i] & (MAX_SPRITES - 1)];
+        if (sprite.texture.id == 0)
+            continue;
+
+        WriteQuad(sprite, positions + quad * 8, texcoords + quad * 8, colors + quad * 4);
+
+        const int shader = std::clamp(sprite.shader, 0, SPRITE_BATCH_MAX_SHADERS - 1);
+        if (batch->runs.empty() || batch->runs.back().texture != sprite.texture.id || batch->runs.back().shader != shader)
+            batch->runs.push_back({quad, 0, sprite.texture.id, shader});
+        batch->runs.back().count++;
+        quad++;
+    }
+
+    batch->quadCount = quad;
+    batch->stats.sprites = quad;
+    batch->stats.runs = static_cast<int>(batch->runs.size());
+    batch->stats.sortSkipped = sorted;
+    batch->stats.buildMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return batch->stats.runs;
+}
+
+// --- Drawing ---
+
+static void EnsureGpuBuffers(SpriteBatch *batch)
+{
+    if (batch->gpuCapacity >= batch->quadCount)
+        return;
+
+    UnloadGpuBuffers(batch);
+
+    const int capacity = static_cast<int>(batch->positions.size() / 8);
+    batch->vaoId = rlLoadVertexArray();
+    rlEnableVertexArray(batch->vaoId);
+
+    for (unsigned int &id : batch->vertexBufferIds)
+        id = rlLoadVertexBuffer(nullptr, capacity * (POSITION_BYTES + TEXCOORD_BYTES + COLOR_BYTES), true);
+
+    // 0,1,2, 0,2,3 per quad, the same for every segment
+    std::vector<unsigned short> indices(QUADS_PER_SEGMENT * 6);
+    for (int i = 0; i < QUADS_PER_SEGMENT; i++)
+    {
+        const unsigned short base = static_cast<unsigned short>(i * 4);
+        const unsigned short quad[6] = {base, static_cast<unsigned short>(base + 1), static_cast<unsigned short>(base + 2),
+                                        base, static_cast<unsigned short>(base + 2), static_cast<unsigned short>(base + 3)};
+        memcpy(&indices[i * 6], quad, sizeof(quad));
+    }
+    batch->indexBufferId = rlLoadVertexBufferElement(indices.data(), static_cast<int>(indices.size() * sizeof(unsigned short)), false);
+
+    rlDisableVertexArray();
+    batch->gpuCapacity = capacity;
+}
+
+// Points the shader's attributes at one 16384-quad segment of the current vertex buffer
+static void BindSegment(const SpriteBatch *batch, const int *locs, int segment)
+{
+    const int capacity = batch->gpuCapacity;
+    const int quad = segment * QUADS_PER_SEGMENT;
+
+    const int attributes[3] = {locs[SHADER_LOC_VERTEX_POSITION], locs[SHADER_LOC_VERTEX_TEXCOORD01], locs[SHADER_LOC_VERTEX_COLOR]};
+    const int offsets[3] = {quad * POSITION_BYTES, capacity * POSITION_BYTES + quad * TEXCOORD_BYTES,
+                            capacity * (POSITION_BYTES + TEXCOORD_BYTES) + quad * COLOR_BYTES};
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (attributes[i] < 0)
+            continue;
+
+        if (i < 2)
+            rlSetVertexAttribute(attributes[i], 2, RL_FLOAT, false, 0, offsets[i]);
+        else
+            rlSetVertexAttribute(attributes[i], 4, RL_UNSIGNED_BYTE, true, 0, offsets[i]);
+        rlEnableVertexAttribute(attributes[i]);
+    }
+}
+
+static void EnableShader(const Shader &shader, const Matrix &mvp)
+{
+    rlEnableShader(shader.id);
+    rlSetUniformMatrix(shader.locs[SHADER_LOC_MATRIX_MVP], mvp);
+
+    const float white[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    const int textureSlot = 0;
+    rlSetUniform(shader.locs[SHADER_LOC_COLOR_DIFFUSE], white, RL_SHADER_UNIFORM_VEC4, 1);
+    rlSetUniform(shader.locs[SHADER_LOC_MAP_DIFFUSE], &textureSlot, RL_SHADER_UNIFORM_INT, 1);
+}
+
+GAME_API void SpriteBatchDraw(SpriteBatch *batch)
+{
+    batch->stats.drawCalls = 0;
+    if (batch->quadCount == 0 || !IsWindowReady())
+        return;
+
+    // Everything raylib queued so far goes first, sprites draw on top of it
+    rlDrawRenderBatchActive();
+
+    EnsureGpuBuffers(batch);
+    batch->currentBuffer = (batch->currentBuffer + 1) % VERTEX_BUFFER_COUNT;
+    const unsigned int vertexBufferId = batch->vertexBufferIds[batch->currentBuffer];
+
+    const int capacity = batch->gpuCapacity;
+    const int quads = batch->quadCount;
+    rlUpdateVertexBuffer(vertexBufferId, batch->positions.data(), quads * POSITION_BYTES, 0);
+    rlUpdateVertexBuffer(vertexBufferId, batch->texcoords.data(), quads * TEXCOORD_BYTES, capacity * POSITION_BYTES);
+    rlUpdateVertexBuffer(vertexBufferId, batch->colors.data(), quads * COLOR_BYTES, capacity * (POSITION_BYTES + TEXCOORD_BYTES));
+
+    // rlPushMatrix/rlTranslatef move raylib's quads on the CPU, the same transform goes in the MVP
+    const Matrix mvp = MatrixMultiply(rlGetMatrixTransform(), MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection()));
+    const Shader defaultShader = {rlGetShaderIdDefault(), rlGetShaderLocsDefault()};
+
+    rlEnableVertexArray(batch->vaoId);
+    rlEnableVertexBuffer(vertexBufferId);
+    rlEnableVertexBufferElement(batch->indexBufferId);
+    rlActiveTextureSlot(0);
+
+    int currentShader = -1;
+    int currentSegment = -1;
+    const int *locs = nullptr;
+    for (const SpriteRun &run : batch->runs)
+    {
+        if (run.shader != currentShader)
+        {
+            const Shader &shader = (run.shader > 0 && batch->shaders[run.shader].id != 0) ? batch->shaders[run.shader] : defaultShader;
+            EnableShader(shader, mvp);
+            locs = shader.locs;
+            currentShader = run.shader;
+            currentSegment = -1;
+        }
+
+        rlEnableTexture(run.texture);
+
+        for (int first = run.first, remaining = run.count; remaining > 0;)
+        {
+            const int segment = first / QUADS_PER_SEGMENT;
+            if (segment != currentSegment)
+            {
+                BindSegment(batch, locs, segment);
+                currentSegment = segment;
+            }
+
+            const int local = first - segment * QUADS_PER_SEGMENT;
+            const int count = std::min(remaining, QUADS_PER_SEGMENT - local);
+            rlDrawVertexArrayElements(local * 6, count * 6, nullptr);
+            batch->stats.drawCalls++;
+
+            first += count;
+            remaining -= count;
+        }
+    }
+
+    rlDisableTexture();
+    rlDisableVertexArray();
+    rlDisableVertexBuffer();
+    rlDisableVertexBufferElement();
+    rlDisableShader();
+}
+
+GAME_API void SpriteBatchSubmit(SpriteBatch *batch, const Sprite *sprites, int count)
+{
+    SpriteBatchBuild(batch, sprites, count);
+    SpriteBatchDraw(batch);
+}
+
+GAME_API void SpriteBatchGetData(const SpriteBatch *batch, SpriteBatchData *data)
+{
+    data->positions = batch->positions.data();
+    data->texcoords = batch->texcoords.data();
+    data->colors = batch->colors.data();
+    data->runs = batch->runs.data();
+    data->quadCount = batch->quadCount;
+    data->runCount = static_cast<int>(batch->runs.size());
+}
+
+GAME_API void SpriteBatchGetStats(const SpriteBatch *batch, SpriteBatchStats *stats)
+{
+    *stats = batch->stats;
+}
@@ -0,0 +1,76 @@
+#ifndef SPRITES_HPP
+#define SPRITES_HPP
+
+#include "api.hpp"
+
+#include <raylib/raylib.h>
+
+// Sprite batcher: takes a whole frame of sprites in one call, sorts them by
+// layer, shader and texture, builds quads into its own vertex buffer and draws
+// each run of equal state with one draw call.
+//
+// Fields match DrawTexturePro (negative source width/height flips). Layers are
+// drawn in ascending order; inside a layer sprites are grouped by shader, then
+// texture, and keep their submission order only within a group.
+struct Sprite
+{
+    Texture2D texture;
+    Rectangle source;
+    Rectangle dest;
+    Vector2 origin;
+    float rotation; // degrees
+    Color tint;
+    int layer;      // -32768..32767
+    int shader;     // slot set with SpriteBatchSetShader, 0 = raylib's default shader
+};
+
+struct SpriteBatch;
+
+// One draw: count quads starting at quad first, all with the same texture and shader
+struct SpriteRun
+{
+    int first;
+    int count;
+    unsigned int texture;
+    int shader;
+};
+
+// Read-only view of the last build, positions/texcoords are 4 xy pairs per quad,
+// colors 4 RGBA words per quad (top-left, bottom-left, bottom-right, top-right)
+struct SpriteBatchData
+{
+    const float *positions;
+    const float *texcoords;
+    const unsigned int *colors;
+    const SpriteRun *runs;
+    int quadCount;
+    int runCount;
+};
+
+struct SpriteBatchStats
+{
+    int sprites;        // quads in the last build
+    int runs;           // state changes, one draw call each (more when a run crosses 16384 quads)
+    int drawCalls;      // draw calls issued by the last SpriteBatchDraw
+    bool sortSkipped;   // input was already in order
+    float buildMs;      // sort + vertex generation
+};
+
+constexpr int SPRITE_BATCH_MAX_SHADERS = 16;
+
+GAME_API SpriteBatch *SpriteBatchCreate(int capacity);
+GAME_API void SpriteBatchDestroy(SpriteBatch *batch);
+GAME_API bool SpriteBatchSetShader(SpriteBatch *batch, int slot, Shader shader);
+
+// CPU side only, works without a window: sorts and writes the vertex data
+GAME_API int SpriteBatchBuild(SpriteBatch *batch, const Sprite *sprites, int count);
+// Uploads the last build and draws it, flushing raylib's own batch first so
+// earlier Draw* calls stay underneath; does nothing without a window
+GAME_API void SpriteBatchDraw(SpriteBatch *batch);
+// Build + Draw
+GAME_API void SpriteBatchSubmit(SpriteBatch *batch, const Sprite *sprites, int count);
+
+GAME_API void SpriteBatchGetData(const SpriteBatch *batch, SpriteBatchData *data);
+GAME_API void SpriteBatchGetStats(const SpriteBatch *batch, SpriteBatchStats *stats);
+
+#endif
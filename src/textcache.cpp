@@ -0,0 +1,309 @@
+#include "textcache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+static constexpr int DEFAULT_MAX_LAYOUTS = 1024;
+static constexpr int DEFAULT_LINE_SPACING = 2; // raylib's textLineSpacing
+
+// One glyph as DrawTextCodepoint draws it. The pen is relative to the text
+// position and the glyph offset (minus the padding) to the pen; they are added
+// up at draw time in raylib's order so the quads round to the same pixels.
+struct GlyphQuad
+{
+    Rectangle source;
+    Vector2 pen;
+    Rectangle dest;
+};
+
+struct TextLayout
+{
+    uint64_t hash;
+    // Identify the font: a font loaded at the address of an unloaded one has
+    // another texture (and usually another base size)
+    const GlyphInfo *glyphs;
+    unsigned int textureId;
+    int baseSize;
+    float fontSize;
+    float spacing;
+    std::string text;
+    std::vector<GlyphQuad> quads;
+    float padding; // glyph padding in screen pixels
+    Vector2 size;
+    uint64_t lastUsed;
+};
+
+struct TextCache
+{
+    std::vector<TextLayout> layouts;
+    std::unordered_map<uint64_t, int> index; // hash -> layout
+    int maxLayouts = DEFAULT_MAX_LAYOUTS;
+    int lineSpacing = DEFAULT_LINE_SPACING;
+    uint64_t frame = 0;
+
+    std::vector<Sprite> sprites; // this frame's glyphs
+    TextCacheStats stats = {};
+};
+
+// FNV-1a over the text, seeded with the rest of the key
+static uint64_t LayoutHash(const Font &font, float fontSize, float spacing, const char *text, size_t length)
+{
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void *data, size_t size) {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    mix(&font.glyphs, sizeof(font.glyphs));
+    mix(&font.texture.id, sizeof(font.texture.id));
+    mix(&font.baseSize, sizeof(font.baseSize));
+    mix(&fontSize, sizeof(fontSize));
+    mix(&spacing, sizeof(spacing));
+    mix(text, length);
+    return hash;
+}
+
+// Same walk as DrawTextEx (quads) and MeasureTextEx (size), codepoint by codepoint
+static void LayOut(const Font &font, const char *text, size_t length, float fontSize, float spacing, int lineSpacing,
+                   TextLayout &layout)
+{
+    layout.quads.clear();
+    const float scale = fontSize / static_cast<float>(font.baseSize);
+    const float padding = static_cast<float>(font.glyphPadding);
+    layout.padding = padding * scale;
+
+    float offsetX = 0.0f, offsetY = 0.0f;
+    // MeasureTextEx keeps unscaled widths and counts codepoints per line for the spacing
+    float lineWidth = 0.0f, maxWidth = 0.0f, height = fontSize;
+    int lineCount = 0, maxCount = 0;
+
+    for (size_t i = 0; i < length;)
+    {
+        int codepointSize = 0;
+        const int codepoint = GetCodepointNext(text + i, &codepointSize);
+        const int glyph = GetGlyphIndex(font, codepoint);
+        i += codepointSize;
+        lineCount++;
+
+        const GlyphInfo &info = font.glyphs[glyph];
+        const Rectangle &rec = font.recs[glyph];
+        if (codepoint == '\n')
+        {
+            offsetY += fontSize + static_cast<float>(lineSpacing);
+            offsetX = 0.0f;
+
+            maxWidth = std::max(maxWidth, lineWidth);
+            lineWidth = 0.0f;
+            lineCount = 0;
+            height += fontSize + static_cast<float>(lineSpacing);
+        }
+        else
+        {
+            if (codepoint != ' ' && codepoint != '\t')
+            {
+                GlyphQuad quad;
+                quad.source = {rec.x - padding, rec.y - padding, rec.width + 2.0f * padding, rec.height + 2.0f * padding};
+                quad.pen = {offsetX, offsetY};
+                quad.dest = {static_cast<float>(info.offsetX) * scale, static_cast<float>(info.offsetY) * scale,
+                             (rec.width + 2.0f * padding) * scale, (rec.height + 2.0f * padding) * scale};
+                layout.quads.push_back(quad);
+            }
+
+            offsetX += (info.advanceX == 0 ? rec.width : static_cast<float>(info.advanceX)) * scale + spacing;
+            lineWidth += info.advanceX > 0 ? static_cast<float>(info.advanceX) : rec.width + static_cast<float>(info.offsetX);
+        }
+        maxCount = std::max(maxCount, lineCount);
+    }
+
+    maxWidth = std::max(maxWidth, lineWidth);
+    layout.size = length == 0 ? Vector2{0.0f, 0.0f}
+                              : Vector2{maxWidth * scale + static_cast<float>(maxCount - 1) * spacing, height};
+}
+
+// Drops the least recently used half
+static void Evict(TextCache *cache)
+{
+    std::vector<uint64_t> stamps;
+    stamps.reserve(cache->layouts.size());
+    for (const TextLayout &layout : cache->layouts)
+        stamps.push_back(layout.lastUsed);
+    std::nth_element(stamps.begin(), stamps.begin() + stamps.size() / 2, stamps.end());
+    const uint64_t median = stamps[stamps.size() / 2];
+
+    const size_t before = cache->layouts.size();
+    cache->layouts.erase(std::remove_if(cache->layouts.begin(), cache->layouts.end(),
+                                        [median](const TextLayout &layout) { return layout.lastUsed <= median; }),
+                         cache->layouts.end());
+    cache->stats.evicted += static_cast<int>(before - cache->layouts.size());
+
+    cache->index.clear();
+    for (size_t i = 0; i < cache->layouts.size(); i++)
+        cache->index[cache->layouts[i].hash] = static_cast<int>(i);
+}
+
+static const TextLayout *FindLayout(TextCache *cache, const Font &font, const char *text, float fontSize, float spacing)
+{
+    const size_t length = strlen(text);
+    const uint64_t hash = LayoutHash(font, fontSize, spacing, text, length);
+
+    auto found = cache->index.find(hash);
+    if (found != cache->index.end())
+    {
+        TextLayout &layout = cache->layouts[found->second];
+        if (layout.glyphs == font.glyphs && layout.textureId == font.texture.id && layout.baseSize == font.baseSize &&
+            layout.fontSize == fontSize && layout.spacing == spacing &&
+            layout.text.size() == length && memcmp(layout.text.data(), text, length) == 0)
+        {
+            layout.lastUsed = cache->frame;
+            cache->stats.hits++;
+            return &layout;
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    cache->stats.misses++;
+
+    // A hash collision reuses the slot of the other string
+    TextLayout *layout = nullptr;
+    if (found != cache->index.end())
+    {
+        layout = &cache->layouts[found->second];
+    }
+    else
+    {
+        if (static_cast<int>(cache->layouts.size()) >= cache->maxLayouts)
+            Evict(cache);
+        cache->index[hash] = static_cast<int>(cache->layouts.size());
+        layout = &cache->layouts.emplace_back();
+    }
+
+    layout->hash = hash;
+    layout->glyphs = font.glyphs;
+    layout->textureId = font.texture.id;
+    layout->baseSize = font.baseSize;
+    layout->fontSize = fontSize;
+    layout->spacing = spacing;
+    layout->text.assign(text, length);
+    layout->lastUsed = cache->frame;
+    LayOut(font, text, length, fontSize, spacing, cache->lineSpacing, *layout);
+
+    cache->stats.layoutMs += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return layout;
+}
+
+GAME_API TextCache *TextCacheCreate(int maxLayouts)
+{
+    TextCache *cache = new TextCache();
+    cache->maxLayouts = maxLayouts > 0 ? maxLayouts : DEFAULT_MAX_LAYOUTS;
+    cache->layouts.reserve(cache->maxLayouts);
+    return cache;
+}
+
+GAME_API void TextCacheDestroy(TextCache *cache)
+{
+    delete cache;
+}
+
+GAME_API void TextCacheClear(TextCache *cache)
+{
+    cache->layouts.clear();
+    cache->index.clear();
+    cache->sprites.clear();
+}
+
+GAME_API void TextCacheSetLineSpacing(TextCache *cache, int spacing)
+{
+    if (cache->lineSpacing == spacing)
+        return;
+
+    TextCacheClear(cache);
+    cache->lineSpacing = spacing;
+}
+
+GAME_API Vector2 TextCacheAdd(TextCache *cache, Font font, const char *text, Vector2 position, float fontSize, float spacing,
+                              Color tint, int layer, int shader)
+{
+    if (!text || !font.glyphs || font.baseSize <= 0)
+        return {0.0f, 0.0f};
+
+    const TextLayout *layout = FindLayout(cache, font, text, fontSize, spacing);
+    for (const GlyphQuad &quad : layout->quads)
+    {
+        const Rectangle dest = {position.x + quad.pen.x + quad.dest.x - layout->padding,
+                                position.y + quad.pen.y + quad.dest.y - layout->padding, quad.dest.width, quad.dest.height};
+        cache->sprites.push_back({font.texture, quad.source, dest, {0.0f, 0.0f}, 0.0f, tint, layer, shader});
+    }
+
+    cache->stats.labels++;
+    cache->stats.glyphs += static_cast<int>(layout->quads.size());
+    return layout->size;
+}
+
+GAME_API Vector2 TextCacheMeasure(TextCache *cache, Font font, const char *text, float fontSize, float spacing)
+{
+    if (!text || !font.glyphs || font.baseSize <= 0)
+        return {0.0f, 0.0f};
+    return FindLayout(cache, font, text, fontSize, spacing)->size;
+}
+
+GAME_API int TextCacheGetSprites(const TextCache *cache, const Sprite **sprites)
+{
+    *sprites = cache->sprites.data();
+    return static_cast<int>(cache->sprites.size());
+}
+
+GAME_API void TextCacheSubmit(TextCache *cache, SpriteBatch *batch)
+{
+    if (batch && !cache->sprites.empty())
+        SpriteBatchSubmit(batch, cache->sprites.data(), static_cast<int>(cache->sprites.size()));
+
+    cache->sprites.clear();
+    cache->frame++;
+    cache->stats.labels = 0;
+    cache->stats.glyphs = 0;
+    cache->stats.hits = 0;
+    cache->stats.misses = 0;
+    cache->stats.layoutMs = 0.0f;
+}
+
+GAME_API void TextCacheGetStats(const TextCache *cache, TextCacheStats *stats)
+{
+    *stats = cache->stats;
+    stats->layouts = static_cast<int>(cache->layouts.size());
+}
+
+// The edge sits at stb_truetype's 128; smoothing over one screen pixel of distance
+// keeps the outline sharp whether the glyph is magnified or minified
+static const char *FONT_SDF_FS = R"(#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+uniform sampler2D texture0;
+uniform vec4 colDiffuse;
+out vec4 finalColor;
+void main()
+{
+    float distance = texture(texture0, fragTexCoord).r - 128.0/255.0;
+    float width = max(length(vec2(dFdx(distance), dFdy(distance))), 0.0001);
+    float alpha = smoothstep(-width, width, distance);
+    finalColor = vec4(fragColor.rgb, fragColor.a*alpha)*colDiffuse;
+}
+)";
+
+GAME_API Shader LoadFontSdfShader()
+{
+    if (!IsWindowReady())
+    {
+        TraceLog(LOG_WARNING, "TEXT: Shaders need a window");
+        return Shader{};
+    }
+
+    return LoadShaderFromMemory(nullptr, FONT_SDF_FS);
+}
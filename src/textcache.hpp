@@ -0,0 +1,56 @@
+#ifndef TEXTCACHE_HPP
+#define TEXTCACHE_HPP
+
+#include "api.hpp"
+#include "sprites.hpp"
+
+#include <raylib/raylib.h>
+
+// Text layout cache: the glyph quads of a string are laid out once per (font,
+// size, spacing, string) exactly like DrawTextEx does it, then reused while the
+// string keeps being drawn. Each frame's labels are queued as sprites and go out
+// through a SpriteBatch, one draw call per font texture.
+//
+// Least recently used layouts are dropped once maxLayouts is reached. Fonts are
+// told apart by their glyph array, so unloading a font should go with a clear.
+//
+// Signed distance field fonts (LoadFontCooked on a .sdf.rfnt, LoadFontSdfFromMemory)
+// lay out the same way; their labels name the batch's shader slot holding
+// LoadFontSdfShader.
+struct TextCache;
+
+struct TextCacheStats
+{
+    int layouts;    // cached now
+    int labels;     // queued since the last submit
+    int glyphs;
+    int hits;       // labels found in the cache since the last submit
+    int misses;
+    int evicted;    // layouts dropped so far
+    float layoutMs; // laying out the misses since the last submit
+};
+
+// maxLayouts 0 picks 1024
+GAME_API TextCache *TextCacheCreate(int maxLayouts);
+GAME_API void TextCacheDestroy(TextCache *cache);
+// Drops every layout (and the queued labels)
+GAME_API void TextCacheClear(TextCache *cache);
+// Vertical gap between lines, keep it equal to SetTextLineSpacing (raylib's default is 2)
+GAME_API void TextCacheSetLineSpacing(TextCache *cache, int spacing);
+
+// Queues text like DrawTextEx on a sprite layer and shader slot, returns its size like MeasureTextEx
+GAME_API Vector2 TextCacheAdd(TextCache *cache, Font font, const char *text, Vector2 position, float fontSize, float spacing,
+                              Color tint, int layer, int shader);
+// Size of the text, laid out and cached if needed
+GAME_API Vector2 TextCacheMeasure(TextCache *cache, Font font, const char *text, float fontSize, float spacing);
+
+// The queued glyphs, valid until the next add or submit
+GAME_API int TextCacheGetSprites(const TextCache *cache, const Sprite **sprites);
+// Draws the queued labels through batch and starts a new frame
+GAME_API void TextCacheSubmit(TextCache *cache, SpriteBatch *batch);
+GAME_API void TextCacheGetStats(const TextCache *cache, TextCacheStats *stats);
+
+// Fragment shader turning SDF glyphs into antialiased coverage at any scale, needs a window
+GAME_API Shader LoadFontSdfShader();
+
+#endif
@@ -0,0 +1,175 @@
+#include "texture.hpp"
+#include "bytes.hpp"
+
+#include <cstring>
+#include <vector>
+
+#include <raylib/rlgl.h>
+
+static constexpr char TEXTURE_PAYLOAD_MAGIC[4] = {'R', 'T', 'E', 'X'};
+
+// Same mip walk as rlLoadTexture, so the sizes always agree with what gets uploaded
+GAME_API int TexturePayloadDataSize(int width, int height, int format, int mipmaps)
+{
+    if (width <= 0 || height <= 0 || mipmaps <= 0 || format < PIXELFORMAT_UNCOMPRESSED_GRAYSCALE ||
+        format > PIXELFORMAT_COMPRESSED_ASTC_8x8_RGBA)
+        return 0;
+
+    int64_t size = 0;
+    for (int level = 0; level < mipmaps; level++)
+    {
+        size += GetPixelDataSize(width, height, format);
+        width = width > 1 ? width / 2 : 1;
+        height = height > 1 ? height / 2 : 1;
+    }
+
+    return size > INT32_MAX ? 0 : static_cast<int>(size);
+}
+
+GAME_API bool TexturePayloadParse(const unsigned char *fileData, int fileSize, TexturePayload *payload)
+{
+    if (!fileData || !payload || fileSize < TEXTURE_PAYLOAD_HEADER_SIZE ||
+        memcmp(fileData, TEXTURE_PAYLOAD_MAGIC, sizeof(TEXTURE_PAYLOAD_MAGIC)) != 0)
+    {
+        TraceLog(LOG_WARNING, "TEX: Not a cooked texture");
+        return false;
+    }
+
+    const uint16_t version = ReadU16(fileData + 4);
+    if (version != TEXTURE_PAYLOAD_VERSION)
+    {
+        TraceLog(LOG_WARNING, "TEX: Unsupported cooked texture version %d", version);
+        return false;
+    }
+
+    payload->flags = ReadU16(fileData + 6);
+    payload->width = ReadI32(fileData + 8);
+    payload->height = ReadI32(fileData + 12);
+    payload->format = ReadI32(fileData + 16);
+    payload->mipmaps = ReadI32(fileData + 20);
+    payload->dataSize = ReadI32(fileData + 24);
+    payload->data = fileData + TEXTURE_PAYLOAD_HEADER_SIZE;
+
+    const int expectedSize = TexturePayloadDataSize(payload->width, payload->height, payload->format, payload->mipmaps);
+    if (expectedSize == 0 || payload->dataSize != expectedSize ||
+        payload->dataSize > fileSize - TEXTURE_PAYLOAD_HEADER_SIZE)
+    {
+        TraceLog(LOG_WARNING, "TEX: Corrupt cooked texture (%dx%d, format %d, %d mipmaps, %d of %d bytes)",
+                 payload->width, payload->height, payload->format, payload->mipmaps,
+                 fileSize - TEXTURE_PAYLOAD_HEADER_SIZE, expectedSize);
+        return false;
+    }
+
+    return true;
+}
+
+bool AppendTexturePayload(const Image &image, unsigned int flags, std::vector<unsigned char> &file)
+{
+    const int dataSize = TexturePayloadDataSize(image.width, image.height, image.format, image.mipmaps);
+    if (!image.data || dataSize == 0)
+        return false;
+
+    const size_t offset = file.size();
+    file.resize(offset + TEXTURE_PAYLOAD_HEADER_SIZE + static_cast<size_t>(dataSize));
+
+    unsigned char *header = file.data() + offset;
+    memcpy(header, TEXTURE_PAYLOAD_MAGIC, sizeof(TEXTURE_PAYLOAD_MAGIC));
+    WriteU16(header + 4, TEXTURE_PAYLOAD_VERSION);
+    WriteU16(header + 6, static_cast<uint16_t>(flags));
+    WriteI32(header + 8, image.width);
+    WriteI32(header + 12, image.height);
+    WriteI32(header + 16, image.format);
+    WriteI32(header + 20, image.mipmaps);
+    WriteI32(header + 24, dataSize);
+    WriteI32(header + 28, 0);
+    memcpy(header + TEXTURE_PAYLOAD_HEADER_SIZE, image.data, dataSize);
+    return true;
+}
+
+GAME_API bool ExportTexturePayload(Image image, unsigned int flags, const char *fileName)
+{
+    std::vector<unsigned char> file;
+    if (!fileName || !AppendTexturePayload(image, flags, file))
+    {
+        TraceLog(LOG_WARNING, "TEX: Invalid image for cooked texture %s", fileName ? fileName : "");
+        return false;
+    }
+
+    return SaveFileData(fileName, file.data(), static_cast<int>(file.size()));
+}
+
+GAME_API Image LoadImageCooked(const char *fileName)
+{
+    int fileSize = 0;
+    unsigned char *fileData = LoadFileData(fileName, &fileSize);
+    if (!fileData)
+        return {};
+
+    TexturePayload payload;
+    if (!TexturePayloadParse(fileData, fileSize, &payload))
+    {
+        TraceLog(LOG_WARNING, "TEX: Failed to load cooked image %s", fileName);
+        UnloadFileData(fileData);
+        return {};
+    }
+
+    // Premultiplied colors cannot be turned back exactly, the caller decodes the source
+    if (payload.flags & TEXTURE_PAYLOAD_PREMULTIPLIED)
+    {
+        UnloadFileData(fileData);
+        return {};
+    }
+
+    // The file buffer becomes the image data: shift the base level over the header, no copy
+    const int dataSize = TexturePayloadDataSize(payload.width, payload.height, payload.format, 1);
+    memmove(fileData, payload.data, dataSize);
+
+    Image image = {};
+    image.data = MemRealloc(fileData, dataSize);
+    image.width = payload.width;
+    image.height = payload.height;
+    image.format = payload.format;
+    image.mipmaps = 1;
+    return image;
+}
+
+GAME_API Texture2D LoadTextureFromPayload(const TexturePayload *payload)
+{
+    Texture2D texture = {};
+    if (!payload || !payload->data)
+        return texture;
+
+    if (!IsWindowReady())
+    {
+        TraceLog(LOG_WARNING, "TEX: Cannot upload a texture without a window");
+        return texture;
+    }
+
+    texture.id = rlLoadTexture(payload->data, payload->width, payload->height, payload->format, payload->mipmaps);
+    if (texture.id == 0)
+        return texture;
+
+    texture.width = payload->width;
+    texture.height = payload->height;
+    texture.format = payload->format;
+    texture.mipmaps = payload->mipmaps;
+    return texture;
+}
+
+GAME_API Texture2D LoadTextureCooked(const char *fileName)
+{
+    int fileSize = 0;
+    unsigned char *fileData = LoadFileData(fileName, &fileSize);
+    if (!fileData)
+        return {};
+
+    Texture2D texture = {};
+    TexturePayload payload;
+    if (TexturePayloadParse(fileData, fileSize, &payload))
+        texture = LoadTextureFromPayload(&payload);
+    else
+        TraceLog(LOG_WARNING, "TEX: Failed to load cooked texture %s", fileName);
+
+    UnloadFileData(fileData);
+    return texture;
+}
@@ -0,0 +1,61 @@
+#ifndef TEXTURE_HPP
+#define TEXTURE_HPP
+
+#include "api.hpp"
+
+#include <cstdint>
+#include <vector>
+
+#include <raylib/raylib.h>
+
+// Cooked texture files (.rtex): a 32-byte header followed by pixel data that is
+// already in its final GPU layout (any raylib PixelFormat, compressed formats
+// included, all mip levels back to back). Loading is a parse and one upload,
+// no image decode.
+//
+//   char     magic[4]   "RTEX"
+//   uint16_t version    TEXTURE_PAYLOAD_VERSION
+//   uint16_t flags      TEXTURE_PAYLOAD_* bits
+//   int32_t  width, height, format, mipmaps, dataSize, reserved
+//
+// All fields are little-endian.
+constexpr uint16_t TEXTURE_PAYLOAD_VERSION = 1;
+constexpr int TEXTURE_PAYLOAD_HEADER_SIZE = 32;
+
+enum TexturePayloadFlags
+{
+    TEXTURE_PAYLOAD_PREMULTIPLIED = 1 << 0, // colors are multiplied by alpha, draw with BLEND_ALPHA_PREMULTIPLY
+};
+
+// A view into a cooked file's memory, data points inside the file buffer
+struct TexturePayload
+{
+    const unsigned char *data;
+    int dataSize;
+    int width;
+    int height;
+    int format;
+    int mipmaps;
+    unsigned int flags;
+};
+
+// Bytes of pixel data for a texture with all of its mip levels
+GAME_API int TexturePayloadDataSize(int width, int height, int format, int mipmaps);
+// Validates the header and data size, works without a GL context
+GAME_API bool TexturePayloadParse(const unsigned char *fileData, int fileSize, TexturePayload *payload);
+// Writes image (pixels, format and mipmaps as they are) as a cooked texture file
+GAME_API bool ExportTexturePayload(Image image, unsigned int flags, const char *fileName);
+
+// Decodes nothing: the base level's pixels become the image data, so it matches
+// LoadImage on the source. Premultiplied files return an empty image
+GAME_API Image LoadImageCooked(const char *fileName);
+
+// Uploads the payload as is, returns a texture with id 0 on failure or without a window
+GAME_API Texture2D LoadTextureFromPayload(const TexturePayload *payload);
+// Reads a cooked file through the VFS and uploads it straight from the file buffer
+GAME_API Texture2D LoadTextureCooked(const char *fileName);
+
+// Appends header and pixel data to file, used to embed textures in other cooked formats
+bool AppendTexturePayload(const Image &image, unsigned int flags, std::vector<unsigned char> &file);
+
+#endif
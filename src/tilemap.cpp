@@ -0,0 +1,387 @@
+#include "tilemap.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <raylib/rlgl.h>
+
+#define RAYMATH_STATIC_INLINE
+#include <raylib/raymath.h>
+
+static constexpr int DEFAULT_CHUNK_SIZE = 64;
+static constexpr int MIN_CHUNK_SIZE = 8;
+// 128 * 128 quads is 65536 vertices, the most 16-bit indices reach
+static constexpr int MAX_CHUNK_SIZE = 128;
+
+// Per vertex: xy position relative to the map, uv texcoord; 4 vertices per quad
+static constexpr int VERTEX_FLOATS = 4;
+static constexpr int VERTEX_BYTES = VERTEX_FLOATS * sizeof(float);
+static constexpr int QUAD_FLOATS = 4 * VERTEX_FLOATS;
+static constexpr int QUAD_BYTES = 4 * VERTEX_BYTES;
+
+struct TileChunk
+{
+    unsigned int vboId;
+    int quadCount;
+    int gpuCapacity; // quads
+    bool dirty;
+    bool notUploaded; // built without a window: rebuilt and uploaded once there is one
+};
+
+struct TileMapState : TileMap
+{
+    std::vector<uint16_t> tileData;
+    std::vector<TileChunk> chunks;
+    int chunksX = 0;
+    int chunksY = 0;
+
+    // u0, v0, u1, v1 per tile id, id 0 unused
+    std::vector<float> tileUVs;
+    Texture2D texture = {};
+
+    // Vertex data of the chunk being rebuilt, uploaded right away
+    std::vector<float> vertices;
+
+    // GPU side, created on the first draw with a window
+    unsigned int vaoId = 0;
+    unsigned int indexBufferId = 0;
+
+    TileMapStats stats = {};
+};
+
+static TileMapState *State(TileMap *map)
+{
+    return static_cast<TileMapState *>(map);
+}
+
+static const TileMapState *State(const TileMap *map)
+{
+    return static_cast<const TileMapState *>(map);
+}
+
+GAME_API TileMap *TileMapCreate(int width, int height, float tileWidth, float tileHeight, int chunkSize)
+{
+    if (width <= 0 || height <= 0 || tileWidth <= 0.0f || tileHeight <= 0.0f)
+    {
+        TraceLog(LOG_WARNING, "TILEMAP: Invalid map %dx%d of %.1fx%.1f tiles", width, height, tileWidth, tileHeight);
+        return nullptr;
+    }
+
+    TileMapState *map = new TileMapState{};
+    map->tileData.assign(static_cast<size_t>(width) * height, 0);
+    map->tiles = map->tileData.data();
+    map->width = width;
+    map->height = height;
+    map->tileWidth = tileWidth;
+    map->tileHeight = tileHeight;
+    map->chunkSize = std::clamp(chunkSize > 0 ? chunkSize : DEFAULT_CHUNK_SIZE, MIN_CHUNK_SIZE, MAX_CHUNK_SIZE);
+    map->position = {0.0f, 0.0f};
+    map->tint = WHITE;
+
+    map->chunksX = (width + map->chunkSize - 1) / map->chunkSize;
+    map->chunksY = (height + map->chunkSize - 1) / map->chunkSize;
+    map->chunks.assign(static_cast<size_t>(map->chunksX) * map->chunksY, {0, 0, 0, false, false});
+    map->vertices.resize(static_cast<size_t>(map->chunkSize) * map->chunkSize * QUAD_FLOATS);
+    map->stats.chunks = static_cast<int>(map->chunks.size());
+    return map;
+}
+
+GAME_API void TileMapDestroy(TileMap *map)
+{
+    if (!map)
+        return;
+
+    TileMapState *state = State(map);
+    if (IsWindowReady())
+    {
+        for (const TileChunk &chunk : state->chunks)
+            if (chunk.vboId != 0)
+                rlUnloadVertexBuffer(chunk.vboId);
+        if (state->vaoId != 0)
+        {
+            rlUnloadVertexBuffer(state->indexBufferId);
+            rlUnloadVertexArray(state->vaoId);
+        }
+    }
+    delete state;
+}
+
+GAME_API void TileMapMarkDirty(TileMap *map, int x, int y, int width, int height)
+{
+    TileMapState *state = State(map);
+    const int x0 = std::max(x, 0), y0 = std::max(y, 0);
+    const int x1 = std::min(x + width, map->width), y1 = std::min(y + height, map->height);
+    if (x0 >= x1 || y0 >= y1)
+        return;
+
+    const int size = map->chunkSize;
+    for (int cy = y0 / size; cy <= (y1 - 1) / size; cy++)
+        for (int cx = x0 / size; cx <= (x1 - 1) / size; cx++)
+            state->chunks[cy * state->chunksX + cx].dirty = true;
+}
+
+GAME_API void TileMapSetTileset(TileMap *map, Texture2D texture, Rectangle region, int tileWidth, int tileHeight, int spacing)
+{
+    TileMapState *state = State(map);
+    state->texture = texture;
+    state->tileUVs.assign(4, 0.0f);
+
+    if (region.width <= 0.0f || region.height <= 0.0f)
+        region = {0.0f, 0.0f, static_cast<float>(texture.width), static_cast<float>(texture.height)};
+    if (tileWidth > 0 && tileHeight > 0)
+    {
+        spacing = std::max(spacing, 0);
+        const int columns = (static_cast<int>(region.width) + spacing) / (tileWidth + spacing);
+        const int rows = (static_cast<int>(region.height) + spacing) / (tileHeight + spacing);
+        const int count = std::min(columns * rows, static_cast<int>(UINT16_MAX));
+
+        // Without a window textures are empty, the uvs do not matter then
+        const float textureWidth = texture.width > 0 ? static_cast<float>(texture.width) : 1.0f;
+        const float textureHeight = texture.height > 0 ? static_cast<float>(texture.height) : 1.0f;
+        for (int tile = 0; tile < count; tile++)
+        {
+            const float x = region.x + static_cast<float>((tile % columns) * (tileWidth + spacing));
+            const float y = region.y + static_cast<float>((tile / columns) * (tileHeight + spacing));
+            const float uv[4] = {x / textureWidth, y / textureHeight, (x + tileWidth) / textureWidth,
+                                 (y + tileHeight) / textureHeight};
+            state->tileUVs.insert(state->tileUVs.end(), uv, uv + 4);
+        }
+    }
+
+    TileMapMarkDirty(map, 0, 0, map->width, map->height);
+}
+
+GAME_API void TileMapSetTile(TileMap *map, int x, int y, int tile)
+{
+    if (x < 0 || y < 0 || x >= map->width || y >= map->height)
+        return;
+
+    uint16_t &cell = map->tiles[static_cast<size_t>(y) * map->width + x];
+    const uint16_t value = static_cast<uint16_t>(std::clamp(tile, 0, static_cast<int>(UINT16_MAX)));
+    if (cell == value)
+        return;
+
+    cell = value;
+    State(map)->chunks[(y / map->chunkSize) * State(map)->chunksX + x / map->chunkSize].dirty = true;
+}
+
+GAME_API int TileMapGetTile(const TileMap *map, int x, int y)
+{
+    if (x < 0 || y < 0 || x >= map->width || y >= map->height)
+        return 0;
+    return map->tiles[static_cast<size_t>(y) * map->width + x];
+}
+
+GAME_API void TileMapFill(TileMap *map, int x, int y, int width, int height, int tile)
+{
+    const int x0 = std::max(x, 0), y0 = std::max(y, 0);
+    const int x1 = std::min(x + width, map->width), y1 = std::min(y + height, map->height);
+    const uint16_t value = static_cast<uint16_t>(std::clamp(tile, 0, static_cast<int>(UINT16_MAX)));
+    for (int row = y0; row < y1; row++)
+        std::fill_n(map->tiles + static_cast<size_t>(row) * map->width + x0, std::max(x1 - x0, 0), value);
+    TileMapMarkDirty(map, x, y, width, height);
+}
+
+// Writes the quads of one chunk into state->vertices, returns how many
+static int BuildChunk(TileMapState *state, int cx, int cy)
+{
+    const int size = state->chunkSize;
+    const int x0 = cx * size, y0 = cy * size;
+    const int x1 = std::min(x0 + size, state->width), y1 = std::min(y0 + size, state->height);
+    const int tileCount = static_cast<int>(state->tileUVs.size() / 4);
+    const float *uvs = state->tileUVs.data();
+    const float tileWidth = state->tileWidth, tileHeight = state->tileHeight;
+
+    float *out = state->vertices.data();
+    for (int y = y0; y < y1; y++)
+    {
+        const uint16_t *row = state->tiles + static_cast<size_t>(y) * state->width;
+        const float top = static_cast<float>(y) * tileHeight;
+        const float bottom = top + tileHeight;
+        for (int x = x0; x < x1; x++)
+        {
+            const int tile = row[x];
+            if (tile == 0 || tile >= tileCount)
+                continue;
+
+            const float *uv = uvs + tile * 4;
+            const float left = static_cast<float>(x) * tileWidth;
+            const float right = left + tileWidth;
+            // top-left, bottom-left, bottom-right, top-right like the sprite batcher
+            const float quad[QUAD_FLOATS] = {left, top, uv[0], uv[1], left, bottom, uv[0], uv[3],
+                                             right, bottom, uv[2], uv[3], right, top, uv[2], uv[1]};
+            memcpy(out, quad, sizeof(quad));
+            out += QUAD_FLOATS;
+        }
+    }
+    return static_cast<int>((out - state->vertices.data()) / QUAD_FLOATS);
+}
+
+// Rebuilds the chunk and uploads it when there is a window; its buffer only
+// grows, a chunk that loses tiles keeps the space
+static void RebuildChunk(TileMapState *state, int cx, int cy, bool upload)
+{
+    TileChunk &chunk = state->chunks[cy * state->chunksX + cx];
+    chunk.quadCount = BuildChunk(state, cx, cy);
+    chunk.dirty = false;
+    chunk.notUploaded = !upload;
+    state->stats.rebuiltChunks++;
+
+    if (!upload || chunk.quadCount == 0)
+        return;
+
+    if (chunk.quadCount > chunk.gpuCapacity)
+    {
+        if (chunk.vboId != 0)
+            rlUnloadVertexBuffer(chunk.vboId);
+        chunk.vboId = rlLoadVertexBuffer(state->vertices.data(), chunk.quadCount * QUAD_BYTES, false);
+        chunk.gpuCapacity = chunk.quadCount;
+    }
+    else
+    {
+        rlUpdateVertexBuffer(chunk.vboId, state->vertices.data(), chunk.quadCount * QUAD_BYTES, 0);
+    }
+}
+
+static bool NeedsRebuild(const TileChunk &chunk, bool upload)
+{
+    return chunk.dirty || (upload && chunk.notUploaded);
+}
+
+GAME_API void TileMapUpdate(TileMap *map)
+{
+    TileMapState *state = State(map);
+    const auto start = std::chrono::steady_clock::now();
+    const bool upload = IsWindowReady();
+
+    state->stats.rebuiltChunks = 0;
+    for (int cy = 0; cy < state->chunksY; cy++)
+        for (int cx = 0; cx < state->chunksX; cx++)
+            if (NeedsRebuild(state->chunks[cy * state->chunksX + cx], upload))
+                RebuildChunk(state, cx, cy, upload);
+
+    state->stats.buildMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void EnsureGpuObjects(TileMapState *state)
+{
+    if (state->vaoId != 0)
+        return;
+
+    state->vaoId = rlLoadVertexArray();
+    rlEnableVertexArray(state->vaoId);
+
+    // 0,1,2, 0,2,3 per quad, shared by every chunk
+    const int quads = state->chunkSize * state->chunkSize;
+    std::vector<unsigned short> indices(static_cast<size_t>(quads) * 6);
+    for (int i = 0; i < quads; i++)
+    {
+        const unsigned short base = static_cast<unsigned short>(i * 4);
+        const unsigned short quad[6] = {base, static_cast<unsigned short>(base + 1), static_cast<unsigned short>(base + 2),
+                                        base, static_cast<unsigned short>(base + 2), static_cast<unsigned short>(base + 3)};
+        memcpy(&indices[static_cast<size_t>(i) * 6], quad, sizeof(quad));
+    }
+    state->indexBufferId = rlLoadVertexBufferElement(indices.data(), static_cast<int>(indices.size() * sizeof(unsigned short)), false);
+
+    rlDisableVertexArray();
+}
+
+GAME_API void TileMapDraw(TileMap *map, Rectangle view)
+{
+    TileMapState *state = State(map);
+    TileMapStats &stats = state->stats;
+    stats.visibleChunks = 0;
+    stats.rebuiltChunks = 0;
+    stats.drawCalls = 0;
+    stats.quads = 0;
+    stats.buildMs = 0.0f;
+
+    // Visible chunk range, a view touching a chunk's edge includes it
+    const float chunkWidth = map->chunkSize * map->tileWidth;
+    const float chunkHeight = map->chunkSize * map->tileHeight;
+    const float left = (view.x - map->position.x) / chunkWidth;
+    const float top = (view.y - map->position.y) / chunkHeight;
+    const float right = (view.x + view.width - map->position.x) / chunkWidth;
+    const float bottom = (view.y + view.height - map->position.y) / chunkHeight;
+    if (!(right >= 0.0f && bottom >= 0.0f && left <= state->chunksX && top <= state->chunksY))
+        return;
+
+    const int cx0 = std::max(static_cast<int>(std::floor(left)), 0);
+    const int cy0 = std::max(static_cast<int>(std::floor(top)), 0);
+    const int cx1 = std::min(static_cast<int>(std::floor(right)), state->chunksX - 1);
+    const int cy1 = std::min(static_cast<int>(std::floor(bottom)), state->chunksY - 1);
+
+    const bool gpu = IsWindowReady();
+    if (gpu)
+    {
+        // Everything raylib queued so far goes first, the map draws on top of it
+        rlDrawRenderBatchActive();
+        EnsureGpuObjects(state);
+
+        const Matrix model = MatrixMultiply(MatrixTranslate(map->position.x, map->position.y, 0.0f), rlGetMatrixTransform());
+        const Matrix mvp = MatrixMultiply(model, MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection()));
+        const int *locs = rlGetShaderLocsDefault();
+        rlEnableShader(rlGetShaderIdDefault());
+        rlSetUniformMatrix(locs[SHADER_LOC_MATRIX_MVP], mvp);
+
+        const float tint[4] = {map->tint.r / 255.0f, map->tint.g / 255.0f, map->tint.b / 255.0f, map->tint.a / 255.0f};
+        const float white[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+        const int textureSlot = 0;
+        rlSetUniform(locs[SHADER_LOC_COLOR_DIFFUSE], tint, RL_SHADER_UNIFORM_VEC4, 1);
+        rlSetUniform(locs[SHADER_LOC_MAP_DIFFUSE], &textureSlot, RL_SHADER_UNIFORM_INT, 1);
+        // No per-vertex colors, the attribute reads this constant instead
+        rlSetVertexAttributeDefault(locs[SHADER_LOC_VERTEX_COLOR], white, RL_SHADER_ATTRIB_VEC4, 4);
+
+        rlEnableVertexArray(state->vaoId);
+        rlEnableVertexBufferElement(state->indexBufferId);
+        rlActiveTextureSlot(0);
+        rlEnableTexture(state->texture.id);
+    }
+
+    const int *locs = gpu ? rlGetShaderLocsDefault() : nullptr;
+    for (int cy = cy0; cy <= cy1; cy++)
+    {
+        for (int cx = cx0; cx <= cx1; cx++)
+        {
+            TileChunk &chunk = state->chunks[cy * state->chunksX + cx];
+            stats.visibleChunks++;
+            if (NeedsRebuild(chunk, gpu))
+            {
+                const auto start = std::chrono::steady_clock::now();
+                RebuildChunk(state, cx, cy, gpu);
+                stats.buildMs += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+            }
+            if (chunk.quadCount == 0)
+                continue;
+
+            stats.quads += chunk.quadCount;
+            if (!gpu)
+                continue;
+
+            rlEnableVertexBuffer(chunk.vboId);
+            rlSetVertexAttribute(locs[SHADER_LOC_VERTEX_POSITION], 2, RL_FLOAT, false, VERTEX_BYTES, 0);
+            rlEnableVertexAttribute(locs[SHADER_LOC_VERTEX_POSITION]);
+            rlSetVertexAttribute(locs[SHADER_LOC_VERTEX_TEXCOORD01], 2, RL_FLOAT, false, VERTEX_BYTES, 2 * sizeof(float));
+            rlEnableVertexAttribute(locs[SHADER_LOC_VERTEX_TEXCOORD01]);
+            rlDrawVertexArrayElements(0, chunk.quadCount * 6, nullptr);
+            stats.drawCalls++;
+        }
+    }
+
+    if (gpu)
+    {
+        rlDisableTexture();
+        rlDisableVertexArray();
+        rlDisableVertexBuffer();
+        rlDisableVertexBufferElement();
+        rlDisableShader();
+    }
+}
+
+GAME_API void TileMapGetStats(const TileMap *map, TileMapStats *stats)
+{
+    *stats = State(map)->stats;
+}
@@ -0,0 +1,62 @@
+#ifndef TILEMAP_HPP
+#define TILEMAP_HPP
+
+#include "api.hpp"
+
+#include <cstdint>
+
+#include <raylib/raylib.h>
+
+// Retained tile map layer: tiles are grouped in square chunks whose quads are
+// built once, kept in a static GPU buffer and rebuilt only after one of their
+// tiles changes. A draw culls chunks against the view and issues one draw call
+// per visible chunk, so the cost follows the visible chunks, not the tiles.
+//
+// Tile ids index the tileset row by row starting at 1; 0 is an empty cell.
+// Writing tiles[] directly is fine, followed by TileMapMarkDirty on the area.
+struct TileMap
+{
+    uint16_t *tiles;     // width * height, row-major
+    int width;           // in tiles
+    int height;
+    float tileWidth;     // world units
+    float tileHeight;
+    int chunkSize;       // tiles per chunk side
+    Vector2 position;    // world position of the top left corner, moving it rebuilds nothing
+    Color tint;
+};
+
+struct TileMapStats
+{
+    int chunks;          // in the map
+    int visibleChunks;   // last draw
+    int rebuiltChunks;   // last draw or update
+    int drawCalls;       // last draw
+    int quads;           // drawn by the last draw
+    float buildMs;       // rebuilding chunks in the last draw or update
+};
+
+// chunkSize 0 picks 64; it is clamped to 8..128 (a chunk must fit 16-bit indices)
+GAME_API TileMap *TileMapCreate(int width, int height, float tileWidth, float tileHeight, int chunkSize);
+GAME_API void TileMapDestroy(TileMap *map);
+
+// Tiles are tileWidth x tileHeight pixels, spacing pixels apart, laid out in
+// region of texture (a zero region is the whole texture, an atlas sprite's
+// source works too). Every chunk is rebuilt.
+GAME_API void TileMapSetTileset(TileMap *map, Texture2D texture, Rectangle region, int tileWidth, int tileHeight, int spacing);
+
+GAME_API void TileMapSetTile(TileMap *map, int x, int y, int tile);
+GAME_API int TileMapGetTile(const TileMap *map, int x, int y);
+GAME_API void TileMapFill(TileMap *map, int x, int y, int width, int height, int tile);
+// After writing tiles[] directly
+GAME_API void TileMapMarkDirty(TileMap *map, int x, int y, int width, int height);
+
+// Rebuilds every dirty chunk now instead of when it next comes into view
+GAME_API void TileMapUpdate(TileMap *map);
+// Draws the chunks overlapping view (world space, see ViewRectFromCamera2D),
+// rebuilding the dirty ones first. Flushes raylib's batch before drawing;
+// without a window only the culling and the rebuilds run.
+GAME_API void TileMapDraw(TileMap *map, Rectangle view);
+GAME_API void TileMapGetStats(const TileMap *map, TileMapStats *stats);
+
+#endif
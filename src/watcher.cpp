@@ -0,0 +1,258 @@
+#include "watcher.hpp"
+#include "filesystem.hpp"
+
+#include <unordered_map>
+#include <unordered_set>
+#include <filesystem>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <deque>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+#include <raylib/raylib.h>
+
+namespace fs = std::filesystem;
+
+// Archives are only stat'ed this often, directories without inotify as well
+static constexpr auto POLL_INTERVAL = std::chrono::milliseconds(250);
+
+struct WatchedDirectory
+{
+    std::string vfsPrefix; // e.g. "lua/entities/"
+    fs::path diskPath;
+};
+
+static bool g_WatcherActive = false;
+static std::chrono::steady_clock::time_point g_LastPoll;
+
+static std::vector<std::string> g_WatchedArchives;
+static std::vector<WatchedDirectory> g_WatchedRoots;
+
+static std::deque<std::string> g_PendingChanges;
+static std::unordered_set<std::string> g_PendingSet;
+static std::string g_CurrentChange;
+
+#if defined(__linux__)
+static int g_InotifyFd = -1;
+static std::unordered_map<int, WatchedDirectory> g_InotifyWatches;
+#else
+static std::unordered_map<std::string, fs::file_time_type> g_FileTimes;
+#endif
+
+static void AddPendingChange(const std::string &vfsPath)
+{
+    if (g_PendingSet.insert(vfsPath).second)
+        g_PendingChanges.push_back(vfsPath);
+}
+
+static std::string ToVFSPath(const WatchedDirectory &root, const fs::path &diskPath)
+{
+    return root.vfsPrefix + diskPath.lexically_relative(root.diskPath).generic_string();
+}
+
+#if defined(__linux__)
+
+static void AddInotifyWatch(const WatchedDirectory &directory)
+{
+    const int wd = inotify_add_watch(g_InotifyFd, directory.diskPath.c_str(),
+                                     IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (wd < 0)
+    {
+        TraceLog(LOG_WARNING, "WATCH: Could not watch %s: %s", directory.diskPath.c_str(), strerror(errno));
+        return;
+    }
+
+    g_InotifyWatches[wd] = directory;
+}
+
+static void AddInotifyWatchRecursive(const WatchedDirectory &root)
+{
+    AddInotifyWatch(root);
+
+    std::error_code ec;
+    for (const auto &entry : fs::recursive_directory_iterator(root.diskPath, ec))
+    {
+        if (entry.is_directory(ec))
+            AddInotifyWatch({ToVFSPath(root, entry.path()) + "/", entry.path()});
+    }
+}
+
+static void PollDirectories()
+{
+    alignas(inotify_event) char buffer[4096];
+    for (;;)
+    {
+        const ssize_t length = read(g_InotifyFd, buffer, sizeof(buffer));
+        if (length <= 0)
+            break;
+
+        for (char *ptr = buffer; ptr < buffer + length;)
+        {
+            const auto *event = reinterpret_cast<const inotify_event *>(ptr);
+            ptr += sizeof(inotify_event) + event->len;
+
+            auto it = g_InotifyWatches.find(event->wd);
+            if (it == g_InotifyWatches.end() || event->len == 0)
+                continue;
+
+            const WatchedDirectory directory = it->second;
+            const fs::path diskPath = directory.diskPath / event->name;
+
+            if (event->mask & IN_ISDIR)
+            {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                    AddInotifyWatchRecursive({directory.vfsPrefix + event->name + "/", diskPath});
+            }
+            else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+            {
+                AddPendingChange(directory.vfsPrefix + event->name);
+            }
+        }
+    }
+}
+
+#else
+
+static void ScanDirectories(bool report)
+{
+    std::error_code ec;
+    for (const auto &root : g_WatchedRoots)
+    {
+        for (const auto &entry : fs::recursive_directory_iterator(root.diskPath, ec))
+        {
+            if (!entry.is_regular_file(ec))
+                continue;
+
+            const auto modTime = entry.last_write_time(ec);
+            auto [it, inserted] = g_FileTimes.try_emplace(entry.path().string(), modTime);
+            if (!inserted && it->second != modTime)
+            {
+                it->second = modTime;
+                if (report)
+                    AddPendingChange(ToVFSPath(root, entry.path()));
+            }
+            else if (inserted && report)
+            {
+                AddPendingChange(ToVFSPath(root, entry.path()));
+            }
+        }
+    }
+}
+
+static void PollDirectories()
+{
+    ScanDirectories(true);
+}
+
+#endif
+
+GAME_API bool WatcherStart()
+{
+    if (g_WatcherActive)
+        return true;
+
+#if defined(__linux__)
+    g_InotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (g_InotifyFd < 0)
+    {
+        TraceLog(LOG_ERROR, "WATCH: Could not initialize inotify: %s", strerror(errno));
+        return false;
+    }
+#endif
+
+    for (const VFSMount &mount : GetVFSMounts())
+    {
+        if (!mount.directory)
+        {
+            g_WatchedArchives.push_back(mount.key);
+            continue;
+        }
+
+        const WatchedDirectory root = {mount.key + "/", fs::path(mount.path)};
+        g_WatchedRoots.push_back(root);
+#if defined(__linux__)
+        AddInotifyWatchRecursive(root);
+#endif
+    }
+
+#if !defined(__linux__)
+    ScanDirectories(false);
+#endif
+
+    g_LastPoll = std::chrono::steady_clock::now();
+    g_WatcherActive = true;
+
+    TraceLog(LOG_INFO, "WATCH: Watching %zu directories and %zu archives", g_WatchedRoots.size(), g_WatchedArchives.size());
+    return true;
+}
+
+GAME_API void WatcherStop()
+{
+    UnloadWatcher();
+}
+
+void UnloadWatcher()
+{
+#if defined(__linux__)
+    if (g_InotifyFd >= 0)
+        close(g_InotifyFd);
+    g_InotifyFd = -1;
+    g_InotifyWatches.clear();
+#else
+    g_FileTimes.clear();
+#endif
+
+    g_WatchedArchives.clear();
+    g_WatchedRoots.clear();
+    g_PendingChanges.clear();
+    g_PendingSet.clear();
+    g_WatcherActive = false;
+}
+
+GAME_API int WatcherPoll()
+{
+    if (!g_WatcherActive)
+        return 0;
+
+#if defined(__linux__)
+    PollDirectories();
+#endif
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - g_LastPoll >= POLL_INTERVAL)
+    {
+        g_LastPoll = now;
+
+#if !defined(__linux__)
+        PollDirectories();
+#endif
+
+        std::vector<std::string> changedFiles;
+        for (const std::string &archiveKey : g_WatchedArchives)
+            ReloadVFSArchive(archiveKey, changedFiles);
+
+        for (const std::string &fileName : changedFiles)
+            AddPendingChange(fileName);
+    }
+
+    return static_cast<int>(g_PendingChanges.size());
+}
+
+GAME_API const char *WatcherNextChange()
+{
+    if (g_PendingChanges.empty())
+        return nullptr;
+
+    g_CurrentChange = std::move(g_PendingChanges.front());
+    g_PendingChanges.pop_front();
+    g_PendingSet.erase(g_CurrentChange);
+
+    return g_CurrentChange.c_str();
+}
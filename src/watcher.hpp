@@ -0,0 +1,18 @@
+#ifndef WATCHER_HPP
+#define WATCHER_HPP
+
+#include "api.hpp"
+
+// Watches VFS mounts for changes: inotify on mounted directories (Linux),
+// mtime polling on directories elsewhere and on archives everywhere.
+GAME_API bool WatcherStart();
+GAME_API void WatcherStop();
+
+// Collects changes since the last poll, returns how many are pending
+GAME_API int WatcherPoll();
+// Next changed VFS path (e.g. "lua/player.lua") or NULL, valid until the next call
+GAME_API const char *WatcherNextChange();
+
+void UnloadWatcher();
+
+#endif